@@ -0,0 +1,13 @@
+#version 330 core
+
+in vec3 vColor;
+in float vRatio;
+in float vAlong;
+
+out vec4 FragColor;
+
+void main() {
+    // Filled part fades from the full-health color to red; the rest is a dark track
+    vec3 fill = mix(vec3(1.0, 0.0, 0.0), vColor, vRatio);
+    FragColor = vAlong <= vRatio ? vec4(fill, 1.0) : vec4(0.15, 0.15, 0.15, 1.0);
+}
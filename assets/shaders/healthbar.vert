@@ -0,0 +1,28 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;     // Unit quad corner, -0.5..0.5
+layout (location = 1) in mat4 aModel;   // Per instance: bar centre (translation) and size (scale)
+layout (location = 5) in vec3 aColor;   // Per instance: fill color at full health
+layout (location = 6) in float aValue;  // Per instance: health ratio 0..1
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 vColor;
+out float vRatio;
+out float vAlong;   // 0 at the left edge of the bar, 1 at the right
+
+void main() {
+    // Face the camera: span the quad along the view's right and up axes
+    vec3 right = vec3(view[0][0], view[1][0], view[2][0]);
+    vec3 up = vec3(view[0][1], view[1][1], view[2][1]);
+    vec3 center = aModel[3].xyz;
+    float width = length(aModel[0].xyz);
+    float height = length(aModel[1].xyz);
+    vec3 world = center + right * (aPos.x * width) + up * (aPos.y * height);
+
+    vColor = aColor;
+    vRatio = clamp(aValue, 0.0, 1.0);
+    vAlong = aPos.x + 0.5;
+    gl_Position = projection * view * vec4(world, 1.0);
+}
@@ -0,0 +1,16 @@
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in mat4 aModel;   // Per instance, locations 1-4
+layout (location = 5) in vec3 aColor;   // Per instance
+
+uniform mat4 view;
+uniform mat4 projection;
+
+out vec3 vColor;
+
+void main() {
+    vColor = aColor;
+    gl_Position = projection * view * aModel * vec4(aPos, 1.0);
+}
+
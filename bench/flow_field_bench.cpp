@@ -0,0 +1,117 @@
+// Microbenchmark of flow field rebuild/repair cost and per-tick enemy steering
+#include "game/flow_field.h"
+#include "game/enemy_spawner.h"
+#include "game/sim_clock.h"
+#include <glm/gtc/constants.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedMs(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Same field the game builds around the core
+    bool InitializeField(FlowField& field) {
+        return field.Initialize(glm::vec3(-32.0f, -32.0f, -16.0f), glm::vec3(32.0f, 32.0f, 16.0f), 2.0f, glm::vec3(0.0f));
+    }
+
+    // Average spawner tick over `ticks` once `enemy_count` enemies are in flight
+    double TimeSpawnerTicks(const FlowField* field, int enemy_count, int ticks, size_t& steered) {
+        SimClock clock;
+        EnemySpawner spawner;
+        spawner.SetSimClock(&clock);
+        spawner.SetSpawnRadius(30.0f);
+        spawner.Initialize();
+        spawner.SetFlowField(field);
+        for (int i = 0; i < enemy_count; ++i) {
+            spawner.SpawnEnemy();
+        }
+
+        const float kTickSeconds = 1.0f / 60.0f;
+        clock.Advance(kTickSeconds);
+        spawner.Update(kTickSeconds);
+
+        auto start = Clock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            clock.Advance(kTickSeconds);
+            spawner.Update(kTickSeconds);
+        }
+        steered = spawner.GetSteeredEnemyCount();
+        return ElapsedMs(start) / ticks;
+    }
+}
+
+// Usage: flow_field_bench [enemy_count] [ticks]
+int main(int argc, char** argv) {
+    int enemy_count = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int ticks = argc > 2 ? std::atoi(argv[2]) : 120;
+    const int kTurretCount = 15;
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+
+    // Turrets spread over the placement band (golden-angle spacing keeps gaps open)
+    std::vector<glm::vec3> turrets;
+    for (int i = 0; i < kTurretCount; ++i) {
+        float angle = 2.39996f * i;
+        float radius = 6.0f + 7.0f * (i % 3);
+        turrets.push_back(glm::vec3(radius * glm::cos(angle), radius * glm::sin(angle), 0.0f));
+    }
+
+    FlowField field;
+    auto start = Clock::now();
+    InitializeField(field);
+    double build_ms = ElapsedMs(start);
+
+    // Incremental repairs as the layout grows and shrinks
+    double add_ms = 0.0;
+    size_t add_cells = 0;
+    for (const glm::vec3& turret : turrets) {
+        start = Clock::now();
+        field.AddZone(turret, 3.0f);
+        add_ms += ElapsedMs(start);
+        add_cells += field.GetLastRepairCount();
+    }
+    double remove_ms = 0.0;
+    size_t remove_cells = 0;
+    for (int i = 0; i < kTurretCount; i += 3) {
+        start = Clock::now();
+        field.RemoveZone(turrets[i], 3.0f);
+        remove_ms += ElapsedMs(start);
+        remove_cells += field.GetLastRepairCount();
+        field.AddZone(turrets[i], 3.0f);
+    }
+    int removals = (kTurretCount + 2) / 3;
+
+    // Full rebuild with every zone in place, for comparison
+    start = Clock::now();
+    field.ClearZones();
+    for (const glm::vec3& turret : turrets) {
+        field.AddZone(turret, 3.0f);
+    }
+    double relayout_ms = ElapsedMs(start);
+
+    size_t steered = 0;
+    size_t unsteered = 0;
+    double steer_ms = TimeSpawnerTicks(&field, enemy_count, ticks, steered);
+    double straight_ms = TimeSpawnerTicks(nullptr, enemy_count, ticks, unsteered);
+
+    std::cout.rdbuf(console);
+    std::cout << "Flow field: " << field.GetCellCount() << " cells, " << kTurretCount << " turret zones" << std::endl;
+    std::cout << "  full build       " << build_ms << " ms" << std::endl;
+    std::cout << "  add zone         " << add_ms / kTurretCount << " ms ("
+              << add_cells / kTurretCount << " cells re-labelled)" << std::endl;
+    std::cout << "  remove zone      " << remove_ms / removals << " ms ("
+              << remove_cells / removals << " cells re-labelled)" << std::endl;
+    std::cout << "  clear + re-add   " << relayout_ms << " ms" << std::endl;
+    std::cout << "Spawner tick with " << enemy_count << " enemies" << std::endl;
+    std::cout << "  with field       " << steer_ms << " ms (" << steered << " steered)" << std::endl;
+    std::cout << "  without field    " << straight_ms << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Stress benchmark for batched legendary effect resolution
+#include "game/effect_system.h"
+#include "game/damage_system.h"
+#include "game/spatial_grid.h"
+#include "game/enemy.h"
+#include "game/projectile.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// Usage: legendary_effects_bench [enemies] [hits_per_tick] [ticks]
+int main(int argc, char** argv) {
+    int enemy_count = argc > 1 ? std::atoi(argv[1]) : 4000;
+    int hits_per_tick = argc > 2 ? std::atoi(argv[2]) : 3000;
+    int ticks = argc > 3 ? std::atoi(argv[3]) : 200;
+
+    // Game code logs to stdout; keep it out of the timings
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-38.0f, 38.0f);
+    std::uniform_real_distribution<float> height(0.0f, 4.0f);
+
+    std::vector<std::unique_ptr<Enemy>> enemies;
+    std::vector<glm::vec3> positions;
+    enemies.reserve(enemy_count);
+    positions.reserve(enemy_count);
+    for (int i = 0; i < enemy_count; ++i) {
+        auto enemy = std::make_unique<Enemy>(static_cast<uint32_t>(i + 1));
+        enemy->Initialize(glm::vec3(coord(rng), coord(rng), height(rng)));
+        enemy->SetHealth(1.0e9f); // Keep the population constant across ticks
+        positions.push_back(enemy->GetPosition());
+        enemies.push_back(std::move(enemy));
+    }
+
+    SpatialGrid grid;
+    grid.Initialize(glm::vec3(-40.0f), glm::vec3(40.0f), 4.0f);
+    grid.Build(positions);
+
+    DamageSystem damage_system;
+    EffectSystem effects;
+    effects.SetEnemyGrid(&grid);
+    effects.SetDamageSystem(&damage_system);
+
+    EffectMask mask = EffectBit(LegendaryEffect::ChainLightning) | EffectBit(LegendaryEffect::Explosive) |
+                      EffectBit(LegendaryEffect::SplitShot);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(enemy_count - 1));
+    std::vector<ShotSpec> fragments;
+    size_t total_events = 0;
+    size_t total_fragments = 0;
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration resolve_time{};
+    Clock::duration apply_time{};
+
+    for (int tick = 0; tick < ticks; ++tick) {
+        for (int i = 0; i < hits_per_tick; ++i) {
+            uint32_t index = pick(rng);
+            effects.QueueHit({mask, index, enemies[index]->GetPosition(), glm::vec3(1.0f, 0.0f, 0.0f), 30.0f, 3.0f});
+        }
+
+        fragments.clear();
+        auto start = Clock::now();
+        effects.Resolve(enemies, fragments);
+        auto resolved = Clock::now();
+        total_events += damage_system.GetBuffer().GetSize();
+        damage_system.Apply(enemies);
+        auto applied = Clock::now();
+
+        resolve_time += resolved - start;
+        apply_time += applied - resolved;
+        total_fragments += fragments.size();
+    }
+
+    std::cout.rdbuf(console);
+
+    auto to_ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    std::cout << "Legendary effects: " << enemy_count << " enemies, " << hits_per_tick << " hits/tick, "
+              << ticks << " ticks" << std::endl;
+    std::cout << "  resolve: " << to_ms(resolve_time) / ticks << " ms/tick" << std::endl;
+    std::cout << "  damage apply: " << to_ms(apply_time) / ticks << " ms/tick" << std::endl;
+    std::cout << "  damage events: " << total_events / ticks << " per tick, split fragments: "
+              << total_fragments / ticks << " per tick" << std::endl;
+    return 0;
+}
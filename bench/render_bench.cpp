@@ -0,0 +1,213 @@
+// Benchmark of the render path (Game and UIManager) on an offscreen GL context
+#include <glad/glad.h>
+#include "core/window.h"
+#include "core/input.h"
+#include "graphics/renderer.h"
+#include "graphics/render_queue.h"
+#include "game/game.h"
+#include "utils/metrics.h"
+#include "utils/png_writer.h"
+#include "utils/gl_trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct SceneSpec {
+        const char* name;
+        Game::BenchmarkScene scene;
+    };
+
+    struct RunStats {
+        double record_ms;       // Game::RecordFrame and publishing the snapshot (CPU)
+        double submit_ms;       // RenderQueue::Flush (CPU)
+        double gpu_ms;          // Timer query around the flush
+        double frame_ms;        // Record to glFinish, so CPU and GPU work in series
+        double draw_calls;
+        double state_changes;
+    };
+
+    // Color and depth renderbuffers the window's size: frames end up here instead of
+    // the window, so the context needs no drawable surface
+    struct OutputTarget {
+        GLuint fbo = 0, color = 0, depth = 0;
+
+        bool Create(int width, int height) {
+            glGenFramebuffers(1, &fbo);
+            glGenRenderbuffers(1, &color);
+            glGenRenderbuffers(1, &depth);
+            glBindRenderbuffer(GL_RENDERBUFFER, color);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+            glBindRenderbuffer(GL_RENDERBUFFER, depth);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+            glBindRenderbuffer(GL_RENDERBUFFER, 0);
+            glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+            bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            return complete;
+        }
+
+        void Destroy() {
+            glDeleteFramebuffers(1, &fbo);
+            glDeleteRenderbuffers(1, &color);
+            glDeleteRenderbuffers(1, &depth);
+            fbo = color = depth = 0;
+        }
+    };
+
+    // Build the scene in a fresh Game, render `frames` frames into `output`, and
+    // optionally save the last one as <png_dir>/<scene>.png
+    bool Run(const SceneSpec& spec, Renderer& renderer, InputManager& input, const OutputTarget& output,
+             int frames, const std::string& png_dir, RunStats& stats) {
+        const int kWarmupFrames = 10;
+
+        Game game;
+        if (!game.Initialize(&renderer, &input)) return false;
+        game.SetupBenchmarkScene(spec.scene);
+        game.GetRenderQueue()->SetOutputFramebuffer(output.fbo);
+
+        stats = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        for (int frame = 0; frame < kWarmupFrames + frames; ++frame) {
+            glBindFramebuffer(GL_FRAMEBUFFER, output.fbo);
+            renderer.BeginFrame();
+
+            auto start = std::chrono::steady_clock::now();
+            game.RecordFrame();
+            game.PublishFrame();
+            auto recorded = std::chrono::steady_clock::now();
+            if (game.WaitForFrame()) {
+                game.SubmitFrame();
+            }
+            renderer.EndFrame();
+            glFinish();
+            auto finished = std::chrono::steady_clock::now();
+            game.FramePresented();
+            GL_TRACE_PUBLISH();
+            Metrics::EndFrame();
+
+            if (frame < kWarmupFrames) continue;
+            stats.record_ms += std::chrono::duration<double, std::milli>(recorded - start).count();
+            stats.frame_ms += std::chrono::duration<double, std::milli>(finished - start).count();
+            stats.submit_ms += Metrics::Get("render.submit_ms");
+            stats.gpu_ms += Metrics::Get("render.gpu_ms");
+            stats.draw_calls += Metrics::Get("render.draw_calls");
+            stats.state_changes += Metrics::Get("render.state_changes");
+        }
+        stats.record_ms /= frames;
+        stats.submit_ms /= frames;
+        stats.gpu_ms /= frames;
+        stats.frame_ms /= frames;
+        stats.draw_calls /= frames;
+        stats.state_changes /= frames;
+
+        if (!png_dir.empty()) {
+            int width = renderer.GetFramebufferWidth();
+            int height = renderer.GetFramebufferHeight();
+            std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, output.fbo);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+            PngWriter::Write(png_dir + "/" + spec.name + ".png", width, height, pixels.data(), true);
+        }
+        return true;
+    }
+
+    OffscreenContext ParseContext(const char* name) {
+        if (std::strcmp(name, "hidden") == 0) return OffscreenContext::Hidden;
+        if (std::strcmp(name, "osmesa") == 0) return OffscreenContext::OSMesa;
+        return OffscreenContext::Egl;
+    }
+}
+
+// Usage: render_bench [frames] [--context hidden|egl|osmesa] [--png <dir>]
+// Without a display the default context is EGL on GLFW's null platform, so Mesa's
+// llvmpipe can run it on GPU-less machines. The render scale is pinned to 1 unless
+// CORE_RENDER_SCALE is set.
+int main(int argc, char** argv) {
+    int frames = 200;
+    std::string png_dir;
+    bool has_display = std::getenv("DISPLAY") || std::getenv("WAYLAND_DISPLAY");
+    OffscreenContext context = has_display ? OffscreenContext::Hidden : OffscreenContext::Egl;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--context") == 0 && i + 1 < argc) {
+            context = ParseContext(argv[++i]);
+        } else if (std::strcmp(argv[i], "--png") == 0 && i + 1 < argc) {
+            png_dir = argv[++i];
+        } else {
+            frames = std::max(1, std::atoi(argv[i]));
+        }
+    }
+
+#ifdef _WIN32
+    if (!std::getenv("CORE_RENDER_SCALE")) _putenv_s("CORE_RENDER_SCALE", "1");
+#else
+    setenv("CORE_RENDER_SCALE", "1", 0);
+#endif
+
+    const SceneSpec scenes[] = {
+        {"hud", {0, 0, true, 0}},
+        {"enemies_1k", {1000, 0, true, 0}},
+        {"enemies_5k", {5000, 0, true, 0}},
+        {"projectiles_2k", {200, 2000, true, 0}},
+        {"crowd_5k_2k", {5000, 2000, true, 0}},
+        {"inventory", {200, 0, true, 40}},
+    };
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+
+    std::vector<std::string> report;
+    std::string gl_renderer;
+    bool ok = false;
+    {
+        Window window;
+        window.SetOffscreen(context);
+        if (window.Initialize(1280, 720, "CORE render bench")) {
+            gl_renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+            window.SetSwapInterval(0);
+            Renderer renderer;
+            InputManager input(window.GetGLFWWindow());
+            OutputTarget output;
+            if (renderer.Initialize(&window) &&
+                output.Create(renderer.GetFramebufferWidth(), renderer.GetFramebufferHeight())) {
+                ok = true;
+                for (const SceneSpec& spec : scenes) {
+                    RunStats stats;
+                    std::ostringstream line;
+                    line << spec.name << ":  ";
+                    if (!Run(spec, renderer, input, output, frames, png_dir, stats)) {
+                        line << "failed to initialize the game";
+                        ok = false;
+                    } else {
+                        line << "record " << stats.record_ms << " ms  submit " << stats.submit_ms
+                             << " ms  gpu " << stats.gpu_ms << " ms  draw calls " << stats.draw_calls
+                             << "  state changes " << stats.state_changes
+                             << "  " << 1000.0 / stats.frame_ms << " fps";
+                    }
+                    report.push_back(line.str());
+                }
+                output.Destroy();
+            }
+            renderer.Shutdown();
+        }
+    }
+
+    std::cout.rdbuf(console);
+    if (gl_renderer.empty()) {
+        std::cerr << "No offscreen GL context" << std::endl;
+        return 1;
+    }
+    std::cout << "Render cost per frame, " << frames << " frames at 1280x720 on " << gl_renderer << std::endl;
+    for (const std::string& line : report) {
+        std::cout << line << std::endl;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+// Microbenchmark of the crowd separation pass at increasing enemy counts
+#include "game/separation_system.h"
+#include "game/enemy.h"
+#include <glm/gtc/constants.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+    // Average pass time in microseconds
+    double TimePasses(SeparationSystem& separation, const std::vector<std::unique_ptr<Enemy>>& enemies, int passes) {
+        const float kTickSeconds = 1.0f / 60.0f;
+        separation.Update(kTickSeconds, enemies);
+
+        auto start = std::chrono::steady_clock::now();
+        for (int pass = 0; pass < passes; ++pass) {
+            separation.Update(kTickSeconds, enemies);
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / passes;
+    }
+}
+
+// Usage: separation_bench [passes]
+int main(int argc, char** argv) {
+    int passes = argc > 1 ? std::atoi(argv[1]) : 50;
+    const int enemy_counts[] = {1000, 5000, 10000, 20000};
+    const size_t kBudget = 4096;
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+
+    std::vector<std::string> report;
+    for (int enemy_count : enemy_counts) {
+        // Crowd packed toward the core, as late in a wave
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> angle_dist(0.0f, glm::two_pi<float>());
+        std::uniform_real_distribution<float> radius_dist(0.0f, 1.0f);
+        std::uniform_real_distribution<float> height_dist(-6.0f, 6.0f);
+
+        std::vector<std::unique_ptr<Enemy>> enemies;
+        for (int i = 0; i < enemy_count; ++i) {
+            float angle = angle_dist(rng);
+            float radius = 2.0f + 18.0f * radius_dist(rng) * radius_dist(rng);
+            auto enemy = std::make_unique<Enemy>(static_cast<uint32_t>(i + 1));
+            enemy->Initialize(glm::vec3(radius * glm::cos(angle), radius * glm::sin(angle), height_dist(rng)));
+            enemies.push_back(std::move(enemy));
+        }
+
+        SeparationSystem separation;
+        separation.Initialize(glm::vec3(-40.0f), glm::vec3(40.0f));
+
+        SeparationSettings settings;
+        settings.agent_budget = static_cast<size_t>(enemy_count);
+        separation.SetSettings(settings);
+        double full_us = TimePasses(separation, enemies, passes);
+
+        settings.agent_budget = kBudget;
+        separation.SetSettings(settings);
+        double budget_us = TimePasses(separation, enemies, passes);
+
+        std::ostringstream line;
+        line << enemy_count << " enemies:  all agents " << full_us << " us ("
+             << full_us * 1000.0 / enemy_count << " ns/agent)  budget " << kBudget << " " << budget_us << " us";
+        report.push_back(line.str());
+    }
+
+    std::cout.rdbuf(console);
+    std::cout << "Separation pass cost per tick" << std::endl;
+    for (const std::string& line : report) {
+        std::cout << line << std::endl;
+    }
+    return 0;
+}
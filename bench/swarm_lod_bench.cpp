@@ -0,0 +1,85 @@
+// Benchmark of the enemy simulation with and without swarm grouping of far spawns
+#include "game/enemy_spawner.h"
+#include "game/sim_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    struct RunStats {
+        double tick_us;             // Average cost of a tick's spawns plus EnemySpawner::Update
+        double peak_tick_us;
+        size_t peak_entities;       // Most enemies simulated as entities at once
+        size_t peak_grouped;        // Most enemies held in swarm groups at once
+    };
+
+    // Spawn `total` enemies in bursts every half second, then run until all arrived
+    RunStats Run(int total, bool swarm_lod, float engagement_radius) {
+        const float kTickSeconds = 1.0f / 60.0f;
+        const int kBursts = 12;
+        const int kTicksPerBurst = 30;
+        const int kTicks = 60 * 15;
+
+        SimClock clock;
+        EnemySpawner spawner;
+        spawner.SetSimClock(&clock);
+        spawner.SetSpawnRadius(30.0f);
+        spawner.Initialize();
+        spawner.SetSwarmLodEnabled(swarm_lod);
+        spawner.SetEngagementRadius(engagement_radius);
+
+        RunStats stats = {0.0, 0.0, 0, 0};
+        int spawned = 0;
+        for (int tick = 0; tick < kTicks; ++tick) {
+            clock.Advance(kTickSeconds);
+            auto start = std::chrono::steady_clock::now();
+            if (tick % kTicksPerBurst == 0 && spawned < total) {
+                int burst = std::min(total - spawned, (total + kBursts - 1) / kBursts);
+                for (int i = 0; i < burst; ++i) {
+                    spawner.SpawnEnemy();
+                }
+                spawned += burst;
+            }
+            spawner.Update(kTickSeconds);
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+            stats.tick_us += us;
+            stats.peak_tick_us = std::max(stats.peak_tick_us, us);
+            stats.peak_entities = std::max(stats.peak_entities, static_cast<size_t>(spawner.GetEnemyCount()));
+            stats.peak_grouped = std::max(stats.peak_grouped, spawner.GetSwarm().GetMemberCount());
+        }
+        stats.tick_us /= kTicks;
+        return stats;
+    }
+}
+
+// Usage: swarm_lod_bench [engagement_radius]
+int main(int argc, char** argv) {
+    float engagement_radius = argc > 1 ? static_cast<float>(std::atof(argv[1])) : 20.0f;
+    const int enemy_counts[] = {5400, 45000};
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+
+    std::vector<std::string> report;
+    for (int enemy_count : enemy_counts) {
+        for (bool swarm_lod : {false, true}) {
+            RunStats stats = Run(enemy_count, swarm_lod, engagement_radius);
+            std::ostringstream line;
+            line << enemy_count << " enemies, swarm LOD " << (swarm_lod ? "on " : "off")
+                 << ":  peak entities " << stats.peak_entities << "  peak grouped " << stats.peak_grouped
+                 << "  tick " << stats.tick_us << " us (peak " << stats.peak_tick_us << " us)";
+            report.push_back(line.str());
+        }
+    }
+
+    std::cout.rdbuf(console);
+    std::cout << "Enemy simulation cost, engagement radius " << engagement_radius << std::endl;
+    for (const std::string& line : report) {
+        std::cout << line << std::endl;
+    }
+    return 0;
+}
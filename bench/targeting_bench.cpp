@@ -0,0 +1,106 @@
+// Microbenchmark of turret target selection cost per policy
+#include "game/targeting_index.h"
+#include "game/spatial_grid.h"
+#include "game/enemy.h"
+#include <glm/gtc/constants.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace {
+    // Reference: the full scan turrets used before the index
+    Enemy* ScanClosest(const std::vector<std::unique_ptr<Enemy>>& enemies, const glm::vec3& position, float range) {
+        Enemy* closest = nullptr;
+        float closest_distance = range;
+        for (const auto& enemy : enemies) {
+            if (!enemy->IsAlive() || enemy->IsDoomed()) continue;
+            float distance = glm::length(enemy->GetPosition() - position);
+            if (distance <= range && distance < closest_distance) {
+                closest = enemy.get();
+                closest_distance = distance;
+            }
+        }
+        return closest;
+    }
+}
+
+// Usage: targeting_bench [queries_per_case]
+int main(int argc, char** argv) {
+    int queries = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const int kTurretCount = 15;
+    const float kTurretRange = 15.0f;
+    const int enemy_counts[] = {100, 1000, 5000, 20000};
+
+    std::ostringstream sink;
+    std::streambuf* console = std::cout.rdbuf(sink.rdbuf());
+
+    // Turrets ring the core like a typical placement
+    std::vector<glm::vec3> turrets;
+    for (int i = 0; i < kTurretCount; ++i) {
+        float angle = glm::two_pi<float>() * i / kTurretCount;
+        float radius = 6.0f + 8.0f * (i % 3) / 2.0f;
+        turrets.push_back(glm::vec3(radius * glm::cos(angle), radius * glm::sin(angle), 0.0f));
+    }
+
+    std::vector<std::string> report;
+    for (int enemy_count : enemy_counts) {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> angle_dist(0.0f, glm::two_pi<float>());
+        std::uniform_real_distribution<float> radius_dist(2.0f, 25.0f);
+        std::uniform_real_distribution<float> height_dist(-12.5f, 12.5f);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        std::vector<std::unique_ptr<Enemy>> enemies;
+        std::vector<glm::vec3> positions;
+        TargetingIndex index;
+        for (int i = 0; i < enemy_count; ++i) {
+            float angle = angle_dist(rng);
+            float radius = radius_dist(rng);
+            auto enemy = std::make_unique<Enemy>(static_cast<uint32_t>(i + 1));
+            enemy->Initialize(glm::vec3(radius * glm::cos(angle), radius * glm::sin(angle), height_dist(rng)));
+            enemy->SetSpeed(4.5f + 2.0f * unit(rng));
+            enemy->SetHealth(1.0f + 20.0f * unit(rng));
+            index.Insert(enemy.get(), enemy->GetTimeToReachCore());
+            positions.push_back(enemy->GetPosition());
+            enemies.push_back(std::move(enemy));
+        }
+
+        SpatialGrid grid;
+        grid.Initialize(glm::vec3(-40.0f), glm::vec3(40.0f), 4.0f);
+        grid.Build(positions);
+        index.SetSpatialGrid(&grid);
+
+        using Clock = std::chrono::steady_clock;
+        auto time_queries = [&](auto&& select) {
+            size_t found = 0;
+            auto start = Clock::now();
+            for (int q = 0; q < queries; ++q) {
+                if (select(turrets[q % kTurretCount])) found++;
+            }
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queries;
+            return std::make_pair(ns, found);
+        };
+
+        std::ostringstream line;
+        line << enemy_count << " enemies:";
+        auto scan = time_queries([&](const glm::vec3& p) { return ScanClosest(enemies, p, kTurretRange); });
+        line << "  scan " << scan.first << " ns";
+        for (int policy = 0; policy < static_cast<int>(TargetingPolicy::Count); ++policy) {
+            TargetingPolicy targeting = static_cast<TargetingPolicy>(policy);
+            auto result = time_queries([&](const glm::vec3& p) { return index.Select(targeting, p, kTurretRange, enemies); });
+            line << "  " << GetTargetingPolicyName(targeting) << " " << result.first << " ns";
+        }
+        report.push_back(line.str());
+    }
+
+    std::cout.rdbuf(console);
+    std::cout << "Target selection cost per turret query (range " << kTurretRange << ")" << std::endl;
+    for (const std::string& line : report) {
+        std::cout << line << std::endl;
+    }
+    return 0;
+}
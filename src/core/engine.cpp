@@ -5,9 +5,15 @@
 #include "input.h"
 #include "game/game.h"
 #include "time.h"
+#include "utils/metrics.h"
+#include "utils/gl_trace.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <thread>
 
-Engine::Engine() : is_running_(false) {
+Engine::Engine() : is_running_(false), pipelined_(false), swap_interval_(-1) {
 }
 
 Engine::~Engine() {
@@ -41,6 +47,31 @@ bool Engine::Initialize() {
         return false;
     }
     
+    const char* pipelined = std::getenv("CORE_PIPELINED");
+    pipelined_ = pipelined && std::strcmp(pipelined, "1") == 0;
+    std::cout << "Frame loop: " << (pipelined_ ? "pipelined (render thread)" : "sequential") << std::endl;
+    
+    // Pacing: CORE_FRAME_PACING=vsync|cap|jit|off, CORE_FRAME_CAP=<fps>
+    PacingMode mode = PacingMode::VSync;
+    const char* pacing = std::getenv("CORE_FRAME_PACING");
+    if (pacing && *pacing && !FramePacer::ParseMode(pacing, mode)) {
+        std::cerr << "Unknown CORE_FRAME_PACING '" << pacing << "', using vsync" << std::endl;
+    }
+    frame_pacer_.SetMode(mode);
+    if (const char* cap = std::getenv("CORE_FRAME_CAP")) {
+        double fps = std::atof(cap);
+        if (fps > 0.0) {
+            FramePacer::Settings settings = frame_pacer_.GetSettings();
+            settings.cap_fps = fps;
+            frame_pacer_.SetSettings(settings);
+        }
+    }
+    std::cout << "Frame pacing: " << FramePacer::GetModeName(mode)
+              << " (cap " << frame_pacer_.GetSettings().cap_fps << " fps)" << std::endl;
+    if (pipelined_ && mode == PacingMode::JustInTime) {
+        std::cout << "Just-in-time pacing needs the sequential loop; the render thread paces on vsync" << std::endl;
+    }
+    
     is_running_ = true;
     std::cout << "CORE Engine initialized successfully!" << std::endl;
     
@@ -55,29 +86,120 @@ void Engine::Run() {
     
     std::cout << "Starting main game loop..." << std::endl;
     
+    if (pipelined_) {
+        RunPipelined();
+    } else {
+        RunSequential();
+    }
+    
+    std::cout << "Main game loop ended." << std::endl;
+}
+
+void Engine::UpdatePacingControls() {
+    if (input_->IsKeyJustPressed(300)) { // GLFW_KEY_F11
+        PacingMode mode = frame_pacer_.CycleMode();
+        std::cout << "Frame pacing: " << FramePacer::GetModeName(mode) << std::endl;
+    }
+    frame_pacer_.SetIdle(game_->IsIdle());
+}
+
+void Engine::ApplySwapInterval() {
+    int interval = frame_pacer_.GetSwapInterval();
+    if (interval != swap_interval_) {
+        window_->SetSwapInterval(interval);
+        swap_interval_ = interval;
+    }
+}
+
+void Engine::RunSequential() {
     while (is_running_ && !window_->ShouldClose()) {
+        // Wait for the cap, the idle ceiling or the just-in-time start
+        frame_pacer_.WaitForFrameStart();
+        
         // Update input state BEFORE polling new events
         input_->Update();
         
         // Poll events to get fresh input
         window_->PollEvents();
+        UpdatePacingControls();
         
         // Update time
         Time::Update();
         
-        // Update game logic
+        // Update game logic and record the frame's render snapshot
+        auto sim_start = std::chrono::steady_clock::now();
         game_->Update();
+        game_->RecordFrame();
+        Metrics::Add("frame.sim_ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sim_start).count());
+        game_->PublishFrame();
         
-        // Render frame
+        // Render frame (the snapshot just published)
         renderer_->BeginFrame();
-        game_->Render();
+        if (game_->WaitForFrame()) {
+            game_->SubmitFrame();
+        }
         renderer_->EndFrame();
+        frame_pacer_.MarkWorkEnd();
         
         // Swap buffers
+        ApplySwapInterval();
+        window_->SwapBuffers();
+        frame_pacer_.MarkPresented();
+        game_->FramePresented();
+        
+        // Publish this frame's performance counters
+        GL_TRACE_PUBLISH();
+        Metrics::EndFrame();
+    }
+}
+
+void Engine::RunPipelined() {
+    // GLFW events stay on this thread; the GL context moves to the render thread
+    window_->ReleaseContext();
+    std::thread render_thread(&Engine::RenderLoop, this);
+    
+    while (is_running_ && !window_->ShouldClose()) {
+        // Only the cap and idle ceiling apply here; swaps happen on the render thread
+        frame_pacer_.WaitForFrameStart();
+        input_->Update();
+        window_->PollEvents();
+        UpdatePacingControls();
+        Time::Update();
+        
+        auto sim_start = std::chrono::steady_clock::now();
+        game_->Update();
+        game_->RecordFrame();
+        Metrics::Add("frame.sim_ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sim_start).count());
+        
+        // Blocks while the render thread is still a frame behind
+        game_->PublishFrame();
+        
+        // Render thread counters land in whichever frame is open when they are added
+        Metrics::EndFrame();
+    }
+    
+    game_->StopRendering();
+    render_thread.join();
+    
+    // Shutdown releases GL objects from this thread
+    window_->MakeContextCurrent();
+}
+
+void Engine::RenderLoop() {
+    window_->MakeContextCurrent();
+    swap_interval_ = -1;    // Swap interval is per context and thread; apply it again
+    
+    while (game_->WaitForFrame()) {
+        renderer_->BeginFrame();
+        game_->SubmitFrame();
+        renderer_->EndFrame();
+        ApplySwapInterval();
         window_->SwapBuffers();
+        game_->FramePresented();
+        GL_TRACE_PUBLISH();
     }
     
-    std::cout << "Main game loop ended." << std::endl;
+    window_->ReleaseContext();
 }
 
 void Engine::Shutdown() {
@@ -1,6 +1,7 @@
 // Main game engine - initializes and coordinates all game systems
 #pragma once
 
+#include "frame_pacer.h"
 #include <memory>
 #include <string>
 
@@ -17,7 +18,9 @@ public:
     // Initialize all engine systems
     bool Initialize();
     
-    // Main game loop
+    // Main game loop. By default simulation and rendering alternate on this thread;
+    // with CORE_PIPELINED=1 a render thread takes the GL context and draws the last
+    // published frame while the simulation records the next one.
     void Run();
     
     // Shutdown all systems
@@ -35,6 +38,9 @@ public:
     
 private:
     bool is_running_;
+    bool pipelined_;
+    FramePacer frame_pacer_;
+    int swap_interval_;     // Last interval applied by the swapping thread (-1: none)
     
     // Core systems
     std::unique_ptr<Window> window_;
@@ -47,6 +53,15 @@ private:
     bool InitializeRenderer();
     bool InitializeInput();
     bool InitializeGame();
+    
+    // Loop variants
+    void RunSequential();
+    void RunPipelined();
+    void RenderLoop();      // Render thread body (pipelined mode)
+    
+    // Shared by both loops: F11 cycles the pacing mode; the swap interval follows it
+    void UpdatePacingControls();
+    void ApplySwapInterval();
 };
 
 
@@ -0,0 +1,170 @@
+// Implementation of frame pacing
+#include "frame_pacer.h"
+#include "utils/metrics.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+namespace {
+    // Swap intervals further than this from the estimate are missed or doubled
+    // vblanks; after this many in a row the refresh rate itself has changed
+    constexpr double kIntervalOutlier = 1.5;
+    constexpr int kOutliersBeforeReset = 30;
+    constexpr double kIntervalSmoothing = 0.1;
+}
+
+FramePacer::FramePacer()
+    : mode_(PacingMode::VSync), idle_(false),
+      has_deadline_(false), has_present_(false),
+      present_interval_ms_(0.0), work_estimate_ms_(0.0), interval_outliers_(0),
+      sleep_overshoot_ms_(0.0), timer_resolution_raised_(false) {
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+    if (timer_resolution_raised_) {
+        timeEndPeriod(1);
+    }
+#endif
+}
+
+PacingMode FramePacer::CycleMode() {
+    int next = (static_cast<int>(mode_.load()) + 1) % static_cast<int>(PacingMode::Count);
+    mode_ = static_cast<PacingMode>(next);
+    has_deadline_ = false;
+    return mode_;
+}
+
+const char* FramePacer::GetModeName(PacingMode mode) {
+    switch (mode) {
+        case PacingMode::VSync: return "vsync";
+        case PacingMode::Capped: return "cap";
+        case PacingMode::JustInTime: return "jit";
+        case PacingMode::Unlimited: return "off";
+        default: return "?";
+    }
+}
+
+bool FramePacer::ParseMode(const char* text, PacingMode& mode) {
+    if (!text) return false;
+    for (int i = 0; i < static_cast<int>(PacingMode::Count); ++i) {
+        PacingMode candidate = static_cast<PacingMode>(i);
+        if (std::strcmp(text, GetModeName(candidate)) == 0) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+int FramePacer::GetSwapInterval() const {
+    PacingMode mode = mode_;
+    return (mode == PacingMode::VSync || mode == PacingMode::JustInTime) ? 1 : 0;
+}
+
+double FramePacer::WaitForFrameStart() {
+    Clock::time_point now = Clock::now();
+    Clock::time_point deadline = now;
+    PacingMode mode = mode_;
+
+    // Rate limits: the cap, and the idle ceiling in any mode
+    double period_ms = 0.0;
+    if (mode == PacingMode::Capped && settings_.cap_fps > 0.0) {
+        period_ms = 1000.0 / settings_.cap_fps;
+    }
+    if (idle_ && settings_.idle_fps > 0.0) {
+        period_ms = std::max(period_ms, 1000.0 / settings_.idle_fps);
+    }
+    if (period_ms > 0.0) {
+        auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(period_ms));
+        // A deadline missed by a whole period restarts the cadence instead of bursting
+        if (!has_deadline_ || next_deadline_ + period < now) {
+            next_deadline_ = now;
+        }
+        deadline = next_deadline_;
+        next_deadline_ += period;
+        has_deadline_ = true;
+    } else {
+        has_deadline_ = false;
+    }
+
+    // Just in time: start late enough that the frame finishes right before the vblank
+    if (mode == PacingMode::JustInTime && has_present_ && present_interval_ms_ > 0.0) {
+        double lead_ms = work_estimate_ms_ + settings_.jit_margin_ms;
+        auto start = last_present_ + std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::milli>(present_interval_ms_ - lead_ms));
+        deadline = std::max(deadline, start);
+    }
+
+    if (deadline > now) {
+        WaitUntil(deadline);
+    }
+    frame_start_ = Clock::now();
+
+    double waited_ms = std::chrono::duration<double, std::milli>(frame_start_ - now).count();
+    Metrics::Add("frame.pacing_wait_ms", waited_ms);
+    return waited_ms;
+}
+
+void FramePacer::MarkWorkEnd() {
+    double work_ms = std::chrono::duration<double, std::milli>(Clock::now() - frame_start_).count();
+    // Rise at once so a slow frame is not repeated; fall back slowly
+    if (work_ms > work_estimate_ms_) {
+        work_estimate_ms_ = work_ms;
+    } else {
+        work_estimate_ms_ += (work_ms - work_estimate_ms_) * settings_.work_decay;
+    }
+    Metrics::Set("frame.work_estimate_ms", work_estimate_ms_);
+}
+
+void FramePacer::MarkPresented() {
+    Clock::time_point now = Clock::now();
+    if (has_present_) {
+        double interval_ms = std::chrono::duration<double, std::milli>(now - last_present_).count();
+        Metrics::Add("frame.present_interval_ms", interval_ms);
+
+        if (present_interval_ms_ <= 0.0 || interval_outliers_ >= kOutliersBeforeReset) {
+            present_interval_ms_ = interval_ms;
+            interval_outliers_ = 0;
+        } else if (interval_ms < present_interval_ms_ * kIntervalOutlier) {
+            present_interval_ms_ += (interval_ms - present_interval_ms_) * kIntervalSmoothing;
+            interval_outliers_ = 0;
+        } else {
+            interval_outliers_++;
+        }
+    }
+    last_present_ = now;
+    has_present_ = true;
+}
+
+void FramePacer::WaitUntil(Clock::time_point deadline) {
+    double spin_ms = std::max(settings_.spin_ms, sleep_overshoot_ms_);
+    auto spin = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(spin_ms));
+    if (deadline - Clock::now() > spin) {
+#ifdef _WIN32
+        if (!timer_resolution_raised_) {
+            timer_resolution_raised_ = timeBeginPeriod(1) == TIMERR_NOERROR;
+        }
+#endif
+        Clock::time_point wake = deadline - spin;
+        std::this_thread::sleep_until(wake);
+
+        // Rise at once so the next wait spins long enough; fall back slowly
+        double late_ms = std::chrono::duration<double, std::milli>(Clock::now() - wake).count();
+        if (late_ms > sleep_overshoot_ms_) {
+            sleep_overshoot_ms_ = late_ms;
+        } else {
+            sleep_overshoot_ms_ += (late_ms - sleep_overshoot_ms_) * settings_.work_decay;
+        }
+        Metrics::Set("frame.sleep_overshoot_ms", sleep_overshoot_ms_);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
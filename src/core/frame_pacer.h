@@ -0,0 +1,90 @@
+// Frame pacing: vsync, a precise frame cap, or just-in-time input sampling
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+enum class PacingMode : uint8_t {
+    VSync,          // Swap interval 1, no extra waiting
+    Capped,         // Swap interval 0, frames started at a fixed rate
+    JustInTime,     // Swap interval 1, input and simulation delayed to just before the swap
+    Unlimited,      // Swap interval 0, no waiting (benchmarking)
+    Count
+};
+
+// The loop calls WaitForFrameStart before sampling input, MarkWorkEnd once the frame
+// has been submitted, and MarkPresented after the buffer swap returns.
+//
+// Waits sleep until shortly before the deadline and spin the rest on the monotonic
+// clock, since OS sleeps overshoot. The spin window follows the measured overshoot
+// (fast to rise, slow to fall), with spin_ms as its floor; on Windows the pacer also
+// raises the system timer resolution to 1 ms from its first sleep until it is
+// destroyed, as the default 15.6 ms tick would oversleep most deadlines. The cap
+// keeps a steady cadence (deadlines advance by one period) but drops missed deadlines
+// instead of bursting to catch up. Just-in-time mode predicts the next vblank from the interval
+// between swap returns and starts the frame the estimated work time (fast to rise,
+// slow to fall) plus a margin before it, so input is sampled as late as possible.
+// While idle (menus, pause) every mode is additionally held to idle_fps.
+// Apart from the mode, a pacer belongs to the thread running the loop.
+class FramePacer {
+public:
+    struct Settings {
+        double cap_fps = 120.0;         // Capped mode rate
+        double idle_fps = 30.0;         // Ceiling while idle, in every mode
+        double spin_ms = 1.5;           // Least final stretch of a wait spent spinning
+        double jit_margin_ms = 2.0;     // Slack left before the predicted vblank
+        double work_decay = 0.05;       // How fast the work and sleep overshoot estimates fall back
+    };
+
+    FramePacer();
+    ~FramePacer();
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    void SetSettings(const Settings& settings) { settings_ = settings; }
+    const Settings& GetSettings() const { return settings_; }
+
+    // Safe to read from the thread that swaps while another thread changes it
+    void SetMode(PacingMode mode) { mode_ = mode; }
+    PacingMode GetMode() const { return mode_; }
+    PacingMode CycleMode();
+    static const char* GetModeName(PacingMode mode);
+    // Accepts "vsync", "cap", "jit" or "off"; false for anything else
+    static bool ParseMode(const char* text, PacingMode& mode);
+
+    // Swap interval the mode needs (applied by whoever swaps)
+    int GetSwapInterval() const;
+
+    void SetIdle(bool idle) { idle_ = idle; }
+    bool IsIdle() const { return idle_; }
+
+    // Blocks until this frame should start; returns the time waited
+    double WaitForFrameStart();
+    void MarkWorkEnd();
+    void MarkPresented();
+
+    // Smoothed interval between swap returns (0 until measured) and work estimate
+    double GetPresentIntervalMs() const { return present_interval_ms_; }
+    double GetWorkEstimateMs() const { return work_estimate_ms_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Settings settings_;
+    std::atomic<PacingMode> mode_;
+    bool idle_;
+
+    Clock::time_point frame_start_;
+    Clock::time_point next_deadline_;   // Cadence for the cap and idle limits
+    Clock::time_point last_present_;
+    bool has_deadline_;
+    bool has_present_;
+    double present_interval_ms_;
+    double work_estimate_ms_;
+    int interval_outliers_;             // Consecutive swap intervals rejected as missed vblanks
+    double sleep_overshoot_ms_;         // How late sleeps wake up, smoothed
+    bool timer_resolution_raised_;
+
+    void WaitUntil(Clock::time_point deadline);
+};
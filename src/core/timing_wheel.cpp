@@ -0,0 +1,174 @@
+// Implementation of hierarchical timing wheel
+#include "timing_wheel.h"
+
+TimingWheel::TimingWheel() : next_tick_(1), pending_count_(0) {
+    heads_.fill(kNone);
+    tails_.fill(kNone);
+}
+
+TimingWheel::Handle TimingWheel::Schedule(uint64_t due_tick, uint32_t channel, void* payload) {
+    int32_t index;
+    if (!free_list_.empty()) {
+        index = free_list_.back();
+        free_list_.pop_back();
+    } else {
+        index = static_cast<int32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    Node& node = nodes_[index];
+    node.due_tick = due_tick < next_tick_ ? next_tick_ : due_tick;
+    node.payload = payload;
+    node.channel = channel;
+    node.in_use = true;
+    Link(index);
+    pending_count_++;
+
+    Handle handle;
+    handle.index = static_cast<uint32_t>(index);
+    handle.generation = node.generation;
+    return handle;
+}
+
+bool TimingWheel::Cancel(Handle& handle) {
+    bool cancelled = false;
+    if (IsPending(handle)) {
+        int32_t index = static_cast<int32_t>(handle.index);
+        Unlink(index);
+        FreeNode(index);
+        cancelled = true;
+    }
+    handle = Handle();
+    return cancelled;
+}
+
+bool TimingWheel::IsPending(const Handle& handle) const {
+    if (!handle.IsValid() || handle.index >= nodes_.size()) return false;
+    const Node& node = nodes_[handle.index];
+    return node.in_use && node.generation == handle.generation;
+}
+
+uint64_t TimingWheel::GetDueTick(const Handle& handle) const {
+    return IsPending(handle) ? nodes_[handle.index].due_tick : 0;
+}
+
+void TimingWheel::AdvanceTo(uint64_t tick, std::vector<Expired>& expired) {
+    while (next_tick_ <= tick) {
+        // Nothing pending: jump straight to the target tick
+        if (pending_count_ == 0) {
+            next_tick_ = tick + 1;
+            break;
+        }
+
+        int root_index = static_cast<int>(next_tick_ & (kRootSlots - 1));
+
+        // Pull the next window of timers down from the upper levels
+        if (root_index == 0 && Cascade(1) == 0 && Cascade(2) == 0 && Cascade(3) == 0) {
+            int32_t overflow = heads_[kOverflowBucket];
+            heads_[kOverflowBucket] = kNone;
+            tails_[kOverflowBucket] = kNone;
+            while (overflow != kNone) {
+                int32_t next = nodes_[overflow].next;
+                Link(overflow);
+                overflow = next;
+            }
+        }
+
+        int32_t current = heads_[root_index];
+        heads_[root_index] = kNone;
+        tails_[root_index] = kNone;
+        while (current != kNone) {
+            int32_t next = nodes_[current].next;
+            const Node& node = nodes_[current];
+            expired.push_back({node.channel, node.payload, node.due_tick});
+            FreeNode(current);
+            current = next;
+        }
+
+        next_tick_++;
+    }
+}
+
+void TimingWheel::Clear() {
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].in_use) {
+            FreeNode(static_cast<int32_t>(i));
+        }
+    }
+    heads_.fill(kNone);
+    tails_.fill(kNone);
+}
+
+uint32_t TimingWheel::BucketFor(uint64_t due_tick) const {
+    uint64_t delta = due_tick - next_tick_;
+
+    if (delta < (1ull << kRootBits)) {
+        return static_cast<uint32_t>(due_tick & (kRootSlots - 1));
+    }
+    for (int level = 1; level <= kUpperLevels; ++level) {
+        int shift = kRootBits + level * kLevelBits;
+        if (delta < (1ull << shift)) {
+            int slot_shift = kRootBits + (level - 1) * kLevelBits;
+            uint32_t slot = static_cast<uint32_t>((due_tick >> slot_shift) & (kLevelSlots - 1));
+            return kRootSlots + (level - 1) * kLevelSlots + slot;
+        }
+    }
+    return kOverflowBucket;
+}
+
+void TimingWheel::Link(int32_t index) {
+    Node& node = nodes_[index];
+    node.bucket = BucketFor(node.due_tick);
+    node.next = kNone;
+    node.prev = tails_[node.bucket];
+
+    if (node.prev != kNone) {
+        nodes_[node.prev].next = index;
+    } else {
+        heads_[node.bucket] = index;
+    }
+    tails_[node.bucket] = index;
+}
+
+void TimingWheel::Unlink(int32_t index) {
+    Node& node = nodes_[index];
+    if (node.prev != kNone) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[node.bucket] = node.next;
+    }
+    if (node.next != kNone) {
+        nodes_[node.next].prev = node.prev;
+    } else {
+        tails_[node.bucket] = node.prev;
+    }
+    node.prev = kNone;
+    node.next = kNone;
+}
+
+int TimingWheel::Cascade(int level) {
+    int slot_shift = kRootBits + (level - 1) * kLevelBits;
+    int slot = static_cast<int>((next_tick_ >> slot_shift) & (kLevelSlots - 1));
+    uint32_t bucket = kRootSlots + (level - 1) * kLevelSlots + slot;
+
+    int32_t current = heads_[bucket];
+    heads_[bucket] = kNone;
+    tails_[bucket] = kNone;
+    while (current != kNone) {
+        int32_t next = nodes_[current].next;
+        Link(current);
+        current = next;
+    }
+    return slot;
+}
+
+void TimingWheel::FreeNode(int32_t index) {
+    Node& node = nodes_[index];
+    node.in_use = false;
+    node.payload = nullptr;
+    node.prev = kNone;
+    node.next = kNone;
+    node.generation++;
+    free_list_.push_back(index);
+    pending_count_--;
+}
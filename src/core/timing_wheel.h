@@ -0,0 +1,83 @@
+// Hierarchical timing wheel for scheduling tick-based expiries
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Four-level hashed timing wheel (256 + 3 x 64 slots). Scheduling and
+// cancellation are O(1); advancing costs one slot visit per elapsed tick plus
+// the number of timers that actually expire or cascade, so idle entities cost
+// nothing per tick.
+class TimingWheel {
+public:
+    struct Handle {
+        uint32_t index = kInvalidIndex;
+        uint32_t generation = 0;
+        bool IsValid() const { return index != kInvalidIndex; }
+    };
+
+    struct Expired {
+        uint32_t channel;
+        void* payload;
+        uint64_t due_tick;
+    };
+
+    TimingWheel();
+    ~TimingWheel() = default;
+
+    // Schedule a timer that expires at `due_tick` (clamped to the next tick)
+    Handle Schedule(uint64_t due_tick, uint32_t channel, void* payload);
+
+    // Cancel a pending timer; the handle is invalidated either way
+    bool Cancel(Handle& handle);
+
+    bool IsPending(const Handle& handle) const;
+    uint64_t GetDueTick(const Handle& handle) const;
+
+    // Advance to `tick`, appending every timer that expired on the way (in due order)
+    void AdvanceTo(uint64_t tick, std::vector<Expired>& expired);
+
+    uint64_t GetCurrentTick() const { return next_tick_ - 1; }
+    size_t GetPendingCount() const { return pending_count_; }
+
+    // Drop all timers (outstanding handles become stale)
+    void Clear();
+
+    static constexpr uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+private:
+    static constexpr int kRootBits = 8;
+    static constexpr int kLevelBits = 6;
+    static constexpr int kRootSlots = 1 << kRootBits;    // 256
+    static constexpr int kLevelSlots = 1 << kLevelBits;  // 64
+    static constexpr int kUpperLevels = 3;
+    static constexpr int kBucketCount = kRootSlots + kUpperLevels * kLevelSlots;
+    static constexpr uint32_t kOverflowBucket = kBucketCount;
+    static constexpr int32_t kNone = -1;
+
+    struct Node {
+        uint64_t due_tick = 0;
+        void* payload = nullptr;
+        uint32_t channel = 0;
+        uint32_t generation = 0;
+        uint32_t bucket = 0;
+        int32_t prev = kNone;
+        int32_t next = kNone;
+        bool in_use = false;
+    };
+
+    std::vector<Node> nodes_;
+    std::vector<int32_t> free_list_;
+    std::array<int32_t, kBucketCount + 1> heads_;  // +1 for the overflow list
+    std::array<int32_t, kBucketCount + 1> tails_;
+    uint64_t next_tick_;  // first tick that has not been processed yet
+    size_t pending_count_;
+
+    uint32_t BucketFor(uint64_t due_tick) const;
+    void Link(int32_t index);
+    void Unlink(int32_t index);
+    int Cascade(int level);
+    void FreeNode(int32_t index);
+};
@@ -5,7 +5,7 @@
 #include <iostream>
 #include <stdexcept>
 
-Window::Window() : window_(nullptr), width_(0), height_(0) {
+Window::Window() : window_(nullptr), width_(0), height_(0), offscreen_(OffscreenContext::None) {
 }
 
 Window::~Window() {
@@ -18,6 +18,18 @@ Window::~Window() {
 bool Window::Initialize(int width, int height, const std::string& title) {
     std::cout << "Initializing window: " << width << "x" << height << " - " << title << std::endl;
     
+    // Displayless contexts need GLFW's null platform
+    bool displayless = offscreen_ == OffscreenContext::Egl || offscreen_ == OffscreenContext::OSMesa;
+#ifdef GLFW_PLATFORM_NULL
+    if (displayless) {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
+#else
+    if (displayless) {
+        std::cout << "GLFW has no null platform (needs 3.4); the offscreen context still needs a display" << std::endl;
+    }
+#endif
+    
     // Initialize GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW!" << std::endl;
@@ -33,6 +45,15 @@ bool Window::Initialize(int width, int height, const std::string& title) {
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
     
+    if (offscreen_ != OffscreenContext::None) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    }
+    if (offscreen_ == OffscreenContext::Egl) {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+    } else if (offscreen_ == OffscreenContext::OSMesa) {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    }
+    
     // Create window
     window_ = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
     if (!window_) {
@@ -106,6 +127,20 @@ void Window::SetScrollCallback(GLFWscrollfun callback) {
     }
 }
 
+void Window::MakeContextCurrent() {
+    if (window_) {
+        glfwMakeContextCurrent(window_);
+    }
+}
+
+void Window::ReleaseContext() {
+    glfwMakeContextCurrent(nullptr);
+}
+
+void Window::SetSwapInterval(int interval) {
+    glfwSwapInterval(interval);
+}
+
 void Window::SetResizeCallback(GLFWframebuffersizefun callback) {
     if (window_) {
         glfwSetFramebufferSizeCallback(window_, callback);
@@ -117,8 +152,8 @@ void Window::FramebufferSizeCallback(GLFWwindow* window, int width, int height)
     if (win) {
         win->width_ = width;
         win->height_ = height;
-        glViewport(0, 0, width, height);
-        // Update camera aspect via renderer is handled elsewhere; here we just log size.
+        // The render queue sets the viewport every frame (possibly on the render thread),
+        // and the camera aspect is updated elsewhere; here we just log size.
         std::cout << "Window resized to: " << width << "x" << height << std::endl;
     }
 }
@@ -10,11 +10,23 @@ typedef void (*GLFWcursorposfun)(GLFWwindow*, double, double);
 typedef void (*GLFWscrollfun)(GLFWwindow*, double, double);
 typedef void (*GLFWframebuffersizefun)(GLFWwindow*, int, int);
 
+// Contexts without a visible window (benchmarks); the frame is drawn to an
+// offscreen framebuffer, so nothing depends on the window's own surface
+enum class OffscreenContext {
+    None,       // Visible window
+    Hidden,     // Hidden window on the normal platform (needs a display)
+    Egl,        // No display: EGL context on GLFW's null platform (GLFW 3.4+)
+    OSMesa      // No display: OSMesa software context on the null platform
+};
+
 class Window {
 public:
     Window();
     ~Window();
     
+    // Choose an offscreen context; call before Initialize
+    void SetOffscreen(OffscreenContext offscreen) { offscreen_ = offscreen; }
+    
     // Initialize window
     bool Initialize(int width, int height, const std::string& title);
     
@@ -24,6 +36,14 @@ public:
     bool ShouldClose() const;
     void SetShouldClose(bool should_close);
     
+    // Bind the GL context to the calling thread, or unbind it (a context is current
+    // on at most one thread; the render thread takes it over in pipelined mode)
+    void MakeContextCurrent();
+    void ReleaseContext();
+    
+    // 1 waits for vblank on swap, 0 swaps immediately (call with the context current)
+    void SetSwapInterval(int interval);
+    
     // Getters
     GLFWwindow* GetGLFWWindow() const { return window_; }
     int GetWidth() const { return width_; }
@@ -41,6 +61,7 @@ private:
     int width_;
     int height_;
     std::string title_;
+    OffscreenContext offscreen_;
     
     // Static callback functions
     static void FramebufferSizeCallback(GLFWwindow* window, int width, int height);
@@ -0,0 +1,179 @@
+// Implementation of sort-and-sweep collision stage
+#include "collision_system.h"
+#include "projectile.h"
+#include "enemy.h"
+#include "utils/math.h"
+#include "utils/metrics.h"
+#include <algorithm>
+
+namespace {
+    template <typename Proxy>
+    void SetBounds(Proxy& proxy, const glm::vec3& a, const glm::vec3& b, float margin) {
+        for (int axis = 0; axis < 3; ++axis) {
+            proxy.min[axis] = std::min(a[axis], b[axis]) - margin;
+            proxy.max[axis] = std::max(a[axis], b[axis]) + margin;
+        }
+    }
+}
+
+CollisionSystem::CollisionSystem()
+    : hit_radius_(1.2f)
+    , broadphase_tests_(0)
+    , pair_tests_(0) {
+}
+
+void CollisionSystem::Update(const std::vector<std::unique_ptr<Projectile>>& projectiles,
+                             const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    projectile_proxies_.clear();
+    enemy_proxies_.clear();
+    best_hits_.clear();
+    piercing_hits_.clear();
+    hits_.clear();
+    broadphase_tests_ = 0;
+    pair_tests_ = 0;
+
+    // Swept AABBs: the projectile box carries the full hit radius, enemies are points
+    for (size_t i = 0; i < projectiles.size(); ++i) {
+        const Projectile* projectile = projectiles[i].get();
+        if (!projectile || !projectile->IsActive() || projectile->GetMode() == ProjectileMode::Ballistic) continue;
+
+        Proxy proxy;
+        SetBounds(proxy, projectile->GetPreviousPosition(), projectile->GetPosition(), hit_radius_);
+        proxy.index = static_cast<uint32_t>(i);
+        proxy.slot = static_cast<uint32_t>(best_hits_.size());
+        proxy.piercing = projectile->IsPiercing();
+        projectile_proxies_.push_back(proxy);
+        best_hits_.push_back({proxy.index, kNoHit, 1.0f});
+    }
+    if (projectile_proxies_.empty()) return;
+
+    for (size_t i = 0; i < enemies.size(); ++i) {
+        const Enemy* enemy = enemies[i].get();
+        if (!enemy || !enemy->IsAlive()) continue;
+
+        Proxy proxy;
+        SetBounds(proxy, enemy->GetPreviousPosition(), enemy->GetPosition(), 0.0f);
+        proxy.index = static_cast<uint32_t>(i);
+        proxy.slot = 0;
+        proxy.piercing = false;
+        enemy_proxies_.push_back(proxy);
+    }
+
+    // Sweep along the axis where the enemies are spread out the most
+    int axis = 0;
+    float best_spread = -1.0f;
+    for (int candidate = 0; candidate < 3; ++candidate) {
+        float lo = 0.0f;
+        float hi = 0.0f;
+        for (size_t i = 0; i < enemy_proxies_.size(); ++i) {
+            float value = enemy_proxies_[i].min[candidate];
+            if (i == 0 || value < lo) lo = value;
+            if (i == 0 || value > hi) hi = value;
+        }
+        if (hi - lo > best_spread) {
+            best_spread = hi - lo;
+            axis = candidate;
+        }
+    }
+
+    auto by_min = [axis](const Proxy& a, const Proxy& b) { return a.min[axis] < b.min[axis]; };
+    std::sort(projectile_proxies_.begin(), projectile_proxies_.end(), by_min);
+    std::sort(enemy_proxies_.begin(), enemy_proxies_.end(), by_min);
+
+    // Merge the two sorted lists; each new interval is tested against the still-open
+    // intervals of the other kind
+    active_projectiles_.clear();
+    active_enemies_.clear();
+    size_t p = 0;
+    size_t e = 0;
+    while (p < projectile_proxies_.size() || e < enemy_proxies_.size()) {
+        bool take_projectile = e >= enemy_proxies_.size() ||
+            (p < projectile_proxies_.size() && projectile_proxies_[p].min[axis] <= enemy_proxies_[e].min[axis]);
+
+        if (take_projectile) {
+            const Proxy& proxy = projectile_proxies_[p++];
+            PruneActive(active_enemies_, axis, proxy.min[axis]);
+            for (const Proxy* other : active_enemies_) {
+                TestPair(proxy, *other, axis, projectiles, enemies);
+            }
+            active_projectiles_.push_back(&proxy);
+        } else {
+            const Proxy& proxy = enemy_proxies_[e++];
+            PruneActive(active_projectiles_, axis, proxy.min[axis]);
+            for (const Proxy* other : active_projectiles_) {
+                TestPair(*other, proxy, axis, projectiles, enemies);
+            }
+            active_enemies_.push_back(&proxy);
+        }
+    }
+
+    for (const CollisionHit& hit : best_hits_) {
+        if (hit.enemy_index != kNoHit) {
+            hits_.push_back(hit);
+        }
+    }
+    hits_.insert(hits_.end(), piercing_hits_.begin(), piercing_hits_.end());
+    std::sort(hits_.begin(), hits_.end(), [](const CollisionHit& a, const CollisionHit& b) {
+        if (a.projectile_index != b.projectile_index) return a.projectile_index < b.projectile_index;
+        if (a.time != b.time) return a.time < b.time;
+        return a.enemy_index < b.enemy_index;
+    });
+
+    Metrics::Add("collision.broadphase_tests", broadphase_tests_);
+    Metrics::Add("collision.pair_tests", pair_tests_);
+    Metrics::Add("collision.hits", static_cast<double>(hits_.size()));
+}
+
+void CollisionSystem::TestPair(const Proxy& projectile_proxy, const Proxy& enemy_proxy, int axis,
+                               const std::vector<std::unique_ptr<Projectile>>& projectiles,
+                               const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    broadphase_tests_++;
+
+    // The sweep axis already overlaps; check the other two
+    for (int other = 0; other < 3; ++other) {
+        if (other == axis) continue;
+        if (projectile_proxy.max[other] < enemy_proxy.min[other] || enemy_proxy.max[other] < projectile_proxy.min[other]) {
+            return;
+        }
+    }
+
+    pair_tests_++;
+
+    const Projectile& projectile = *projectiles[projectile_proxy.index];
+    const Enemy& enemy = *enemies[enemy_proxy.index];
+    if (projectile.HasPierced(enemy.GetID())) return;
+
+    CollisionHit& best = best_hits_[projectile_proxy.slot];
+
+    // Both move linearly over the tick; solve in tick-fraction time
+    glm::vec3 relative_start = projectile.GetPreviousPosition() - enemy.GetPreviousPosition();
+    glm::vec3 relative_end = projectile.GetPosition() - enemy.GetPosition();
+
+    float contact_time = 0.0f;
+    if (projectile_proxy.piercing) {
+        if (Math::SweptSphereContactTime(relative_start, relative_end - relative_start, hit_radius_, 1.0f, contact_time)) {
+            piercing_hits_.push_back({projectile_proxy.index, enemy_proxy.index, contact_time});
+        }
+        return;
+    }
+
+    if (Math::SweptSphereContactTime(relative_start, relative_end - relative_start, hit_radius_, best.time, contact_time)) {
+        // Ties go to the lower enemy index so results don't depend on sweep order
+        if (best.enemy_index == kNoHit || contact_time < best.time ||
+            (contact_time == best.time && enemy_proxy.index < best.enemy_index)) {
+            best.enemy_index = enemy_proxy.index;
+            best.time = contact_time;
+        }
+    }
+}
+
+void CollisionSystem::PruneActive(std::vector<const Proxy*>& active, int axis, float min_value) {
+    for (size_t i = 0; i < active.size();) {
+        if (active[i]->max[axis] < min_value) {
+            active[i] = active.back();
+            active.pop_back();
+        } else {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+// Per-tick collision stage between projectiles and enemies
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Projectile;
+class Enemy;
+
+struct CollisionHit {
+    uint32_t projectile_index; // Index into the projectile list passed to Update
+    uint32_t enemy_index;      // Index into the enemy list passed to Update
+    float time;                // Fraction of the tick at which the spheres first touch [0, 1]
+};
+
+// Runs once per tick after integration. Every homing or straight projectile and live
+// enemy is wrapped in the AABB of its motion over the tick; sort-and-sweep along the
+// axis of largest spread finds all overlapping pairs in one pass, and each pair gets a
+// swept-sphere test. Ballistic projectiles resolve through scheduled hit events and
+// are skipped here. Piercing projectiles report every enemy their swept capsule
+// touches this tick (minus enemies they already went through); all others report
+// only their earliest hit.
+class CollisionSystem {
+public:
+    CollisionSystem();
+    ~CollisionSystem() = default;
+
+    void Update(const std::vector<std::unique_ptr<Projectile>>& projectiles,
+                const std::vector<std::unique_ptr<Enemy>>& enemies);
+
+    // Ordered by projectile index, then contact time
+    const std::vector<CollisionHit>& GetHits() const { return hits_; }
+
+    void SetHitRadius(float radius) { hit_radius_ = radius; }
+
+    // Counters for the last Update
+    int GetBroadphaseTestCount() const { return broadphase_tests_; }
+    int GetPairTestCount() const { return pair_tests_; }
+
+private:
+    struct Proxy {
+        float min[3];
+        float max[3];
+        uint32_t index;   // Projectile or enemy index
+        uint32_t slot;    // Projectile proxies: slot in best_hits_
+        bool piercing;    // Projectile proxies: report all contacts
+    };
+
+    std::vector<Proxy> projectile_proxies_;
+    std::vector<Proxy> enemy_proxies_;
+    std::vector<const Proxy*> active_projectiles_;
+    std::vector<const Proxy*> active_enemies_;
+    std::vector<CollisionHit> best_hits_; // Per projectile proxy; enemy_index == kNoHit if none
+    std::vector<CollisionHit> piercing_hits_;
+    std::vector<CollisionHit> hits_;
+
+    float hit_radius_;
+    int broadphase_tests_;
+    int pair_tests_;
+
+    static constexpr uint32_t kNoHit = 0xFFFFFFFFu;
+
+    void TestPair(const Proxy& projectile_proxy, const Proxy& enemy_proxy, int axis,
+                  const std::vector<std::unique_ptr<Projectile>>& projectiles,
+                  const std::vector<std::unique_ptr<Enemy>>& enemies);
+    static void PruneActive(std::vector<const Proxy*>& active, int axis, float min_value);
+};
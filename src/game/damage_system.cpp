@@ -0,0 +1,95 @@
+// Implementation of deferred damage application
+#include "damage_system.h"
+#include "enemy.h"
+#include "wave_manager.h"
+#include "targeting_index.h"
+#include "utils/metrics.h"
+#include <algorithm>
+
+DamageSystem::DamageSystem()
+    : wave_manager_(nullptr)
+    , targeting_index_(nullptr) {
+}
+
+void DamageSystem::Apply(const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    deaths_.clear();
+    if (buffer_.IsEmpty()) return;
+
+    // The spawner keeps the list id-ordered, which allows a merge-join. Any other
+    // order falls back to a lookup table rather than dropping damage as overkill.
+    bool id_ordered = true;
+    for (size_t i = 1; i < enemies.size() && id_ordered; ++i) {
+        id_ordered = enemies[i - 1] && enemies[i] && enemies[i - 1]->GetID() < enemies[i]->GetID();
+    }
+    if (!id_ordered) {
+        enemy_lookup_.clear();
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            if (enemies[i]) {
+                enemy_lookup_[enemies[i]->GetID()] = i;
+            }
+        }
+    }
+
+    std::vector<DamageEvent>& events = buffer_.GetEvents();
+    Metrics::Add("damage.events", static_cast<double>(events.size()));
+
+    // Stable sort keeps the append order per enemy, so float sums are reproducible
+    std::stable_sort(events.begin(), events.end(), [](const DamageEvent& a, const DamageEvent& b) {
+        return a.enemy_id < b.enemy_id;
+    });
+
+    size_t enemy_index = 0;
+    size_t wasted_events = 0;
+    size_t i = 0;
+    while (i < events.size()) {
+        uint32_t enemy_id = events[i].enemy_id;
+        size_t group_begin = i;
+        float total = 0.0f;
+        for (; i < events.size() && events[i].enemy_id == enemy_id; ++i) {
+            total += events[i].amount;
+        }
+        size_t group_size = i - group_begin;
+
+        Enemy* enemy = nullptr;
+        if (id_ordered) {
+            // Both sequences are sorted by id: advance the enemy cursor to this id
+            while (enemy_index < enemies.size() && (!enemies[enemy_index] || enemies[enemy_index]->GetID() < enemy_id)) {
+                enemy_index++;
+            }
+            if (enemy_index < enemies.size() && enemies[enemy_index]->GetID() == enemy_id) {
+                enemy = enemies[enemy_index].get();
+            }
+        } else {
+            auto it = enemy_lookup_.find(enemy_id);
+            if (it != enemy_lookup_.end()) {
+                enemy = enemies[it->second].get();
+            }
+        }
+
+        // Damage for enemies that are already removed or dead is overkill
+        if (!enemy || !enemy->IsAlive()) {
+            wasted_events += group_size;
+            continue;
+        }
+
+        enemy->TakeDamage(total);
+        if (!enemy->IsAlive()) {
+            deaths_.push_back({enemy_id, enemy->GetPosition()});
+        } else if (targeting_index_) {
+            targeting_index_->UpdateHealth(*enemy);
+        }
+    }
+    buffer_.Clear();
+
+    Metrics::Add("damage.deaths", static_cast<double>(deaths_.size()));
+    Metrics::Add("damage.wasted_events", static_cast<double>(wasted_events));
+
+    if (!deaths_.empty() && wave_manager_) {
+        wave_manager_->OnEnemiesDestroyed(deaths_);
+    }
+}
+
+void DamageSystem::Clear() {
+    buffer_.Clear();
+    deaths_.clear();
+}
@@ -0,0 +1,70 @@
+// Deferred per-tick damage buffer with batched death processing
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class Enemy;
+class WaveManager;
+class TargetingIndex;
+
+struct DamageEvent {
+    uint32_t enemy_id;
+    float amount;
+};
+
+struct EnemyDeath {
+    uint32_t enemy_id;
+    glm::vec3 position;
+};
+
+// Append-only list of damage events. Sources (projectiles, direct turret fire, area
+// effects) only push here during the tick; worker-local buffers can be merged into
+// the main one before Apply.
+class DamageBuffer {
+public:
+    void Add(uint32_t enemy_id, float amount) { events_.push_back({enemy_id, amount}); }
+    void Append(const DamageBuffer& other) { events_.insert(events_.end(), other.events_.begin(), other.events_.end()); }
+    void Clear() { events_.clear(); }
+
+    bool IsEmpty() const { return events_.empty(); }
+    size_t GetSize() const { return events_.size(); }
+    std::vector<DamageEvent>& GetEvents() { return events_; }
+
+private:
+    std::vector<DamageEvent> events_;
+};
+
+// Once per tick: sums damage per enemy in id order, applies it, and reports all deaths
+// of the tick to the wave manager as one batch.
+class DamageSystem {
+public:
+    DamageSystem();
+    ~DamageSystem() = default;
+
+    void SetWaveManager(WaveManager* wave_manager) { wave_manager_ = wave_manager; }
+    void SetTargetingIndex(TargetingIndex* targeting_index) { targeting_index_ = targeting_index; } // Re-keyed on health changes
+
+    DamageBuffer& GetBuffer() { return buffer_; }
+    void AddDamage(uint32_t enemy_id, float amount) { buffer_.Add(enemy_id, amount); }
+
+    // Events and enemies are joined in one linear pass when `enemies` is ordered by id
+    // (as the spawner keeps it), and through an id lookup table otherwise.
+    void Apply(const std::vector<std::unique_ptr<Enemy>>& enemies);
+
+    // Deaths resolved by the last Apply, ordered by enemy id
+    const std::vector<EnemyDeath>& GetDeaths() const { return deaths_; }
+
+    // Drop pending damage (e.g. when the game restarts)
+    void Clear();
+
+private:
+    DamageBuffer buffer_;
+    std::vector<EnemyDeath> deaths_;
+    std::unordered_map<uint32_t, size_t> enemy_lookup_; // Id -> index, only for unordered lists
+    WaveManager* wave_manager_;
+    TargetingIndex* targeting_index_;
+};
@@ -0,0 +1,153 @@
+// Implementation of legendary effect resolution
+#include "effect_system.h"
+#include "enemy.h"
+#include "projectile.h"
+#include "spatial_grid.h"
+#include "damage_system.h"
+#include "status_system.h"
+#include "utils/metrics.h"
+#include <algorithm>
+
+EffectSystem::EffectSystem()
+    : grid_(nullptr)
+    , damage_system_(nullptr)
+    , status_system_(nullptr) {
+}
+
+bool EffectSystem::HasOnHitEffects(EffectMask effects) {
+    return HasEffect(effects, LegendaryEffect::ChainLightning) ||
+           HasEffect(effects, LegendaryEffect::Explosive) ||
+           HasEffect(effects, LegendaryEffect::SplitShot) ||
+           HasEffect(effects, LegendaryEffect::Frost) ||
+           HasEffect(effects, LegendaryEffect::Burn) ||
+           HasEffect(effects, LegendaryEffect::Stun);
+}
+
+void EffectSystem::Resolve(const std::vector<std::unique_ptr<Enemy>>& enemies, std::vector<ShotSpec>& spawned_shots) {
+    if (hits_.empty()) return;
+
+    // Queries index the grid, so it has to describe the same enemy list
+    bool grid_valid = grid_ && grid_->GetEntryCount() <= enemies.size();
+
+    for (const EffectHit& hit : hits_) {
+        if (hit.enemy_index >= enemies.size()) continue;
+
+        if (grid_valid && damage_system_) {
+            if (HasEffect(hit.effects, LegendaryEffect::Explosive)) {
+                ResolveExplosion(hit, enemies);
+            }
+            if (HasEffect(hit.effects, LegendaryEffect::ChainLightning)) {
+                ResolveChain(hit, enemies);
+            }
+        }
+        if (HasEffect(hit.effects, LegendaryEffect::SplitShot)) {
+            ResolveSplit(hit, enemies, spawned_shots);
+        }
+        if (status_system_) {
+            ResolveStatus(hit, enemies);
+        }
+    }
+
+    Metrics::Add("effects.hits", static_cast<double>(hits_.size()));
+    hits_.clear();
+}
+
+void EffectSystem::ResolveExplosion(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    query_scratch_.clear();
+    grid_->QueryRadius(hit.position, kExplosionRadius, query_scratch_);
+
+    float damage = hit.damage * kExplosionDamageFactor;
+    int victims = 0;
+    for (uint32_t index : query_scratch_) {
+        if (index == hit.enemy_index) continue; // The direct hit already took full damage
+        const Enemy* enemy = enemies[index].get();
+        if (!enemy || !enemy->IsAlive()) continue;
+
+        damage_system_->AddDamage(enemy->GetID(), damage);
+        victims++;
+    }
+    Metrics::Add("effects.explosion_victims", victims);
+}
+
+void EffectSystem::ResolveChain(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    uint32_t visited[kChainHops + 1];
+    int visited_count = 0;
+    visited[visited_count++] = hit.enemy_index;
+
+    glm::vec3 from = enemies[hit.enemy_index]->GetPosition();
+    float damage = hit.damage * kChainDamageFactor;
+
+    for (int hop = 0; hop < kChainHops; ++hop) {
+        // The nearest unvisited enemy is among the (visited + 1) nearest
+        query_scratch_.clear();
+        grid_->QueryNearest(from, static_cast<size_t>(visited_count) + 1, kChainRange, query_scratch_);
+
+        const Enemy* next = nullptr;
+        for (uint32_t index : query_scratch_) {
+            if (std::find(visited, visited + visited_count, index) != visited + visited_count) continue;
+            const Enemy* candidate = enemies[index].get();
+            if (!candidate || !candidate->IsAlive()) continue;
+
+            next = candidate;
+            visited[visited_count++] = index;
+            break;
+        }
+        if (!next) break;
+
+        damage_system_->AddDamage(next->GetID(), damage);
+        from = next->GetPosition();
+        Metrics::Add("effects.chain_hops");
+    }
+}
+
+void EffectSystem::ResolveSplit(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies,
+                                std::vector<ShotSpec>& spawned_shots) {
+    // Fragments keep the other effects but never split or multiply again
+    EffectMask fragment_effects = hit.effects & ~(EffectBit(LegendaryEffect::SplitShot) | EffectBit(LegendaryEffect::Multishot));
+    int fragment_damage = std::max(1, static_cast<int>(hit.damage * kSplitDamageFactor));
+    uint32_t source_id = enemies[hit.enemy_index] ? enemies[hit.enemy_index]->GetID() : 0;
+
+    for (int i = 0; i < kSplitCount; ++i) {
+        float side = (i % 2 == 0) ? 1.0f : -1.0f;
+        float angle = side * kSplitAngleDegrees * static_cast<float>(i / 2 + 1);
+
+        ShotSpec shot;
+        shot.origin = hit.position;
+        shot.direction = RotateAroundUp(hit.direction, angle);
+        shot.speed = hit.speed;
+        shot.damage = fragment_damage;
+        shot.effects = fragment_effects;
+        shot.lifetime = kSplitLifetime;
+        shot.ignore_enemy_id = source_id; // Don't re-hit the enemy that split the shot
+        spawned_shots.push_back(shot);
+    }
+    Metrics::Add("effects.split_fragments", kSplitCount);
+}
+
+glm::vec3 EffectSystem::RotateAroundUp(const glm::vec3& direction, float degrees) {
+    // The play area's ground plane is XY; Z is up
+    glm::vec3 up(0.0f, 0.0f, 1.0f);
+    glm::vec3 side = glm::cross(direction, up);
+    if (glm::dot(side, side) < 1e-6f) {
+        side = glm::cross(direction, glm::vec3(1.0f, 0.0f, 0.0f));
+    }
+    side = glm::normalize(side);
+
+    float radians = glm::radians(degrees);
+    return glm::normalize(direction * glm::cos(radians) + side * glm::sin(radians));
+}
+
+void EffectSystem::ResolveStatus(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    Enemy* enemy = enemies[hit.enemy_index].get();
+    if (!enemy || !enemy->IsAlive()) return;
+
+    if (HasEffect(hit.effects, LegendaryEffect::Frost)) {
+        status_system_->Apply(*enemy, StatusEffect::Slow, hit.damage);
+    }
+    if (HasEffect(hit.effects, LegendaryEffect::Burn)) {
+        status_system_->Apply(*enemy, StatusEffect::Burn, hit.damage);
+    }
+    if (HasEffect(hit.effects, LegendaryEffect::Stun)) {
+        status_system_->Apply(*enemy, StatusEffect::Stun, hit.damage);
+    }
+}
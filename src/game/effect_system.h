@@ -0,0 +1,73 @@
+// Legendary on-hit effects resolved in batches with spatial queries
+#pragma once
+
+#include "item.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Enemy;
+class SpatialGrid;
+class DamageSystem;
+class StatusSystem;
+struct ShotSpec;
+
+// A projectile hit that carries on-hit effects
+struct EffectHit {
+    EffectMask effects;
+    uint32_t enemy_index;   // Enemy that was hit (index into the tick's enemy list and grid)
+    glm::vec3 position;     // Impact point
+    glm::vec3 direction;    // Flight direction of the projectile
+    float speed;
+    float damage;           // Damage of the triggering hit
+};
+
+// Hits are queued while projectiles resolve and processed together once per tick:
+// Explosive uses grid radius queries, ChainLightning hops with k-nearest queries,
+// SplitShot emits fragment shots that the projectile manager spawns in bulk, and Frost,
+// Burn and Stun put status effects on the enemy hit. All damage goes through the
+// damage buffer, so effects never recurse within a tick.
+class EffectSystem {
+public:
+    static constexpr int kChainHops = 2;
+    static constexpr float kChainRange = 8.0f;
+    static constexpr float kChainDamageFactor = 0.5f;
+    static constexpr float kExplosionRadius = 3.0f;
+    static constexpr float kExplosionDamageFactor = 0.5f;
+    static constexpr int kSplitCount = 2;
+    static constexpr float kSplitAngleDegrees = 25.0f;
+    static constexpr float kSplitDamageFactor = 0.5f;
+    static constexpr float kSplitLifetime = 1.0f;
+
+    EffectSystem();
+    ~EffectSystem() = default;
+
+    void SetEnemyGrid(const SpatialGrid* grid) { grid_ = grid; }
+    void SetDamageSystem(DamageSystem* damage_system) { damage_system_ = damage_system; }
+    void SetStatusSystem(StatusSystem* status_system) { status_system_ = status_system; }
+
+    static bool HasOnHitEffects(EffectMask effects);
+    void QueueHit(const EffectHit& hit) { hits_.push_back(hit); }
+    size_t GetQueuedCount() const { return hits_.size(); }
+
+    // Resolve all queued hits against `enemies` (indices must match the grid);
+    // fragment shots are appended to `spawned_shots`
+    void Resolve(const std::vector<std::unique_ptr<Enemy>>& enemies, std::vector<ShotSpec>& spawned_shots);
+
+    // Direction rotated by `degrees` around the axis perpendicular to it and the world up
+    static glm::vec3 RotateAroundUp(const glm::vec3& direction, float degrees);
+
+private:
+    const SpatialGrid* grid_;
+    DamageSystem* damage_system_;
+    StatusSystem* status_system_;
+    std::vector<EffectHit> hits_;
+    std::vector<uint32_t> query_scratch_;
+
+    void ResolveExplosion(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    void ResolveChain(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    void ResolveSplit(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies,
+                      std::vector<ShotSpec>& spawned_shots);
+    void ResolveStatus(const EffectHit& hit, const std::vector<std::unique_ptr<Enemy>>& enemies);
+};
@@ -2,51 +2,197 @@
 #include "enemy.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/random.hpp>
+#include <algorithm>
 #include <iostream>
+#include <limits>
 
-Enemy::Enemy() : 
-    position_(0.0f),
+Enemy::Enemy(uint32_t id) : 
+    Entity(id),
+    origin_(0.0f),
+    start_time_(0.0),
+    travel_distance_(0.0f),
+    previous_origin_(0.0f),
+    previous_start_time_(0.0),
+    previous_direction_(0.0f),
+    previous_speed_(0.0f),
+    previous_travel_distance_(0.0f),
+    arrival_time_(std::numeric_limits<double>::infinity()),
     target_position_(0.0f),
-    speed_(4.5f), // -10% speed
-    health_(10.0f),      // Снижено в 10 раз
-    max_health_(10.0f),  // Снижено в 10 раз
+    waypoint_(0.0f),
+    has_waypoint_(false),
+    separation_offset_(0.0f),
+    previous_separation_offset_(0.0f),
+    separation_time_(-1.0),
+    speed_(kBaseSpeed), // -10% speed
+    speed_multiplier_(1.0f),
+    status_mask_(0),
+    health_(kBaseHealth),      // Снижено в 10 раз
+    max_health_(kBaseHealth),  // Снижено в 10 раз
+    pending_damage_(0.0f),
     color_(1.0f, 0.0f, 0.0f), // Red color for enemies
     alive_(false),
     initialized_(false),
     has_reached_core_(false),
     direction_(0.0f),
-    distance_to_target_(0.0f) {
+    sim_clock_(nullptr),
+    local_time_(0.0),
+    previous_local_time_(0.0) {
 }
 
 Enemy::~Enemy() {
+    if (sim_clock_) {
+        sim_clock_->Cancel(arrival_timer_);
+    }
 }
 
 bool Enemy::Initialize(const glm::vec3& spawn_position) {
     std::cout << "Initializing enemy at position: " 
               << spawn_position.x << ", " << spawn_position.y << ", " << spawn_position.z << std::endl;
     
-    position_ = spawn_position;
+    origin_ = spawn_position;
+    start_time_ = GetMotionTime();
+    previous_origin_ = spawn_position;
+    previous_start_time_ = start_time_;
     target_position_ = glm::vec3(0.0f, 0.0f, 0.0f); // Center cube position
     alive_ = true;
     initialized_ = true;
     
-    // Update direction to target
-    UpdateDirection();
+    // Direction to target and core arrival
+    UpdateMotion();
     
     return true;
 }
 
 void Enemy::Update(float delta_time) {
-    if (!alive_ || !initialized_) return;
+    if (!alive_ || !initialized_ || sim_clock_) return;
     
-    // Move towards target
-    MoveTowardsTarget(delta_time);
+    // No sim clock: step the local clock and poll for arrival
+    previous_local_time_ = local_time_;
+    local_time_ += delta_time;
+    if (local_time_ >= arrival_time_) {
+        OnReachedCore();
+    }
+}
+
+void Enemy::OnReachedCore() {
+    arrival_timer_ = SimClock::TimerHandle();
+    if (!alive_ || has_reached_core_) return;
     
-    // Check if reached target (center cube)
-    if (distance_to_target_ < 1.0f && !has_reached_core_) {
-        std::cout << "Enemy reached center cube!" << std::endl;
-        has_reached_core_ = true;
-        Die();
+    std::cout << "Enemy reached center cube!" << std::endl;
+    has_reached_core_ = true;
+    Die();
+}
+
+glm::vec3 Enemy::GetPreviousPosition() const {
+    double previous_time = sim_clock_ ? sim_clock_->GetPreviousTime() : previous_local_time_;
+    bool offset_changed = separation_time_ == GetMotionTime();
+    return GetTrackPositionAt(previous_time) + (offset_changed ? previous_separation_offset_ : separation_offset_);
+}
+
+glm::vec3 Enemy::GetTrackPositionAt(double time) const {
+    // Before the last rebase: the segment it replaced
+    if (time < start_time_) {
+        float elapsed = static_cast<float>(std::max(0.0, time - previous_start_time_));
+        return previous_origin_ + previous_direction_ * glm::min(previous_speed_ * elapsed, previous_travel_distance_);
+    }
+    
+    // Clamped at the core reach point, so large timesteps can't overshoot the core
+    float elapsed = static_cast<float>(time - start_time_);
+    return origin_ + direction_ * glm::min(GetCurrentSpeed() * elapsed, travel_distance_);
+}
+
+float Enemy::GetTimeToReachCore() const {
+    if (!alive_ || speed_ <= 0.0f) return 0.0f;
+    return static_cast<float>(std::max(0.0, arrival_time_ - GetMotionTime()));
+}
+
+double Enemy::GetArrivalEstimate() const {
+    if (!has_waypoint_) return arrival_time_;
+    
+    float speed = GetCurrentSpeed();
+    if (!alive_ || speed <= 0.0f) return std::numeric_limits<double>::infinity();
+    float distance = glm::max(0.0f, glm::length(GetTrackPosition() - target_position_) - kCoreReachDistance);
+    return GetMotionTime() + distance / speed;
+}
+
+void Enemy::SetTargetPosition(const glm::vec3& target) {
+    if (initialized_) RebaseMotion();
+    target_position_ = target;
+    if (initialized_) UpdateMotion();
+}
+
+void Enemy::SetSpeed(float speed) {
+    if (initialized_) RebaseMotion();
+    speed_ = speed;
+    if (initialized_) UpdateMotion();
+}
+
+void Enemy::SetSpeedMultiplier(float multiplier) {
+    if (multiplier == speed_multiplier_) return;
+    if (initialized_) RebaseMotion();
+    speed_multiplier_ = multiplier;
+    if (initialized_) UpdateMotion();
+}
+
+void Enemy::SetWaypoint(const glm::vec3& waypoint) {
+    if (!initialized_) return;
+    RebaseMotion();
+    waypoint_ = waypoint;
+    has_waypoint_ = true;
+    UpdateMotion();
+}
+
+void Enemy::ClearWaypoint() {
+    if (!has_waypoint_) return;
+    RebaseMotion();
+    has_waypoint_ = false;
+    UpdateMotion();
+}
+
+void Enemy::SetSeparationOffset(const glm::vec3& offset) {
+    // Keep the offset from the start of the tick for swept collision
+    double now = GetMotionTime();
+    if (separation_time_ != now) {
+        previous_separation_offset_ = separation_offset_;
+        separation_time_ = now;
+    }
+    separation_offset_ = offset;
+}
+
+void Enemy::RebaseMotion() {
+    double now = GetMotionTime();
+    
+    // A second rebase at the same time keeps the segment that actually ran
+    if (start_time_ < now) {
+        previous_origin_ = origin_;
+        previous_start_time_ = start_time_;
+        previous_direction_ = direction_;
+        previous_speed_ = GetCurrentSpeed();
+        previous_travel_distance_ = travel_distance_;
+    }
+    origin_ = GetTrackPositionAt(now);
+    start_time_ = now;
+}
+
+void Enemy::UpdateMotion() {
+    glm::vec3 to_target = (has_waypoint_ ? waypoint_ : target_position_) - origin_;
+    float distance = glm::length(to_target);
+    direction_ = distance > 0.001f ? to_target / distance : glm::vec3(0.0f);
+    travel_distance_ = has_waypoint_ ? distance : glm::max(0.0f, distance - kCoreReachDistance);
+    
+    // A steered enemy's arrival depends on waypoints not chosen yet
+    arrival_time_ = std::numeric_limits<double>::infinity();
+    float speed = GetCurrentSpeed();
+    if (alive_ && speed > 0.0f && !has_waypoint_) {
+        arrival_time_ = start_time_ + travel_distance_ / speed;
+    }
+    
+    // One event per segment replaces the per-tick distance check
+    if (sim_clock_) {
+        sim_clock_->Cancel(arrival_timer_);
+        if (arrival_time_ != std::numeric_limits<double>::infinity()) {
+            arrival_timer_ = sim_clock_->ScheduleAt(SimTimer::EnemyReachCore, arrival_time_, this);
+        }
     }
 }
 
@@ -71,33 +217,16 @@ void Enemy::TakeDamage(float damage) {
 void Enemy::Die() {
     if (!alive_) return;
     
+    // Freeze where we are: the motion segment ends here
+    RebaseMotion();
+    travel_distance_ = 0.0f;
+    arrival_time_ = std::numeric_limits<double>::infinity();
+    if (sim_clock_) {
+        sim_clock_->Cancel(arrival_timer_);
+    }
+    
     alive_ = false;
+    glm::vec3 position = GetPosition();
     std::cout << "Enemy died at position: " 
-              << position_.x << ", " << position_.y << ", " << position_.z << std::endl;
+              << position.x << ", " << position.y << ", " << position.z << std::endl;
 }
-
-void Enemy::MoveTowardsTarget(float delta_time) {
-    if (!alive_) return;
-    
-    // Update direction to target
-    UpdateDirection();
-    
-    // Move towards target
-    glm::vec3 movement = direction_ * speed_ * delta_time;
-    position_ += movement;
-    
-    // Update distance to target
-    distance_to_target_ = glm::length(target_position_ - position_);
-}
-
-void Enemy::UpdateDirection() {
-    glm::vec3 to_target = target_position_ - position_;
-    distance_to_target_ = glm::length(to_target);
-    
-    if (distance_to_target_ > 0.001f) {
-        direction_ = glm::normalize(to_target);
-    } else {
-        direction_ = glm::vec3(0.0f);
-    }
-}
-
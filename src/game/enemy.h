@@ -1,52 +1,123 @@
 // Enemy entity that moves toward the center cube
 #pragma once
 
+#include "entity.h"
+#include "sim_clock.h"
 #include <glm/glm.hpp>
 #include <memory>
 
-class Enemy {
+// Enemies fly a straight line at constant speed, so motion is stored as a segment
+// (origin, direction, speed, start time) and the position is evaluated from the sim
+// clock only when someone asks for it. Core arrival is scheduled on the clock when the
+// segment starts; changing speed or target rebases the segment at the current position.
+// The segment a rebase replaced answers for earlier times, so a ballistic hit check or
+// the swept collision over the tick still sees where the enemy was before a slow, stun
+// or new waypoint.
+class Enemy : public Entity {
 public:
-    Enemy();
+    static constexpr float kCoreReachDistance = 1.0f; // Enemy counts as arrived within this distance
+    static constexpr float kBaseSpeed = 4.5f;          // Before wave difficulty
+    static constexpr float kBaseHealth = 10.0f;
+
+    explicit Enemy(uint32_t id);
     ~Enemy();
 
+    // Attach before Initialize; without a clock, Update(delta_time) advances a local clock
+    void SetSimClock(SimClock* sim_clock) { sim_clock_ = sim_clock; }
+
     // Initialize enemy with spawn position
     bool Initialize(const glm::vec3& spawn_position);
 
-    // Update enemy logic
+    // Update enemy logic (only needed without a sim clock; with one, arrival is an event)
     void Update(float delta_time);
+    void OnReachedCore();
 
     // Render enemy
     void Render();
 
     // Getters
-    glm::vec3 GetPosition() const { return position_; }
+    glm::vec3 GetPosition() const { return GetPositionAt(GetMotionTime()); }
+    glm::vec3 GetPreviousPosition() const; // Position at the start of the last tick
+    glm::vec3 GetPositionAt(double time) const { return GetTrackPositionAt(time) + separation_offset_; }
     glm::vec3 GetTargetPosition() const { return target_position_; }
-    float GetSpeed() const { return speed_; }
+    float GetSpeed() const { return speed_; } // Base speed, before status effects
+    float GetCurrentSpeed() const { return speed_ * speed_multiplier_; }
     float GetHealth() const { return health_; }
     float GetMaxHealth() const { return max_health_; }
     bool IsAlive() const { return alive_; }
     glm::vec3 GetColor() const { return color_; }
     bool HasReachedCore() const { return has_reached_core_; }
+    glm::vec3 GetVelocity() const { return alive_ ? direction_ * GetCurrentSpeed() : glm::vec3(0.0f); }
+    float GetTimeToReachCore() const; // Seconds until the enemy reaches the core on its current course
+    double GetArrivalTime() const { return arrival_time_; } // Sim time of core arrival
+    // Arrival key for targeting: the scheduled arrival, or while steering the straight-line
+    // distance left at the current speed (infinity while stunned)
+    double GetArrivalEstimate() const;
 
     // Setters
-    void SetTargetPosition(const glm::vec3& target) { target_position_ = target; }
-    void SetSpeed(float speed) { speed_ = speed; }
+    void SetTargetPosition(const glm::vec3& target);
+    void SetSpeed(float speed);
+
+    // Status effects (set by the status system): active effect bits, and the speed
+    // multiplier they add up to. Changing the multiplier rebases the motion segment,
+    // so movement stays closed-form and arrival is rescheduled once per change.
+    void SetSpeedMultiplier(float multiplier);
+    float GetSpeedMultiplier() const { return speed_multiplier_; }
+    void SetStatusMask(uint8_t mask) { status_mask_ = mask; }
+    uint8_t GetStatusMask() const { return status_mask_; }
+
+    // Flow-field steering: head for `waypoint` and stop there until the next one is set.
+    // No core arrival is scheduled while steering; clearing the waypoint resumes the
+    // straight course to the target.
+    void SetWaypoint(const glm::vec3& waypoint);
+    void ClearWaypoint();
+    bool HasWaypoint() const { return has_waypoint_; }
+
+    // Crowd spacing: a small displacement from the motion track, set by the separation
+    // pass. It rides along with the track and never changes the scheduled arrival.
+    void SetSeparationOffset(const glm::vec3& offset);
+    glm::vec3 GetSeparationOffset() const { return separation_offset_; }
+    glm::vec3 GetTrackPosition() const { return GetTrackPositionAt(GetMotionTime()); } // Position without the offset
     void SetHealth(float health) { health_ = health; }
+    void SetMaxHealth(float max_health) { max_health_ = max_health; }
     void SetColor(const glm::vec3& color) { color_ = color; }
 
     // Combat
     void TakeDamage(float damage);
     void Die();
 
-    // Movement
-    void MoveTowardsTarget(float delta_time);
+    // Damage committed by projectiles still in flight; turrets skip enemies whose
+    // pending damage is already lethal
+    float GetPendingDamage() const { return pending_damage_; }
+    void ReserveDamage(float amount) { pending_damage_ += amount; }
+    void ReleaseDamage(float amount) { pending_damage_ = glm::max(0.0f, pending_damage_ - amount); }
+    bool IsDoomed() const { return pending_damage_ >= health_; }
+
+    // Restart the motion segment at the current position and time
+    void RebaseMotion();
 
 private:
-    glm::vec3 position_;        // Current position
+    glm::vec3 origin_;          // Position at start_time_
+    double start_time_;         // Sim time the current motion segment started
+    float travel_distance_;     // Distance from origin_ to the core reach point (or the waypoint)
+    glm::vec3 previous_origin_;         // Segment replaced by the last rebase
+    double previous_start_time_;
+    glm::vec3 previous_direction_;
+    float previous_speed_;              // Speed it ran at (the multiplier may change with the rebase)
+    float previous_travel_distance_;
+    double arrival_time_;       // Sim time the enemy reaches the core (infinity if it never does)
     glm::vec3 target_position_; // Target position (center cube)
+    glm::vec3 waypoint_;        // Steering waypoint (when has_waypoint_)
+    bool has_waypoint_;
+    glm::vec3 separation_offset_;           // Displacement from the track
+    glm::vec3 previous_separation_offset_;  // Offset before the last change
+    double separation_time_;                // Sim time of the last offset change
     float speed_;               // Movement speed
+    float speed_multiplier_;    // From status effects (slow < 1, stun 0)
+    uint8_t status_mask_;       // Active status effect bits
     float health_;              // Current health
     float max_health_;          // Maximum health
+    float pending_damage_;      // Reserved by projectiles in flight
     glm::vec3 color_;           // Enemy color (red for enemies)
     bool alive_;                // Is enemy alive
     bool initialized_;          // Is enemy initialized
@@ -54,9 +125,17 @@ private:
 
     // Movement calculations
     glm::vec3 direction_;       // Direction to target
-    float distance_to_target_;  // Distance to target
 
-    // Update movement direction
-    void UpdateDirection();
+    // Time source: the sim clock, or a local clock stepped by Update()
+    SimClock* sim_clock_;
+    SimClock::TimerHandle arrival_timer_;
+    double local_time_;
+    double previous_local_time_;
+
+    double GetMotionTime() const { return sim_clock_ ? sim_clock_->GetTime() : local_time_; }
+    glm::vec3 GetTrackPositionAt(double time) const;
+
+    // Direction, travel distance and arrival for the current segment
+    void UpdateMotion();
 };
 
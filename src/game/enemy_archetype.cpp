@@ -0,0 +1,163 @@
+// Implementation of the enemy archetype table and its data file parser
+#include "enemy_archetype.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    std::string Trim(const std::string& text) {
+        size_t begin = text.find_first_not_of(" \t\r");
+        if (begin == std::string::npos) return "";
+        size_t end = text.find_last_not_of(" \t\r");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    bool ParseFloat(const std::string& value, float& out) {
+        std::istringstream stream(value);
+        stream >> out;
+        return !stream.fail() && stream.eof();
+    }
+
+    bool ParseColor(const std::string& value, glm::vec3& out) {
+        std::istringstream stream(value);
+        stream >> out.r >> out.g >> out.b;
+        return !stream.fail() && (stream >> std::ws).eof();
+    }
+
+    bool ParseFlags(const std::string& value, uint32_t& out) {
+        std::istringstream stream(value);
+        std::string flag;
+        out = 0;
+        while (stream >> flag) {
+            if (flag == "none") continue;
+            else if (flag == "regenerates") out |= static_cast<uint32_t>(EnemyBehavior::Regenerates);
+            else if (flag == "flying") out |= static_cast<uint32_t>(EnemyBehavior::Flying);
+            else return false;
+        }
+        return true;
+    }
+}
+
+EnemyArchetypeTable::EnemyArchetypeTable() {
+    LoadDefaults();
+}
+
+void EnemyArchetypeTable::LoadDefaults() {
+    archetypes_.clear();
+
+    EnemyArchetype grunt;
+    grunt.name = "grunt";
+    grunt.weight = 0.7f;
+    archetypes_.push_back(grunt);
+
+    // Less health, more speed; yellow tint
+    EnemyArchetype runner;
+    runner.name = "runner";
+    runner.weight = 0.3f;
+    runner.health = 6.0f;
+    runner.speed = 6.0f;
+    runner.color = glm::vec3(1.0f, 1.0f, 0.0f);
+    archetypes_.push_back(runner);
+
+    UpdateWeights();
+}
+
+bool EnemyArchetypeTable::LoadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return LoadFromString(buffer.str(), path);
+}
+
+bool EnemyArchetypeTable::LoadFromString(const std::string& text, const std::string& source) {
+    std::vector<EnemyArchetype> archetypes;
+    std::istringstream stream(text);
+    std::string line;
+    int line_number = 0;
+
+    auto fail = [&](const std::string& message) {
+        std::cerr << source << ":" << line_number << ": " << message << std::endl;
+        return false;
+    };
+
+    while (std::getline(stream, line)) {
+        line_number++;
+        line = Trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        if (line.front() == '[') {
+            if (line.back() != ']') return fail("unterminated section header");
+            EnemyArchetype archetype;
+            archetype.name = Trim(line.substr(1, line.size() - 2));
+            if (archetype.name.empty()) return fail("empty archetype name");
+            archetypes.push_back(archetype);
+            continue;
+        }
+
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) return fail("expected 'key = value'");
+        if (archetypes.empty()) return fail("key outside of an [archetype] section");
+
+        std::string key = Trim(line.substr(0, equals));
+        std::string value = Trim(line.substr(equals + 1));
+        EnemyArchetype& archetype = archetypes.back();
+        bool ok = true;
+        if (key == "weight") ok = ParseFloat(value, archetype.weight);
+        else if (key == "health") ok = ParseFloat(value, archetype.health);
+        else if (key == "speed") ok = ParseFloat(value, archetype.speed);
+        else if (key == "health_scaling") ok = ParseFloat(value, archetype.health_scaling);
+        else if (key == "speed_scaling") ok = ParseFloat(value, archetype.speed_scaling);
+        else if (key == "max_speed_multiplier") ok = ParseFloat(value, archetype.max_speed_multiplier);
+        else if (key == "regen_rate") ok = ParseFloat(value, archetype.regen_rate);
+        else if (key == "color") ok = ParseColor(value, archetype.color);
+        else if (key == "flags") ok = ParseFlags(value, archetype.flags);
+        else return fail("unknown key '" + key + "'");
+        if (!ok) return fail("bad value for '" + key + "': " + value);
+    }
+
+    float total_weight = 0.0f;
+    for (const EnemyArchetype& archetype : archetypes) {
+        if (archetype.health <= 0.0f || archetype.speed <= 0.0f || archetype.weight < 0.0f) {
+            std::cerr << source << ": archetype '" << archetype.name << "' needs positive health and speed" << std::endl;
+            return false;
+        }
+        total_weight += archetype.weight;
+    }
+    if (total_weight <= 0.0f) {
+        std::cerr << source << ": no archetype can spawn" << std::endl;
+        return false;
+    }
+
+    archetypes_ = std::move(archetypes);
+    UpdateWeights();
+    std::cout << "Loaded " << archetypes_.size() << " enemy archetypes from " << source << std::endl;
+    return true;
+}
+
+int EnemyArchetypeTable::Find(const std::string& name) const {
+    for (size_t i = 0; i < archetypes_.size(); ++i) {
+        if (archetypes_[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+uint32_t EnemyArchetypeTable::Pick(float roll) const {
+    float target = roll * cumulative_weights_.back();
+    auto it = std::upper_bound(cumulative_weights_.begin(), cumulative_weights_.end(), target);
+    size_t index = std::min(static_cast<size_t>(it - cumulative_weights_.begin()), cumulative_weights_.size() - 1);
+    return static_cast<uint32_t>(index);
+}
+
+void EnemyArchetypeTable::UpdateWeights() {
+    cumulative_weights_.clear();
+    float total = 0.0f;
+    for (const EnemyArchetype& archetype : archetypes_) {
+        total += archetype.weight;
+        cumulative_weights_.push_back(total);
+    }
+}
@@ -0,0 +1,73 @@
+// Enemy archetypes: base stats, difficulty scaling and behaviors, loaded from a data file
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Behavior flags; each combination gets its own compiled update kernel
+enum class EnemyBehavior : uint32_t {
+    None        = 0,
+    Regenerates = 1u << 0,  // Heals regen_rate health per second up to its max
+    Flying      = 1u << 1,  // Flies over turret zones instead of following the flow field
+};
+
+constexpr uint32_t kEnemyBehaviorCount = 2;
+constexpr uint32_t kEnemyBehaviorMask = (1u << kEnemyBehaviorCount) - 1;
+
+constexpr bool HasBehavior(uint32_t flags, EnemyBehavior behavior) {
+    return (flags & static_cast<uint32_t>(behavior)) != 0;
+}
+
+struct EnemyArchetype {
+    std::string name;
+    float weight = 1.0f;                // Relative spawn chance
+    float health = 10.0f;               // Base values, at difficulty 1
+    float speed = 4.5f;
+    float health_scaling = 1.0f;        // Health multiplier gained per point of difficulty
+    float speed_scaling = 0.5f;         // Speed multiplier gained per point of difficulty...
+    float max_speed_multiplier = 1.5f;  // ...up to this cap
+    float regen_rate = 0.0f;            // Health per second (Regenerates)
+    glm::vec3 color = glm::vec3(1.0f, 0.0f, 0.0f);
+    uint32_t flags = 0;                 // EnemyBehavior bits
+
+    float GetHealth(float difficulty) const { return health * (1.0f + (difficulty - 1.0f) * health_scaling); }
+    float GetSpeed(float difficulty) const {
+        return speed * glm::min(max_speed_multiplier, 1.0f + (difficulty - 1.0f) * speed_scaling);
+    }
+};
+
+// Archetypes come from a small text file of sections:
+//
+//   [runner]
+//   weight = 0.3
+//   health = 6
+//   speed = 6
+//   color = 1 1 0
+//   flags = regenerates flying
+//
+// Keys left out keep the EnemyArchetype defaults. Without a file (or if it fails to
+// parse) the table holds the built-in grunt and runner.
+class EnemyArchetypeTable {
+public:
+    EnemyArchetypeTable();
+    ~EnemyArchetypeTable() = default;
+
+    bool LoadFromFile(const std::string& path);
+    bool LoadFromString(const std::string& text, const std::string& source = "<string>");
+    void LoadDefaults();
+
+    size_t GetCount() const { return archetypes_.size(); }
+    const EnemyArchetype& Get(uint32_t index) const { return archetypes_[index]; }
+    int Find(const std::string& name) const; // -1 if there is no such archetype
+
+    // Archetype index for a uniform roll in [0, 1), by weight
+    uint32_t Pick(float roll) const;
+
+private:
+    std::vector<EnemyArchetype> archetypes_;
+    std::vector<float> cumulative_weights_;
+
+    void UpdateWeights();
+};
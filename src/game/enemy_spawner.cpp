@@ -1,22 +1,29 @@
 // Implementation of enemy spawning system
 #include "enemy_spawner.h"
 #include "wave_manager.h"
+#include "flow_field.h"
+#include "utils/debug_draw.h"
 #include <glm/gtc/constants.hpp>
 #include <algorithm>
 #include <iostream>
 
 EnemySpawner::EnemySpawner() :
     wave_manager_(nullptr),
+    sim_clock_(nullptr),
     spawning_enabled_(false),
     spawn_rate_(1.0f),          // 1 enemy per second
     spawn_radius_(25.0f),       // 25 units from center
-    time_since_last_spawn_(0.0f),
+    next_enemy_id_(1),
+    flow_field_(nullptr),
+    flow_field_version_(0),
     gen_(rd_()),
     angle_dist_(0.0f, 2.0f * glm::pi<float>()),
     height_dist_(-spawn_radius_ * 0.5f, spawn_radius_ * 0.5f) {
+    RebuildBuckets();
 }
 
 EnemySpawner::~EnemySpawner() {
+    if (sim_clock_) sim_clock_->Cancel(spawn_timer_);
     enemies_.clear();
 }
 
@@ -25,27 +32,95 @@ bool EnemySpawner::Initialize() {
     std::cout << "Spawn rate: " << spawn_rate_ << " enemies/second" << std::endl;
     std::cout << "Spawn radius: " << spawn_radius_ << " units" << std::endl;
     
+    // Broadphase covers the whole play area; stragglers outside land in the border cells
+    if (!spatial_grid_.Initialize(glm::vec3(-40.0f), glm::vec3(40.0f), 4.0f)) {
+        std::cerr << "Failed to initialize enemy spatial grid!" << std::endl;
+        return false;
+    }
+    spatial_grid_.SetSource([this](std::vector<glm::vec3>& positions) {
+        for (const auto& enemy : enemies_) {
+            positions.push_back(enemy->GetPosition());
+        }
+    });
+    targeting_index_.SetSpatialGrid(&spatial_grid_);
+    
+    if (!separation_system_.Initialize(glm::vec3(-40.0f), glm::vec3(40.0f))) {
+        return false;
+    }
+    separation_system_.SetTargetingIndex(&targeting_index_);
+    status_system_.SetTargetingIndex(&targeting_index_);
+    
+    return true;
+}
+
+bool EnemySpawner::LoadArchetypes(const std::string& path) {
+    if (!archetypes_.LoadFromFile(path)) {
+        return false;
+    }
+    ClearAllEnemies();
+    RebuildBuckets();
     return true;
 }
 
 void EnemySpawner::Update(float delta_time) {
-    // Update spawn timer
-    UpdateSpawnTimer(delta_time);
+    // Free-running spawn timer (the wave manager schedules its own spawns)
+    if (sim_clock_) {
+        for (void* owner : sim_clock_->GetDue(SimTimer::NextSpawn)) {
+            if (owner != this) continue;
+            spawn_timer_ = SimClock::TimerHandle();
+            if (spawning_enabled_) {
+                SpawnEnemy();
+                ScheduleSpawn();
+            }
+        }
+    }
     
-    // Update all enemies
-    for (auto& enemy : enemies_) {
-        if (enemy && enemy->IsAlive()) {
-            enemy->Update(delta_time);
-            
-            // Check if enemy reached core and notify wave manager
-            if (enemy->HasReachedCore() && wave_manager_) {
+    if (sim_clock_) {
+        // Enemies move in closed form, so nothing integrates them per tick and their
+        // arrivals come in as scheduled events. The passes after cleanup still run every
+        // tick (buckets, status, steering, separation); the broadphase over the enemies
+        // is only marked stale and rebuilt by its first query.
+        for (void* owner : sim_clock_->GetDue(SimTimer::EnemyReachCore)) {
+            static_cast<Enemy*>(owner)->OnReachedCore();
+            if (wave_manager_) {
                 wave_manager_->OnEnemyReachedCore();
             }
         }
+    } else {
+        // Update all enemies
+        for (auto& enemy : enemies_) {
+            if (enemy && enemy->IsAlive()) {
+                enemy->Update(delta_time);
+                
+                // Check if enemy reached core and notify wave manager
+                if (enemy->HasReachedCore() && wave_manager_) {
+                    wave_manager_->OnEnemyReachedCore();
+                }
+            }
+        }
     }
     
     // Clean up dead enemies periodically
     CleanupDeadEnemies();
+    
+    SplitSwarm();
+    for (ArchetypeBucket& bucket : buckets_) {
+        (this->*bucket.kernel)(bucket, delta_time);
+    }
+    status_system_.Update(delta_time);
+    SteerEnemies();
+    separation_system_.Update(delta_time, enemies_);
+    InvalidateSpatialGrid();
+}
+
+void EnemySpawner::StartSpawning() {
+    spawning_enabled_ = true;
+    ScheduleSpawn();
+}
+
+void EnemySpawner::StopSpawning() {
+    spawning_enabled_ = false;
+    if (sim_clock_) sim_clock_->Cancel(spawn_timer_);
 }
 
 void EnemySpawner::Render() {
@@ -58,7 +133,7 @@ void EnemySpawner::Render() {
 }
 
 int EnemySpawner::GetAliveEnemyCount() const {
-    int count = 0;
+    int count = static_cast<int>(swarm_.GetMemberCount());
     for (const auto& enemy : enemies_) {
         if (enemy && enemy->IsAlive()) {
             count++;
@@ -72,35 +147,84 @@ void EnemySpawner::SpawnEnemy() {
     
     // Generate spawn position
     glm::vec3 spawn_pos = GenerateSpawnPosition();
+    SwarmTraits traits = RollEnemyTraits();
     
-    // Create new enemy
-    auto enemy = std::make_unique<Enemy>();
-    if (enemy->Initialize(spawn_pos)) {
-        // Get difficulty multiplier from wave manager
-        float difficulty_mult = wave_manager_ ? wave_manager_->GetDifficultyMultiplier() : 1.0f;
-        
-        // 30% chance to be a fast enemy variant
-        static std::uniform_real_distribution<float> chance_dist(0.0f, 1.0f);
-        float roll = chance_dist(gen_);
-        if (roll < 0.3f) {
-            enemy->SetSpeed(6.0f * std::min(1.5f, 1.0f + (difficulty_mult - 1.0f) * 0.5f));  // Speed scales slower than HP
-            enemy->SetHealth(6.0f * difficulty_mult);    // less HP, but scaled by difficulty
-            enemy->SetColor(glm::vec3(1.0f, 1.0f, 0.0f)); // yellow tint
-        } else {
-            // Apply difficulty multiplier to normal enemies
-            float base_health = enemy->GetHealth(); // Get initial health from Enemy::Initialize
-            float base_speed = enemy->GetSpeed();
-            enemy->SetHealth(base_health * difficulty_mult);
-            enemy->SetSpeed(base_speed * std::min(1.5f, 1.0f + (difficulty_mult - 1.0f) * 0.5f));  // Speed scales slower (max 1.5x)
-        }
-        enemies_.push_back(std::move(enemy));
-        std::cout << "Spawned enemy #" << enemies_.size() << " at distance " 
-                  << glm::length(spawn_pos) << " from center" << std::endl;
+    // Out of every turret's reach: join a swarm group instead of becoming an entity
+    if (sim_clock_ && swarm_.ShouldGroup(spawn_pos)) {
+        swarm_.AddMember(spawn_pos, sim_clock_->GetTime(), traits);
+        return;
+    }
+    
+    CreateEnemy(spawn_pos, traits);
+}
+
+SwarmTraits EnemySpawner::RollEnemyTraits() {
+    // Get difficulty multiplier from wave manager
+    float difficulty_mult = wave_manager_ ? wave_manager_->GetDifficultyMultiplier() : 1.0f;
+    
+    static std::uniform_real_distribution<float> chance_dist(0.0f, 1.0f);
+    uint32_t index = archetypes_.Pick(chance_dist(gen_));
+    const EnemyArchetype& archetype = archetypes_.Get(index);
+    return {index, archetype.GetSpeed(difficulty_mult), archetype.GetHealth(difficulty_mult), archetype.color};
+}
+
+void EnemySpawner::CreateEnemy(const glm::vec3& position, const SwarmTraits& traits) {
+    auto enemy = std::make_unique<Enemy>(next_enemy_id_++);
+    enemy->SetSimClock(sim_clock_);
+    if (!enemy->Initialize(position)) return;
+    
+    enemy->SetSpeed(traits.speed);
+    enemy->SetMaxHealth(traits.health);
+    enemy->SetHealth(traits.health);
+    enemy->SetColor(traits.color);
+    
+    ArchetypeBucket& bucket = buckets_[traits.archetype];
+    bucket.enemies.push_back(enemy.get());
+    
+    double now = sim_clock_ ? sim_clock_->GetTime() : 0.0;
+    targeting_index_.Insert(enemy.get(), now + enemy->GetTimeToReachCore());
+    bool flying = HasBehavior(bucket.flags, EnemyBehavior::Flying);
+    if (flow_field_ && !flying && !flow_field_->IsDirect(flow_field_->GetCellIndex(position))) {
+        steering_.push_back({enemy.get(), -1, -1.0f, now});
+    }
+    enemies_.push_back(std::move(enemy));  // Ids only grow, so the list stays id-ordered
+    spatial_grid_.Invalidate();
+    std::cout << "Spawned enemy #" << enemies_.size() << " at distance " 
+              << glm::length(position) << " from center" << std::endl;
+}
+
+void EnemySpawner::SplitSwarm() {
+    if (!sim_clock_ || swarm_.GetMemberCount() == 0) return;
+    
+    swarm_splits_.clear();
+    swarm_.CollectSplits(sim_clock_->GetTime(), swarm_splits_);
+    for (const SwarmSplit& split : swarm_splits_) {
+        CreateEnemy(split.position, split.traits);
     }
 }
 
 void EnemySpawner::CleanupDeadEnemies() {
-    // Remove dead enemies
+    status_system_.RemoveDead();
+    steering_.erase(
+        std::remove_if(steering_.begin(), steering_.end(),
+            [](const SteeringEntry& entry) { return !entry.enemy->IsAlive(); }),
+        steering_.end()
+    );
+    for (ArchetypeBucket& bucket : buckets_) {
+        bucket.enemies.erase(
+            std::remove_if(bucket.enemies.begin(), bucket.enemies.end(),
+                [](const Enemy* enemy) { return !enemy->IsAlive(); }),
+            bucket.enemies.end()
+        );
+    }
+    
+    for (const auto& enemy : enemies_) {
+        if (enemy && !enemy->IsAlive()) {
+            targeting_index_.Remove(enemy->GetID());
+        }
+    }
+    
+    // Remove dead enemies (stable, so enemies_ stays ordered by id)
     enemies_.erase(
         std::remove_if(enemies_.begin(), enemies_.end(),
             [](const std::unique_ptr<Enemy>& enemy) {
@@ -108,10 +232,95 @@ void EnemySpawner::CleanupDeadEnemies() {
             }),
         enemies_.end()
     );
+    spatial_grid_.Invalidate();
 }
 
 void EnemySpawner::ClearAllEnemies() {
+    targeting_index_.Clear();
+    steering_.clear();
+    status_system_.Clear();
+    swarm_.Clear();
+    for (ArchetypeBucket& bucket : buckets_) {
+        bucket.enemies.clear();
+    }
     enemies_.clear();
+    InvalidateSpatialGrid();
+}
+
+void EnemySpawner::SteerEnemies() {
+    if (!flow_field_) return;
+    double now = sim_clock_ ? sim_clock_->GetTime() : 0.0;
+    
+    // A placed or removed turret can put any enemy on or off a direct course
+    if (flow_field_->GetVersion() != flow_field_version_) {
+        flow_field_version_ = flow_field_->GetVersion();
+        steering_.clear();
+        for (const ArchetypeBucket& bucket : buckets_) {
+            if (HasBehavior(bucket.flags, EnemyBehavior::Flying)) continue;
+            for (Enemy* enemy : bucket.enemies) {
+                if (!enemy->IsAlive()) continue;
+                if (!flow_field_->IsDirect(flow_field_->GetCellIndex(enemy->GetTrackPosition()))) {
+                    steering_.push_back({enemy, -1, -1.0f, now});
+                } else if (enemy->HasWaypoint()) {
+                    enemy->ClearWaypoint();
+                    targeting_index_.UpdateMotion(*enemy, enemy->GetArrivalTime());
+                }
+            }
+        }
+    }
+    
+    // One cell lookup per steered enemy; motion only changes when it enters a new cell,
+    // and the arrival estimate also when a status effect changes its speed
+    size_t kept = 0;
+    for (size_t i = 0; i < steering_.size(); ++i) {
+        SteeringEntry entry = steering_[i];
+        Enemy* enemy = entry.enemy;
+        if (!enemy->IsAlive()) continue;
+        
+        // The track, not the separated position, is what reaches the waypoint
+        glm::vec3 position = enemy->GetTrackPosition();
+        int cell = flow_field_->GetCellIndex(position);
+        if (flow_field_->IsDirect(cell)) {
+            // Clear line to the core: back to closed-form flight and a scheduled arrival
+            enemy->ClearWaypoint();
+            targeting_index_.UpdateMotion(*enemy, enemy->GetArrivalTime());
+            continue;
+        }
+        
+        bool new_cell = cell != entry.cell;
+        if (new_cell) {
+            entry.cell = cell;
+            enemy->SetWaypoint(flow_field_->GetWaypoint(cell));
+        }
+        if (new_cell || enemy->GetCurrentSpeed() != entry.speed) {
+            // A stunned enemy gets an infinite estimate: it isn't getting any closer
+            entry.speed = enemy->GetCurrentSpeed();
+            entry.arrival = enemy->GetArrivalEstimate();
+        }
+        targeting_index_.UpdateMotion(*enemy, entry.arrival);
+        steering_[kept++] = entry;
+    }
+    steering_.resize(kept);
+}
+
+void EnemySpawner::InvalidateSpatialGrid() {
+    spatial_grid_.Invalidate();
+    
+#ifdef CORE_DEBUG_DRAW
+    if (DebugDraw::IsEnabled(DebugCategory::SpatialGrid)) {
+        // Occupied cells (drawing them forces the build), from blue to red as they fill up, labelled with their count
+        for (size_t cell = 0; cell < spatial_grid_.GetCellCount(); ++cell) {
+            uint32_t count = spatial_grid_.GetCellOccupancy(cell);
+            if (count == 0) continue;
+            glm::vec3 min_corner, max_corner;
+            spatial_grid_.GetCellBounds(cell, min_corner, max_corner);
+            float fill = std::min(1.0f, static_cast<float>(count) / 8.0f);
+            glm::vec3 color = glm::mix(glm::vec3(0.2f, 0.4f, 1.0f), glm::vec3(1.0f, 0.2f, 0.2f), fill);
+            DebugDraw::Box(DebugCategory::SpatialGrid, min_corner, max_corner, color);
+            DebugDraw::Label(DebugCategory::SpatialGrid, (min_corner + max_corner) * 0.5f, std::to_string(count), color);
+        }
+    }
+#endif
 }
 
 glm::vec3 EnemySpawner::GenerateSpawnPosition() {
@@ -121,9 +330,15 @@ glm::vec3 EnemySpawner::GenerateSpawnPosition() {
     // Generate random height (Z coordinate)
     float height = height_dist_(gen_);
     
+    // With swarm LOD the circle moves out past the turrets' reach, so spawns start grouped
+    float radius = spawn_radius_;
+    if (swarm_.IsEnabled()) {
+        radius = std::max(radius, swarm_.GetSplitRadius() + SwarmLod::kSpawnLead);
+    }
+    
     // Calculate X and Y coordinates on the circle
-    float x = spawn_radius_ * glm::cos(angle);
-    float y = spawn_radius_ * glm::sin(angle);
+    float x = radius * glm::cos(angle);
+    float y = radius * glm::sin(angle);
     
     glm::vec3 spawn_pos(x, y, height);
     
@@ -133,16 +348,43 @@ glm::vec3 EnemySpawner::GenerateSpawnPosition() {
     return spawn_pos;
 }
 
-void EnemySpawner::UpdateSpawnTimer(float delta_time) {
-    if (!spawning_enabled_) return;
-    
-    time_since_last_spawn_ += delta_time;
+void EnemySpawner::ScheduleSpawn() {
+    if (!sim_clock_ || spawn_rate_ <= 0.0f) return;
     
-    // Check if it's time to spawn
-    float spawn_interval = 1.0f / spawn_rate_;
-    if (time_since_last_spawn_ >= spawn_interval) {
-        SpawnEnemy();
-        time_since_last_spawn_ = 0.0f;
+    sim_clock_->Cancel(spawn_timer_);
+    spawn_timer_ = sim_clock_->Schedule(SimTimer::NextSpawn, 1.0f / spawn_rate_, this);
+}
+
+void EnemySpawner::RebuildBuckets() {
+    buckets_.clear();
+    for (uint32_t i = 0; i < archetypes_.GetCount(); ++i) {
+        const EnemyArchetype& archetype = archetypes_.Get(i);
+        buckets_.push_back({archetype.flags, archetype.regen_rate, GetBucketKernel(archetype.flags), {}});
     }
 }
 
+template <uint32_t Flags>
+void EnemySpawner::UpdateBucket(ArchetypeBucket& bucket, float delta_time) {
+    if constexpr (HasBehavior(Flags, EnemyBehavior::Regenerates)) {
+        float heal = bucket.regen_rate * delta_time;
+        for (Enemy* enemy : bucket.enemies) {
+            float health = enemy->GetHealth();
+            if (!enemy->IsAlive() || health >= enemy->GetMaxHealth()) continue;
+            enemy->SetHealth(std::min(enemy->GetMaxHealth(), health + heal));
+            targeting_index_.UpdateHealth(*enemy);
+        }
+    }
+    // Flying needs no per-tick work: those buckets are simply never steered
+}
+
+EnemySpawner::BucketKernel EnemySpawner::GetBucketKernel(uint32_t flags) {
+    // One instantiation per flag combination
+    static const BucketKernel kernels[] = {
+        &EnemySpawner::UpdateBucket<0>,
+        &EnemySpawner::UpdateBucket<1>,
+        &EnemySpawner::UpdateBucket<2>,
+        &EnemySpawner::UpdateBucket<3>,
+    };
+    static_assert(sizeof(kernels) / sizeof(kernels[0]) == kEnemyBehaviorMask + 1, "one kernel per flag combination");
+    return kernels[flags & kEnemyBehaviorMask];
+}
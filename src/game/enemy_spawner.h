@@ -2,12 +2,21 @@
 #pragma once
 
 #include "enemy.h"
+#include "sim_clock.h"
+#include "spatial_grid.h"
+#include "targeting_index.h"
+#include "separation_system.h"
+#include "swarm_lod.h"
+#include "enemy_archetype.h"
+#include "status_system.h"
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 #include <random>
+#include <string>
 
 class WaveManager;
+class FlowField;
 
 class EnemySpawner {
 public:
@@ -24,18 +33,43 @@ public:
     void Render();
 
     // Spawn controls
-    void StartSpawning() { spawning_enabled_ = true; }
-    void StopSpawning() { spawning_enabled_ = false; }
+    void StartSpawning();
+    void StopSpawning();
     void SetSpawnRate(float rate) { spawn_rate_ = rate; }
     void SetSpawnRadius(float radius) { spawn_radius_ = radius; }
 
+    // Archetype table (built-in defaults until a file loads); loading clears all enemies
+    bool LoadArchetypes(const std::string& path);
+    const EnemyArchetypeTable& GetArchetypes() const { return archetypes_; }
+
     // Wave manager integration
     void SetWaveManager(WaveManager* wave_manager) { wave_manager_ = wave_manager; }
 
-    // Enemy management
+    // Simulation clock used for the free-running spawn timer
+    void SetSimClock(SimClock* sim_clock) { sim_clock_ = sim_clock; }
+
+    // Navigation around turret zones; enemies off a direct course follow the field
+    void SetFlowField(const FlowField* flow_field) { flow_field_ = flow_field; }
+    size_t GetSteeredEnemyCount() const { return steering_.size(); }
+
+    // Crowd spacing pass run every tick (radius, neighbor cap, per-tick agent budget)
+    void SetSeparationSettings(const SeparationSettings& settings) { separation_system_.SetSettings(settings); }
+    const SeparationSystem& GetSeparationSystem() const { return separation_system_; }
+
+    // Slow, burn and stun on enemies; ticked in Update, dead enemies dropped on cleanup
+    StatusSystem& GetStatusSystem() { return status_system_; }
+
+    // Far spawns travel as swarm groups until they near the turrets' reach (set every
+    // tick); off by default. When on, the spawn radius is raised to sit past that reach.
+    void SetEngagementRadius(float radius) { swarm_.SetEngagementRadius(radius); }
+    void SetSwarmLodEnabled(bool enabled) { swarm_.SetEnabled(enabled); }
+    const SwarmLod& GetSwarm() const { return swarm_; }
+
+    // Enemy management. The list is ordered by id: enemies are only appended with
+    // increasing ids and cleanup removes stably (DamageSystem joins on that order).
     const std::vector<std::unique_ptr<Enemy>>& GetEnemies() const { return enemies_; }
     int GetEnemyCount() const { return static_cast<int>(enemies_.size()); }
-    int GetAliveEnemyCount() const;
+    int GetAliveEnemyCount() const; // Includes enemies still grouped in the swarm
     void ClearAllEnemies();
 
     // Spawn a single enemy
@@ -44,15 +78,62 @@ public:
     // Clean up dead enemies
     void CleanupDeadEnemies();
 
+    // Broadphase over the current enemy positions; indices match GetEnemies().
+    // Marked stale whenever enemies move or the list changes, and rebuilt by the
+    // first query after that, so ticks without grid queries skip the build.
+    const SpatialGrid& GetSpatialGrid() const { return spatial_grid_; }
+
+    // Priority sets for turret targeting; enemies enter on spawn and leave on cleanup
+    TargetingIndex& GetTargetingIndex() { return targeting_index_; }
+    const TargetingIndex& GetTargetingIndex() const { return targeting_index_; }
+
 private:
     std::vector<std::unique_ptr<Enemy>> enemies_;
     WaveManager* wave_manager_;
+    SimClock* sim_clock_;
     
     // Spawn parameters
     bool spawning_enabled_;
     float spawn_rate_;          // Enemies per second
-    float spawn_radius_;        // Distance from center to spawn enemies
-    float time_since_last_spawn_;
+    float spawn_radius_;        // Distance from center to spawn enemies (a minimum with swarm LOD)
+    SimClock::TimerHandle spawn_timer_;
+    uint32_t next_enemy_id_;    // Ids start at 1; 0 means "no enemy"
+    
+    // Broadphase
+    SpatialGrid spatial_grid_;
+    TargetingIndex targeting_index_;
+    
+    // Flow-field steering
+    struct SteeringEntry {
+        Enemy* enemy;
+        int cell;           // Field cell the current waypoint was chosen in (-1: none yet)
+        float speed;        // Current speed the arrival estimate was made at
+        double arrival;     // Arrival estimate handed to the targeting index
+    };
+    const FlowField* flow_field_;
+    uint32_t flow_field_version_;
+    std::vector<SteeringEntry> steering_;
+    
+    SeparationSystem separation_system_;
+    StatusSystem status_system_;
+    
+    // Swarm LOD
+    SwarmLod swarm_;
+    std::vector<SwarmSplit> swarm_splits_;
+    
+    // Enemies bucketed by archetype (enemies_ stays the id-ordered owner). Each bucket
+    // runs the kernel compiled for its behavior flags, so nothing branches on type per
+    // enemy and archetypes without per-tick behavior cost one empty call per tick.
+    struct ArchetypeBucket;
+    using BucketKernel = void (EnemySpawner::*)(ArchetypeBucket& bucket, float delta_time);
+    struct ArchetypeBucket {
+        uint32_t flags;
+        float regen_rate;
+        BucketKernel kernel;
+        std::vector<Enemy*> enemies;
+    };
+    EnemyArchetypeTable archetypes_;
+    std::vector<ArchetypeBucket> buckets_;
     
     // Random number generation
     std::random_device rd_;
@@ -63,7 +144,26 @@ private:
     // Generate random spawn position on sphere
     glm::vec3 GenerateSpawnPosition();
     
+    // Roll an archetype by weight and scale it by the wave difficulty
+    SwarmTraits RollEnemyTraits();
+    void CreateEnemy(const glm::vec3& position, const SwarmTraits& traits);
+    
+    // Turn swarm members that reached the split radius into enemies
+    void SplitSwarm();
+    
     // Spawn timer
-    void UpdateSpawnTimer(float delta_time);
+    void ScheduleSpawn();
+    
+    // One bucket per archetype, with the kernel for its flags
+    void RebuildBuckets();
+    static BucketKernel GetBucketKernel(uint32_t flags);
+    template <uint32_t Flags>
+    void UpdateBucket(ArchetypeBucket& bucket, float delta_time);
+    
+    // Pick up layout changes and hand steered enemies their next waypoint
+    void SteerEnemies();
+    
+    // Mark the broadphase stale (and draw it when its debug view is on)
+    void InvalidateSpatialGrid();
 };
 
@@ -0,0 +1,322 @@
+// Implementation of the incrementally repaired flow field
+#include "flow_field.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace {
+    const float kInfinity = std::numeric_limits<float>::infinity();
+
+    // Min-heap on cost for std::push_heap/pop_heap
+    bool HeapOrder(const std::pair<float, int32_t>& a, const std::pair<float, int32_t>& b) {
+        return a.first > b.first;
+    }
+}
+
+FlowField::FlowField()
+    : min_bounds_(0.0f)
+    , cell_size_(1.0f)
+    , dims_(0)
+    , goal_(0.0f)
+    , goal_cell_(0)
+    , version_(0)
+    , last_repair_count_(0) {
+}
+
+bool FlowField::Initialize(const glm::vec3& min_bounds, const glm::vec3& max_bounds, float cell_size, const glm::vec3& goal) {
+    if (cell_size <= 0.0f || glm::any(glm::lessThanEqual(max_bounds, min_bounds))) {
+        std::cerr << "Invalid flow field bounds" << std::endl;
+        return false;
+    }
+
+    min_bounds_ = min_bounds;
+    cell_size_ = cell_size;
+    dims_ = glm::max(glm::ivec3(glm::ceil((max_bounds - min_bounds) / cell_size)), glm::ivec3(1));
+    goal_ = goal;
+
+    size_t cell_count = static_cast<size_t>(dims_.x) * dims_.y * dims_.z;
+    cost_.assign(cell_count, kInfinity);
+    next_.assign(cell_count, -1);
+    zone_count_.assign(cell_count, 0);
+    direct_.assign(cell_count, 1);
+    affected_.assign(cell_count, 0);
+    zones_.clear();
+    goal_cell_ = GetCellIndex(goal);
+
+    neighbor_steps_.clear();
+    neighbor_lengths_.clear();
+    for (int z = -1; z <= 1; ++z) {
+        for (int y = -1; y <= 1; ++y) {
+            for (int x = -1; x <= 1; ++x) {
+                if (x == 0 && y == 0 && z == 0) continue;
+                neighbor_steps_.push_back(glm::ivec3(x, y, z));
+                neighbor_lengths_.push_back(cell_size * glm::length(glm::vec3(x, y, z)));
+            }
+        }
+    }
+
+    RebuildAll();
+    std::cout << "Flow field: " << dims_.x << "x" << dims_.y << "x" << dims_.z << " cells" << std::endl;
+    return true;
+}
+
+void FlowField::AddZone(const glm::vec3& center, float radius) {
+    Zone zone = {center, radius};
+    zones_.push_back(zone);
+    ApplyZone(zone, 1);
+    Repair();
+    UpdateDirect(zone, true);
+    version_++;
+}
+
+void FlowField::RemoveZone(const glm::vec3& center, float radius) {
+    auto it = std::find_if(zones_.begin(), zones_.end(), [&](const Zone& zone) {
+        return zone.radius == radius && glm::length(zone.center - center) < 1e-3f;
+    });
+    if (it == zones_.end()) return;
+
+    Zone zone = *it;
+    zones_.erase(it);
+    ApplyZone(zone, -1);
+    Repair();
+    UpdateDirect(zone, false);
+    version_++;
+}
+
+void FlowField::ClearZones() {
+    if (zones_.empty()) return;
+
+    zones_.clear();
+    std::fill(zone_count_.begin(), zone_count_.end(), 0);
+    RebuildAll();
+    version_++;
+}
+
+int FlowField::GetCellIndex(const glm::vec3& position) const {
+    glm::ivec3 coords(glm::floor((position - min_bounds_) / cell_size_));
+    return GetCell(glm::clamp(coords, glm::ivec3(0), dims_ - 1));
+}
+
+glm::vec3 FlowField::GetCellCenter(int cell) const {
+    return min_bounds_ + (glm::vec3(GetCoords(cell)) + 0.5f) * cell_size_;
+}
+
+glm::vec3 FlowField::GetWaypoint(int cell) const {
+    int next = next_[cell];
+    if (next < 0 || next == goal_cell_) return goal_;
+    return GetCellCenter(next);
+}
+
+void FlowField::ApplyZone(const Zone& zone, int delta) {
+    // Cells whose center lies inside the zone
+    glm::ivec3 low = glm::max(glm::ivec3(glm::floor((zone.center - zone.radius - min_bounds_) / cell_size_)), glm::ivec3(0));
+    glm::ivec3 high = glm::min(glm::ivec3(glm::floor((zone.center + zone.radius - min_bounds_) / cell_size_)), dims_ - 1);
+    float radius_sq = zone.radius * zone.radius;
+
+    for (int z = low.z; z <= high.z; ++z) {
+        for (int y = low.y; y <= high.y; ++y) {
+            for (int x = low.x; x <= high.x; ++x) {
+                int cell = GetCell(glm::ivec3(x, y, z));
+                glm::vec3 offset = GetCellCenter(cell) - zone.center;
+                if (glm::dot(offset, offset) > radius_sq) continue;
+
+                zone_count_[cell] = static_cast<uint16_t>(zone_count_[cell] + delta);
+                changed_cells_.push_back(cell);
+            }
+        }
+    }
+}
+
+void FlowField::Repair() {
+    // Cells whose path ran through a changed cell: the subtrees hanging off them
+    affected_cells_.clear();
+    for (int32_t cell : changed_cells_) {
+        if (cell == goal_cell_ || affected_[cell]) continue;
+        affected_[cell] = 1;
+        affected_cells_.push_back(cell);
+    }
+    changed_cells_.clear();
+
+    for (size_t i = 0; i < affected_cells_.size(); ++i) {
+        int32_t cell = affected_cells_[i];
+        glm::ivec3 coords = GetCoords(cell);
+        for (const glm::ivec3& step : neighbor_steps_) {
+            glm::ivec3 neighbor_coords = coords + step;
+            if (!IsInside(neighbor_coords)) continue;
+            int neighbor = GetCell(neighbor_coords);
+            if (next_[neighbor] != cell || affected_[neighbor]) continue;
+            affected_[neighbor] = 1;
+            affected_cells_.push_back(neighbor);
+        }
+    }
+
+    for (int32_t cell : affected_cells_) {
+        cost_[cell] = kInfinity;
+        next_[cell] = -1;
+    }
+
+    // Re-seed from the intact part of the field
+    heap_.clear();
+    for (int32_t cell : affected_cells_) {
+        glm::ivec3 coords = GetCoords(cell);
+        float penalty = GetPenalty(cell);
+        for (size_t i = 0; i < neighbor_steps_.size(); ++i) {
+            glm::ivec3 neighbor_coords = coords + neighbor_steps_[i];
+            if (!IsInside(neighbor_coords)) continue;
+            int neighbor = GetCell(neighbor_coords);
+            if (affected_[neighbor] || cost_[neighbor] == kInfinity) continue;
+
+            float cost = cost_[neighbor] + neighbor_lengths_[i] * 0.5f * (penalty + GetPenalty(neighbor));
+            if (cost < cost_[cell]) {
+                cost_[cell] = cost;
+                next_[cell] = neighbor;
+            }
+        }
+        if (cost_[cell] != kInfinity) PushHeap(cost_[cell], cell);
+    }
+
+    for (int32_t cell : affected_cells_) {
+        affected_[cell] = 0;
+    }
+
+    // Re-labelled cells relax their neighbors, which also carries cost decreases
+    // (a removed zone) out past the affected set
+    Propagate();
+}
+
+void FlowField::RebuildAll() {
+    std::fill(cost_.begin(), cost_.end(), kInfinity);
+    std::fill(next_.begin(), next_.end(), -1);
+    changed_cells_.clear();
+
+    heap_.clear();
+    cost_[goal_cell_] = 0.0f;
+    PushHeap(0.0f, goal_cell_);
+    Propagate();
+
+    for (size_t cell = 0; cell < direct_.size(); ++cell) {
+        direct_[cell] = IsLineClear(GetCellCenter(static_cast<int>(cell))) ? 1 : 0;
+    }
+}
+
+void FlowField::Propagate() {
+    // Dijkstra with lazy deletion; edge cost is length times the mean penalty of both ends
+    size_t settled = 0;
+    while (!heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), HeapOrder);
+        std::pair<float, int32_t> top = heap_.back();
+        heap_.pop_back();
+
+        int32_t cell = top.second;
+        if (top.first > cost_[cell]) continue;
+        settled++;
+
+        glm::ivec3 coords = GetCoords(cell);
+        float penalty = GetPenalty(cell);
+        for (size_t i = 0; i < neighbor_steps_.size(); ++i) {
+            glm::ivec3 neighbor_coords = coords + neighbor_steps_[i];
+            if (!IsInside(neighbor_coords)) continue;
+            int neighbor = GetCell(neighbor_coords);
+
+            float cost = top.first + neighbor_lengths_[i] * 0.5f * (penalty + GetPenalty(neighbor));
+            if (cost < cost_[neighbor]) {
+                cost_[neighbor] = cost;
+                next_[neighbor] = cell;
+                PushHeap(cost, neighbor);
+            }
+        }
+    }
+    last_repair_count_ = settled;
+}
+
+void FlowField::UpdateDirect(const Zone& zone, bool added) {
+    // Only cells that can flip are tested: a new zone can only block direct cells, a
+    // removed one can only free blocked cells whose line passed it. Those cells all lie
+    // in the zone's shadow, so only the box around it is scanned.
+    glm::ivec3 low, high;
+    if (!GetShadowBounds(zone, low, high)) return;
+
+    for (int z = low.z; z <= high.z; ++z) {
+        for (int y = low.y; y <= high.y; ++y) {
+            for (int x = low.x; x <= high.x; ++x) {
+                int cell = GetCell(glm::ivec3(x, y, z));
+                if ((direct_[cell] != 0) != added) continue;
+                glm::vec3 start = GetCellCenter(cell);
+                if (!TouchesZone(start, zone)) continue;
+                direct_[cell] = (!added && IsLineClear(start)) ? 1 : 0;
+            }
+        }
+    }
+}
+
+bool FlowField::GetShadowBounds(const Zone& zone, glm::ivec3& low, glm::ivec3& high) const {
+    low = glm::ivec3(0);
+    high = dims_ - 1;
+
+    // A zone over the goal shadows everything
+    float reach = zone.radius + cell_size_ * 0.87f;
+    glm::vec3 axis = zone.center - goal_;
+    float distance = glm::length(axis);
+    if (distance <= reach) return true;
+    axis /= distance;
+
+    // A line from the goal that passes the grown zone stays inside the cone tangent to
+    // it, and ends no closer to the goal (along the axis) than the zone's near side. The
+    // cone between there and the far end of the grid is bounded by its two end disks.
+    float sin_angle = reach / distance;
+    float tan_angle = sin_angle / glm::sqrt(1.0f - sin_angle * sin_angle);
+    glm::vec3 max_bounds = min_bounds_ + glm::vec3(dims_) * cell_size_;
+    float near_t = distance - reach;
+    float far_t = near_t;
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 point((corner & 1) ? max_bounds.x : min_bounds_.x,
+                        (corner & 2) ? max_bounds.y : min_bounds_.y,
+                        (corner & 4) ? max_bounds.z : min_bounds_.z);
+        far_t = glm::max(far_t, glm::dot(point - goal_, axis));
+    }
+
+    glm::vec3 disk_extent = glm::sqrt(glm::max(glm::vec3(1.0f) - axis * axis, glm::vec3(0.0f)));
+    glm::vec3 near_center = goal_ + axis * near_t;
+    glm::vec3 far_center = goal_ + axis * far_t;
+    glm::vec3 box_min = glm::min(near_center - disk_extent * (near_t * tan_angle), far_center - disk_extent * (far_t * tan_angle));
+    glm::vec3 box_max = glm::max(near_center + disk_extent * (near_t * tan_angle), far_center + disk_extent * (far_t * tan_angle));
+
+    low = glm::max(glm::ivec3(glm::floor((box_min - min_bounds_) / cell_size_)), glm::ivec3(0));
+    high = glm::min(glm::ivec3(glm::floor((box_max - min_bounds_) / cell_size_)), dims_ - 1);
+    return glm::all(glm::lessThanEqual(low, high));
+}
+
+bool FlowField::IsLineClear(const glm::vec3& start) const {
+    for (const Zone& zone : zones_) {
+        if (TouchesZone(start, zone)) return false;
+    }
+    return true;
+}
+
+bool FlowField::TouchesZone(const glm::vec3& start, const Zone& zone) const {
+    // Segment from the cell center to the goal against the zone grown by half a cell
+    // diagonal, so any point of the cell flying straight at the goal stays clear
+    glm::vec3 segment = goal_ - start;
+    float length_sq = glm::dot(segment, segment);
+    float t = length_sq > 0.0f ? glm::clamp(glm::dot(zone.center - start, segment) / length_sq, 0.0f, 1.0f) : 0.0f;
+    glm::vec3 offset = start + segment * t - zone.center;
+    float reach = zone.radius + cell_size_ * 0.87f;
+    return glm::dot(offset, offset) < reach * reach;
+}
+
+bool FlowField::IsInside(const glm::ivec3& coords) const {
+    return coords.x >= 0 && coords.y >= 0 && coords.z >= 0 &&
+           coords.x < dims_.x && coords.y < dims_.y && coords.z < dims_.z;
+}
+
+glm::ivec3 FlowField::GetCoords(int cell) const {
+    int x = cell % dims_.x;
+    int y = (cell / dims_.x) % dims_.y;
+    int z = cell / (dims_.x * dims_.y);
+    return glm::ivec3(x, y, z);
+}
+
+void FlowField::PushHeap(float cost, int32_t cell) {
+    heap_.push_back({cost, cell});
+    std::push_heap(heap_.begin(), heap_.end(), HeapOrder);
+}
@@ -0,0 +1,89 @@
+// Flow field toward the core over a 3D grid, weighted by turret exclusion zones
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+// Every cell stores its cost-to-go and the neighbor (26-connected) one step closer to
+// the goal, so an enemy steers with one cell lookup. Cells inside exclusion zones cost
+// more to cross but stay passable, so a path always exists. Adding or removing a zone
+// repairs the field incrementally: only cells whose shortest path ran through the
+// changed cells are re-labelled, and improvements propagate outward from them.
+//
+// A cell is "direct" when the straight line from its center to the goal passes clear of
+// every zone (or the cell borders the goal); enemies there fly straight in closed form
+// and need no steering. A zone change only re-tests cells in the zone's shadow as seen
+// from the goal.
+class FlowField {
+public:
+    static constexpr float kZonePenalty = 8.0f;  // Extra cost factor per overlapping zone
+
+    FlowField();
+    ~FlowField() = default;
+
+    bool Initialize(const glm::vec3& min_bounds, const glm::vec3& max_bounds, float cell_size, const glm::vec3& goal);
+
+    // Exclusion zones (turrets); each change repairs the field
+    void AddZone(const glm::vec3& center, float radius);
+    void RemoveZone(const glm::vec3& center, float radius);
+    void ClearZones();
+
+    // Positions outside the bounds map to the border cells
+    int GetCellIndex(const glm::vec3& position) const;
+    glm::vec3 GetCellCenter(int cell) const;
+    bool IsDirect(int cell) const { return direct_[cell] != 0 || cell == goal_cell_ || next_[cell] == goal_cell_; }
+    glm::vec3 GetWaypoint(int cell) const;   // Center of the next cell toward the goal
+    float GetPathCost(int cell) const { return cost_[cell]; }
+
+    // Bumped on every layout change, so steering can re-check enemies
+    uint32_t GetVersion() const { return version_; }
+    size_t GetCellCount() const { return cost_.size(); }
+    size_t GetLastRepairCount() const { return last_repair_count_; } // Cells re-labelled by the last change
+
+private:
+    glm::vec3 min_bounds_;
+    float cell_size_;
+    glm::ivec3 dims_;
+    glm::vec3 goal_;
+    int goal_cell_;
+
+    std::vector<float> cost_;           // Weighted path length to the goal
+    std::vector<int32_t> next_;         // Next cell toward the goal (-1 at the goal)
+    std::vector<uint16_t> zone_count_;  // Zones covering each cell
+    std::vector<uint8_t> direct_;
+    uint32_t version_;
+    size_t last_repair_count_;
+
+    struct Zone {
+        glm::vec3 center;
+        float radius;
+    };
+    std::vector<Zone> zones_;
+
+    // 26-connected neighborhood
+    std::vector<glm::ivec3> neighbor_steps_;
+    std::vector<float> neighbor_lengths_;
+
+    // Scratch for repairs
+    std::vector<int32_t> changed_cells_;
+    std::vector<int32_t> affected_cells_;
+    std::vector<uint8_t> affected_;
+    std::vector<std::pair<float, int32_t>> heap_;
+
+    void ApplyZone(const Zone& zone, int delta);
+    void Repair();
+    void RebuildAll();
+    void Propagate();
+    void UpdateDirect(const Zone& zone, bool added);
+    // Cell box around every cell whose line to the goal can pass `zone`; false if empty
+    bool GetShadowBounds(const Zone& zone, glm::ivec3& low, glm::ivec3& high) const;
+    bool IsLineClear(const glm::vec3& start) const;
+    bool TouchesZone(const glm::vec3& start, const Zone& zone) const;
+
+    float GetPenalty(int cell) const { return 1.0f + kZonePenalty * zone_count_[cell]; }
+    bool IsInside(const glm::ivec3& coords) const;
+    glm::ivec3 GetCoords(int cell) const;
+    int GetCell(const glm::ivec3& coords) const { return coords.x + dims_.x * (coords.y + dims_.y * coords.z); }
+    void PushHeap(float cost, int32_t cell);
+};
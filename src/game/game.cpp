@@ -4,6 +4,9 @@
 #include "core/input.h"
 #include "graphics/shader.h"
 #include "graphics/mesh.h"
+#include "graphics/geometry_registry.h"
+#include "graphics/render_queue.h"
+#include "graphics/scene_framebuffer.h"
 #include "graphics/camera.h"
 #include "core/time.h"
 #include "enemy_spawner.h"
@@ -17,9 +20,17 @@
 #include "ui_manager.h"
 #include "item_manager.h"
 #include "item.h"
+#include "sim_clock.h"
+#include "collision_system.h"
+#include "damage_system.h"
+#include "flow_field.h"
+#include "status_system.h"
+#include "utils/debug_draw.h"
+#include "utils/metrics.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <GLFW/glfw3.h>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 
@@ -55,7 +66,8 @@ bool Game::Initialize(Renderer* renderer, InputManager* input) {
     camera_ = std::make_unique<Camera>();
     
     // Initialize shader
-    shader_ = std::make_unique<Shader>();
+    world_shader_ = std::make_unique<Shader>();
+    health_bar_shader_ = std::make_unique<Shader>();
     // Пробуем разные пути к шейдерам
     std::vector<std::string> shader_paths = {
         "assets/shaders/",
@@ -66,9 +78,10 @@ bool Game::Initialize(Renderer* renderer, InputManager* input) {
     
     bool shader_loaded = false;
     for (const auto& path : shader_paths) {
-        std::string vert_path = path + "basic.vert";
-        std::string frag_path = path + "basic.frag";
-        if (shader_->LoadFromFiles(vert_path, frag_path)) {
+        std::string vert_path = path + "instanced.vert";
+        std::string frag_path = path + "instanced.frag";
+        if (world_shader_->LoadFromFiles(vert_path, frag_path) &&
+            health_bar_shader_->LoadFromFiles(path + "healthbar.vert", path + "healthbar.frag")) {
             std::cout << "Shaders loaded successfully from: " << path << std::endl;
             shader_loaded = true;
             break;
@@ -80,36 +93,98 @@ bool Game::Initialize(Renderer* renderer, InputManager* input) {
         return false;
     }
     
-    // Initialize cube mesh (wireframe)
-    cube_mesh_ = std::make_unique<Mesh>();
-    cube_mesh_->CreateCubeWireframe();
+#ifdef CORE_DEBUG_DRAW
+    debug_line_shader_ = std::make_unique<Shader>();
+    bool debug_shader_loaded = false;
+    for (const auto& path : shader_paths) {
+        if (debug_line_shader_->LoadFromFiles(path + "debug_line.vert", path + "debug_line.frag")) {
+            debug_shader_loaded = true;
+            break;
+        }
+    }
+    if (!debug_shader_loaded) {
+        std::cerr << "Failed to load debug line shader, debug draw disabled" << std::endl;
+        debug_line_shader_.reset();
+    }
+#endif
     
-    // Initialize enemy mesh (wireframe)
-    enemy_mesh_ = std::make_unique<Mesh>();
-    enemy_mesh_->CreateCubeWireframe();
+    // Game and UI draws go through one sorted command queue, flushed at the end of Render
+    render_queue_ = std::make_unique<RenderQueue>();
+    if (!render_queue_->Initialize()) {
+        std::cerr << "Failed to initialize render queue!" << std::endl;
+        return false;
+    }
     
-    // Initialize turret mesh (wireframe)
-    turret_mesh_ = std::make_unique<Mesh>();
-    turret_mesh_->CreateCubeWireframe();
+    // The 3D scene renders offscreen at a scale that holds the GPU frame-time target;
+    // CORE_RENDER_SCALE pins the scale instead (benchmarking)
+    scene_target_ = std::make_unique<SceneFramebuffer>();
+    if (scene_target_->Initialize()) {
+        render_queue_->SetSceneTarget(scene_target_.get());
+    } else {
+        std::cerr << "Scene framebuffer unavailable, rendering at native resolution" << std::endl;
+        scene_target_.reset();
+    }
+    if (const char* fixed_scale = std::getenv("CORE_RENDER_SCALE")) {
+        dynamic_resolution_.SetFixedScale(static_cast<float>(std::atof(fixed_scale)));
+        std::cout << "Render scale fixed at " << dynamic_resolution_.GetScale() << std::endl;
+    }
+
+    // World geometry shares one vertex/index buffer; identical meshes share one range
+    geometry_ = std::make_unique<GeometryRegistry>();
+    cube_mesh_ = geometry_->Register(Mesh::BuildCubeWireframe());
+    enemy_mesh_ = geometry_->Register(Mesh::BuildCubeWireframe());
+    turret_mesh_ = geometry_->Register(Mesh::BuildCubeWireframe());
+    projectile_mesh_ = geometry_->Register(Mesh::BuildDisc(0.5f, 16)); // radius 0.5, 16 segments (увеличили размер)
+    health_bar_mesh_ = geometry_->Register(Mesh::BuildQuad());
+    if (!geometry_->Upload()) {
+        std::cerr << "Failed to upload world geometry!" << std::endl;
+        return false;
+    }
     
-    // Initialize projectile mesh (disc)
-    projectile_mesh_ = std::make_unique<Mesh>();
-    projectile_mesh_->CreateDisc(0.5f, 16); // radius 0.5, 16 segments (увеличили размер)
+    // Simulation clock drives all gameplay timers
+    sim_clock_ = std::make_unique<SimClock>();
     
     // Initialize enemy spawner
     enemy_spawner_ = std::make_unique<EnemySpawner>();
+    enemy_spawner_->SetSimClock(sim_clock_.get());
     if (!enemy_spawner_->Initialize()) {
         std::cerr << "Failed to initialize enemy spawner!" << std::endl;
         return false;
     }
     
+    // Enemy archetypes from the data file; the built-in grunt and runner otherwise
+    std::vector<std::string> data_paths = {
+        "assets/data/",
+        "../assets/data/",
+        "../../assets/data/",
+        "build/assets/data/"
+    };
+    bool archetypes_loaded = false;
+    for (const auto& path : data_paths) {
+        if (enemy_spawner_->LoadArchetypes(path + "enemies.cfg")) {
+            archetypes_loaded = true;
+            break;
+        }
+    }
+    if (!archetypes_loaded) {
+        std::cout << "Enemy archetype file not found, using built-in archetypes" << std::endl;
+    }
+    
     // Start spawning enemies
     enemy_spawner_->StartSpawning();
     enemy_spawner_->SetSpawnRate(0.5f); // 1 enemy every 2 seconds
     enemy_spawner_->SetSpawnRadius(30.0f); // Spawn 30 units from center
+    enemy_spawner_->SetSwarmLodEnabled(true);
+    
+    // Crowd spacing near the core; the agent budget caps its per-tick cost in big waves
+    SeparationSettings separation;
+    separation.max_neighbors = 8;
+    separation.agent_budget = 4096;
+    enemy_spawner_->SetSeparationSettings(separation);
     
     // Initialize turret manager
     turret_manager_ = std::make_unique<TurretManager>();
+    turret_manager_->SetSimClock(sim_clock_.get());
     if (!turret_manager_->Initialize()) {
         std::cerr << "Failed to initialize turret manager!" << std::endl;
         return false;
@@ -131,16 +206,22 @@ bool Game::Initialize(Renderer* renderer, InputManager* input) {
     
     // Initialize projectile manager
     projectile_manager_ = std::make_unique<ProjectileManager>();
+    projectile_manager_->SetSimClock(sim_clock_.get());
     if (!projectile_manager_->Initialize()) {
         std::cerr << "Failed to initialize projectile manager!" << std::endl;
         return false;
     }
     
+    // Collision stage between projectiles and enemies
+    collision_system_ = std::make_unique<CollisionSystem>();
+    collision_system_->SetHitRadius(ProjectileManager::kHitRadius);
+    
     // Connect turret manager to projectile manager
     turret_manager_->SetProjectileManager(projectile_manager_.get());
     
     // Initialize wave manager
     wave_manager_ = std::make_unique<WaveManager>();
+    wave_manager_->SetSimClock(sim_clock_.get());
     wave_manager_->SetEnemySpawner(enemy_spawner_.get());
     
     // Initialize item manager (before connecting to wave manager)
@@ -151,9 +232,33 @@ bool Game::Initialize(Renderer* renderer, InputManager* input) {
     }
     wave_manager_->SetItemManager(item_manager_.get());
     
-    // Connect enemy spawner and projectile manager to wave manager
+    // Connect enemy spawner to wave manager
     enemy_spawner_->SetWaveManager(wave_manager_.get());
-    projectile_manager_->SetWaveManager(wave_manager_.get());
+    
+    // Damage from every source is buffered and applied once per tick
+    damage_system_ = std::make_unique<DamageSystem>();
+    damage_system_->SetWaveManager(wave_manager_.get());
+    projectile_manager_->SetDamageSystem(damage_system_.get());
+    
+    // Area and chain effects query the grid the spawner rebuilds every tick
+    projectile_manager_->SetEnemyGrid(&enemy_spawner_->GetSpatialGrid());
+    
+    // Turrets pick targets from the spawner's priority sets
+    turret_manager_->SetTargetingIndex(&enemy_spawner_->GetTargetingIndex());
+    damage_system_->SetTargetingIndex(&enemy_spawner_->GetTargetingIndex());
+    
+    // Frost, Burn and Stun hits put status effects on enemies; burn damage is buffered too
+    projectile_manager_->SetStatusSystem(&enemy_spawner_->GetStatusSystem());
+    enemy_spawner_->GetStatusSystem().SetDamageSystem(damage_system_.get());
+    
+    // Enemies path around turret zones; the field covers the spawn shell around the core
+    flow_field_ = std::make_unique<FlowField>();
+    if (!flow_field_->Initialize(glm::vec3(-32.0f, -32.0f, -16.0f), glm::vec3(32.0f, 32.0f, 16.0f), 2.0f, glm::vec3(0.0f))) {
+        std::cerr << "Failed to initialize flow field!" << std::endl;
+        return false;
+    }
+    enemy_spawner_->SetFlowField(flow_field_.get());
+    turret_manager_->SetFlowField(flow_field_.get());
     
     // Теперь спавн контролируется системой волн, отключаем автоматический спавн
     enemy_spawner_->StopSpawning();
@@ -165,7 +270,7 @@ bool Game::Initialize(Renderer* renderer, InputManager* input) {
     
     // Initialize UI manager
     ui_manager_ = std::make_unique<UIManager>();
-    if (!ui_manager_->Initialize(shader_.get())) {
+    if (!ui_manager_->Initialize(render_queue_.get())) {
         std::cerr << "Failed to initialize UI manager!" << std::endl;
         return false;
     }
@@ -442,6 +547,45 @@ void Game::Update() {
         }
     }
 
+    // Toggle the performance counter overlay with F3
+    if (input_->IsKeyJustPressed(292)) { // GLFW_KEY_F3
+        debug_overlay_ = !debug_overlay_;
+    }
+
+    // F4 switches render queue sorting and the GL state cache off and on, to compare
+    // submit time and state changes against the unbatched path
+    if (input_->IsKeyJustPressed(293) && render_queue_) { // GLFW_KEY_F4
+        render_queue_->SetBatchingEnabled(!render_queue_->IsBatchingEnabled());
+        std::cout << "Render batching " << (render_queue_->IsBatchingEnabled() ? "on" : "off") << std::endl;
+    }
+    
+    // F10 steps through fixed render scales and back to automatic
+    if (input_->IsKeyJustPressed(299)) { // GLFW_KEY_F10
+        static const float kFixedScales[] = {1.0f, 0.75f, 0.5f};
+        static int fixed_scale_index = -1;
+        fixed_scale_index++;
+        if (fixed_scale_index >= static_cast<int>(sizeof(kFixedScales) / sizeof(kFixedScales[0]))) {
+            fixed_scale_index = -1;
+            dynamic_resolution_.ClearFixedScale();
+            std::cout << "Render scale: automatic" << std::endl;
+        } else {
+            dynamic_resolution_.SetFixedScale(kFixedScales[fixed_scale_index]);
+            std::cout << "Render scale fixed at " << kFixedScales[fixed_scale_index] << std::endl;
+        }
+    }
+    
+#ifdef CORE_DEBUG_DRAW
+    // F5-F9 toggle the debug-draw categories, in DebugCategory order
+    for (int i = 0; i < static_cast<int>(DebugCategory::Count); ++i) {
+        if (input_->IsKeyJustPressed(294 + i)) { // GLFW_KEY_F5 + i
+            DebugCategory category = static_cast<DebugCategory>(i);
+            DebugDraw::SetEnabled(category, !DebugDraw::IsEnabled(category));
+            std::cout << "Debug draw " << DebugDraw::GetCategoryName(category) << ": "
+                      << (DebugDraw::IsEnabled(category) ? "on" : "off") << std::endl;
+        }
+    }
+#endif
+
     // Hold R for 2 seconds to restart the game
     static float r_hold_time = 0.0f;
     if (input_->IsKeyPressed(82)) { // GLFW_KEY_R
@@ -471,17 +615,6 @@ void Game::Update() {
     // Update camera
     if (state_ == GameState::Playing && !paused_) camera_->Update(Time::GetDeltaTime());
     
-    // Update enemy spawner and enemies
-    if (state_ == GameState::Playing && !paused_ && enemy_spawner_) {
-        enemy_spawner_->Update(Time::GetDeltaTime());
-    }
-    
-    // Update turret manager and turrets
-    if (state_ == GameState::Playing && !paused_ && turret_manager_ && enemy_spawner_) {
-        const auto& enemies = enemy_spawner_->GetEnemies();
-        turret_manager_->Update(Time::GetDeltaTime(), enemies);
-    }
-    
     // Handle turret placement system
     static bool left_button_was_pressed = false;
     bool left_button_is_pressed = input_->IsMouseButtonPressed(GLFW_MOUSE_BUTTON_LEFT);
@@ -730,109 +863,174 @@ void Game::Update() {
     }
     right_button_was_pressed = right_button_is_pressed;
     
-    // Update wave manager (контролирует спавн врагов)
-    if (state_ == GameState::Playing && !paused_) {
-        wave_manager_->Update(Time::GetDeltaTime());
-    }
-    
-    // Update game systems
+    // Один шаг симуляции за кадр: сначала часы, затем системы разбирают сработавшие таймеры.
+    // Each system steps exactly once, so speeds, spawn intervals and fire rates are the
+    // configured ones. The spawner and turrets used to be updated twice a frame, which
+    // ran enemies, spawns and turret fire at double pace.
     if (state_ == GameState::Playing && !paused_) {
+#ifdef CORE_DEBUG_DRAW
+        // Systems redraw their debug shapes each step; while paused the last ones stay up
+        DebugDraw::Clear();
+#endif
+        sim_clock_->Advance(Time::GetDeltaTime());
+        wave_manager_->Update(); // контролирует спавн врагов
+        enemy_spawner_->SetEngagementRadius(turret_manager_->GetEngagementRadius());
         enemy_spawner_->Update(Time::GetDeltaTime());
         turret_manager_->Update(Time::GetDeltaTime(), enemy_spawner_->GetEnemies());
         projectile_manager_->Update(Time::GetDeltaTime(), enemy_spawner_->GetEnemies());
+        collision_system_->Update(projectile_manager_->GetProjectiles(), enemy_spawner_->GetEnemies());
+        projectile_manager_->ApplyCollisions(collision_system_->GetHits(), enemy_spawner_->GetEnemies());
+        damage_system_->Apply(enemy_spawner_->GetEnemies());
     }
 }
 
-void Game::Render() {
+void Game::BeginCullBatch() {
+    cull_indices_.clear();
+    cull_positions_.clear();
+}
+
+size_t Game::CullPositions(const std::vector<glm::vec3>& positions, float radius) {
+    cull_visible_.resize(positions.size());
+    size_t visible = frustum_.CullSpheres(positions.data(), positions.size(), radius, cull_visible_.data());
+    Metrics::Add("render.submitted", static_cast<double>(visible));
+    Metrics::Add("render.culled", static_cast<double>(positions.size() - visible));
+    return visible;
+}
+
+void Game::RecordFrame() {
     if (!initialized_) return;
+    render_queue_->BeginFrame();
     
-    // Use shader
-    shader_->Use();
+    // Pick this frame's scene resolution from the last measured GPU frame time
+    dynamic_resolution_.Update(render_queue_->GetGpuFrameMs());
+    int fb_w = renderer_ ? renderer_->GetFramebufferWidth() : 1280;
+    int fb_h = renderer_ ? renderer_->GetFramebufferHeight() : 720;
+    render_queue_->SetSceneSize(fb_w, fb_h, dynamic_resolution_.GetScale());
+    Metrics::Set("render.scale", scene_target_ ? dynamic_resolution_.GetScale() : 1.0f);
+    Metrics::Set("render.target_ms", dynamic_resolution_.GetSettings().target_ms);
     
-    // Set up matrices
-    glm::mat4 model = glm::mat4(1.0f); // Identity matrix
-    shader_->SetUniform("model", model);
-    shader_->SetUniform("view", camera_->GetViewMatrix());
-    shader_->SetUniform("projection", camera_->GetProjectionMatrix());
+    // World geometry is queued as instances and drawn in one submission below
+    geometry_->BeginFrame();
     
-    // Set cube color (bright cyan for player core)
-    shader_->SetUniform("color", glm::vec3(0.0f, 1.0f, 1.0f)); // Cyan
+    // Player core cube (bright cyan)
+    geometry_->AddInstance(cube_mesh_, glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 1.0f));
     
-    // Render the cube as wireframe
-    cube_mesh_->RenderWireframe();
+    // Everything below is tested against the view frustum in batches before drawing
+    frustum_.Extract(camera_->GetProjectionMatrix() * camera_->GetViewMatrix());
     
     // Render enemies
     if (enemy_spawner_) {
         const auto& enemies = enemy_spawner_->GetEnemies();
-        for (const auto& enemy : enemies) {
-            if (enemy && enemy->IsAlive()) {
-                // Set enemy position
-                glm::mat4 enemy_model = glm::translate(glm::mat4(1.0f), enemy->GetPosition());
-                shader_->SetUniform("model", enemy_model);
-                
-                // Set enemy color (red)
-                shader_->SetUniform("color", enemy->GetColor());
-                
-                // Render enemy cube as wireframe
-                enemy_mesh_->RenderWireframe();
+        BeginCullBatch();
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            if (enemies[i] && enemies[i]->IsAlive()) {
+                AddToCullBatch(static_cast<uint32_t>(i), enemies[i]->GetPosition());
             }
         }
+        CullBatch(kCubeBoundingRadius);
+        size_t health_bars = 0;
+        for (size_t i = 0; i < cull_indices_.size(); ++i) {
+            if (!cull_visible_[i]) continue;
+            const Enemy* enemy = enemies[cull_indices_[i]].get();
+            // Set enemy position
+            glm::mat4 enemy_model = glm::translate(glm::mat4(1.0f), cull_positions_[i]);
+            
+            // Set enemy color (red), tinted by status effects
+            glm::vec3 enemy_color = enemy->GetColor();
+            StatusMask status = enemy->GetStatusMask();
+            if (HasStatus(status, StatusEffect::Stun)) {
+                enemy_color = glm::vec3(1.0f);
+            } else if (HasStatus(status, StatusEffect::Slow)) {
+                enemy_color = glm::mix(enemy_color, glm::vec3(0.3f, 0.8f, 1.0f), 0.6f);
+            } else if (HasStatus(status, StatusEffect::Burn)) {
+                enemy_color = glm::mix(enemy_color, glm::vec3(1.0f, 0.5f, 0.0f), 0.6f);
+            }
+            
+            geometry_->AddInstance(enemy_mesh_, enemy_model, enemy_color);
+            
+            // Damaged enemies get a bar; the shader billboards it and fills it from the ratio
+            float max_health = enemy->GetMaxHealth();
+            if (max_health > 0.0f && enemy->GetHealth() < max_health) {
+                glm::mat4 bar_model = glm::translate(glm::mat4(1.0f), cull_positions_[i] + glm::vec3(0.0f, kHealthBarOffset, 0.0f));
+                bar_model = glm::scale(bar_model, glm::vec3(kHealthBarWidth, kHealthBarHeight, 1.0f));
+                geometry_->AddInstance(health_bar_mesh_, bar_model, glm::vec3(0.0f, 1.0f, 0.0f),
+                                       enemy->GetHealth() / max_health);
+                health_bars++;
+            }
+        }
+        Metrics::Add("render.health_bars", static_cast<double>(health_bars));
+        
+        // Far enemies still travelling in swarm groups
+        swarm_positions_.clear();
+        swarm_colors_.clear();
+        enemy_spawner_->GetSwarm().GetMemberPositions(sim_clock_->GetTime(), swarm_positions_, swarm_colors_);
+        CullPositions(swarm_positions_, kCubeBoundingRadius);
+        for (size_t i = 0; i < swarm_positions_.size(); ++i) {
+            if (!cull_visible_[i]) continue;
+            geometry_->AddInstance(enemy_mesh_, glm::translate(glm::mat4(1.0f), swarm_positions_[i]), swarm_colors_[i]);
+        }
     }
     
     // Render dropped items
     if (item_manager_) {
         const auto& items = item_manager_->GetDroppedItems();
-        for (const auto& item : items) {
-            if (item && item->IsActive()) {
-                // Small cube for item (0.5 scale)
-                glm::mat4 item_model = glm::mat4(1.0f);
-                item_model = glm::translate(item_model, item->GetPosition());
-                item_model = glm::scale(item_model, glm::vec3(0.5f)); // Smaller cube
-                shader_->SetUniform("model", item_model);
-                
-                // Highlight hovered item
-                bool is_hovered = (hovered_item_ == item.get());
-                glm::vec3 item_color = is_hovered ? 
-                    item->GetColor() * 1.5f : // Brighter when hovered
-                    item->GetColor();
-                
-                shader_->SetUniform("color", item_color);
-                
-                // Render item as wireframe cube
-                cube_mesh_->RenderWireframe();
+        BeginCullBatch();
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (items[i] && items[i]->IsActive()) {
+                AddToCullBatch(static_cast<uint32_t>(i), items[i]->GetPosition());
             }
         }
+        CullBatch(kCubeBoundingRadius * 0.5f);
+        for (size_t i = 0; i < cull_indices_.size(); ++i) {
+            if (!cull_visible_[i]) continue;
+            const Item* item = items[cull_indices_[i]].get();
+            // Small cube for item (0.5 scale)
+            glm::mat4 item_model = glm::mat4(1.0f);
+            item_model = glm::translate(item_model, cull_positions_[i]);
+            item_model = glm::scale(item_model, glm::vec3(0.5f)); // Smaller cube
+            
+            // Highlight hovered item
+            bool is_hovered = (hovered_item_ == item);
+            glm::vec3 item_color = is_hovered ? 
+                item->GetColor() * 1.5f : // Brighter when hovered
+                item->GetColor();
+            
+            geometry_->AddInstance(cube_mesh_, item_model, item_color);
+        }
     }
     
     // Render turrets
     if (turret_manager_) {
         const auto& turrets = turret_manager_->GetTurrets();
-        for (const auto& turret : turrets) {
-            if (turret && turret->IsActive()) {
-                // Set turret position and rotation
-                glm::mat4 turret_model = glm::mat4(1.0f);
-                turret_model = glm::translate(turret_model, turret->GetPosition());
-                turret_model = glm::rotate(turret_model, glm::radians(turret->GetRotation()), glm::vec3(0.0f, 1.0f, 0.0f));
-                shader_->SetUniform("model", turret_model);
-                
-                // Color priority: selected > hovered > normal
-                bool is_selected = (selected_turret_ == turret.get());
-                bool is_hovered = (hovered_turret_ == turret.get());
-                
-                glm::vec3 turret_color;
-                if (is_selected) {
-                    turret_color = glm::vec3(1.0f, 1.0f, 0.0f); // Yellow when selected
-                } else if (is_hovered) {
-                    turret_color = glm::vec3(0.5f, 1.0f, 0.5f); // Light green when hovered
-                } else {
-                    turret_color = turret->GetColor(); // Normal green
-                }
-                
-                shader_->SetUniform("color", turret_color);
-                
-                // Render turret cube as wireframe
-                turret_mesh_->RenderWireframe();
+        BeginCullBatch();
+        for (size_t i = 0; i < turrets.size(); ++i) {
+            if (turrets[i] && turrets[i]->IsActive()) {
+                AddToCullBatch(static_cast<uint32_t>(i), turrets[i]->GetPosition());
+            }
+        }
+        CullBatch(kCubeBoundingRadius);
+        for (size_t i = 0; i < cull_indices_.size(); ++i) {
+            if (!cull_visible_[i]) continue;
+            const Turret* turret = turrets[cull_indices_[i]].get();
+            // Set turret position and rotation
+            glm::mat4 turret_model = glm::mat4(1.0f);
+            turret_model = glm::translate(turret_model, cull_positions_[i]);
+            turret_model = glm::rotate(turret_model, glm::radians(turret->GetRotation()), glm::vec3(0.0f, 1.0f, 0.0f));
+            
+            // Color priority: selected > hovered > normal
+            bool is_selected = (selected_turret_ == turret);
+            bool is_hovered = (hovered_turret_ == turret);
+            
+            glm::vec3 turret_color;
+            if (is_selected) {
+                turret_color = glm::vec3(1.0f, 1.0f, 0.0f); // Yellow when selected
+            } else if (is_hovered) {
+                turret_color = glm::vec3(0.5f, 1.0f, 0.5f); // Light green when hovered
+            } else {
+                turret_color = turret->GetColor(); // Normal green
             }
+            
+            geometry_->AddInstance(turret_mesh_, turret_model, turret_color);
         }
     }
     
@@ -846,43 +1044,58 @@ void Game::Render() {
             std::cout << "Rendering " << projectiles.size() << " projectiles" << std::endl;
         }
         
-        for (const auto& projectile : projectiles) {
-            if (projectile && projectile->IsActive()) {
-                // Set projectile position
-                glm::mat4 projectile_model = glm::mat4(1.0f);
-                projectile_model = glm::translate(projectile_model, projectile->GetPosition());
-                shader_->SetUniform("model", projectile_model);
-                
-                // Set projectile color (cyan like in TRON)
-                shader_->SetUniform("color", projectile->GetColor());
-                
-                // Render projectile disc as wireframe (hollow ring)
-                projectile_mesh_->RenderWireframe();
+        BeginCullBatch();
+        for (size_t i = 0; i < projectiles.size(); ++i) {
+            if (projectiles[i] && projectiles[i]->IsActive()) {
+                AddToCullBatch(static_cast<uint32_t>(i), projectiles[i]->GetPosition());
             }
         }
+        CullBatch(kProjectileBoundingRadius);
+        for (size_t i = 0; i < cull_indices_.size(); ++i) {
+            if (!cull_visible_[i]) continue;
+            const Projectile* projectile = projectiles[cull_indices_[i]].get();
+            // Set projectile position
+            glm::mat4 projectile_model = glm::mat4(1.0f);
+            projectile_model = glm::translate(projectile_model, cull_positions_[i]);
+            
+            // Projectile disc as a hollow ring (cyan like in TRON)
+            geometry_->AddInstance(projectile_mesh_, projectile_model, projectile->GetColor());
+        }
     }
     
     // Render turret preview
     if (turret_preview_ && turret_preview_->IsVisible()) {
         // Set up model matrix for preview position
         glm::mat4 preview_model = glm::translate(glm::mat4(1.0f), preview_position_);
-        shader_->SetUniform("model", preview_model);
         
         // Set preview color based on validity
         glm::vec3 preview_color = preview_valid_ ? 
             glm::vec3(0.0f, 1.0f, 0.0f) : // Green for valid
             glm::vec3(1.0f, 0.0f, 0.0f);  // Red for invalid
-        shader_->SetUniform("color", preview_color);
         
-        // Render preview as wireframe
-        turret_mesh_->RenderWireframe();
+        geometry_->AddInstance(turret_mesh_, preview_model, preview_color);
     }
     
+    // All world geometry: one VAO, one instance upload, one multi-draw where supported
+    render_queue_->SubmitGeometry(geometry_.get(), world_shader_.get(), camera_->GetViewMatrix(), camera_->GetProjectionMatrix());
+    // Enemy health bars: one instanced draw from the same instance buffer
+    render_queue_->SubmitMesh(geometry_.get(), health_bar_mesh_, health_bar_shader_.get(),
+                              camera_->GetViewMatrix(), camera_->GetProjectionMatrix());
+    
+#ifdef CORE_DEBUG_DRAW
+    // Debug shapes from the last simulation step: one streamed line buffer, one draw
+    const auto& debug_lines = DebugDraw::GetLineVertices();
+    render_queue_->SubmitLines(debug_lines.data(), debug_lines.size(), debug_line_shader_.get(),
+                               camera_->GetViewMatrix(), camera_->GetProjectionMatrix());
+    Metrics::Add("render.debug_lines", static_cast<double>(debug_lines.size() / 2));
+#endif
+    
     // Render UI (last, on top of everything)
     if (ui_manager_ && wave_manager_) {
         // Use actual viewport size
         int w = renderer_ ? renderer_->GetViewportWidth() : 1280;
         int h = renderer_ ? renderer_->GetViewportHeight() : 720;
+        render_queue_->SetScreenSize(w, h);
         if (state_ == GameState::MainMenu) {
             ui_manager_->RenderMainMenu(w, h, main_menu_index_);
         } else if (state_ == GameState::Options) {
@@ -895,6 +1108,12 @@ void Game::Render() {
         if (paused_ && state_ == GameState::Playing) {
             ui_manager_->RenderPausedOverlay(w, h);
         }
+        if (debug_overlay_) {
+            ui_manager_->RenderDebugOverlay(w, h);
+        }
+#ifdef CORE_DEBUG_DRAW
+        ui_manager_->RenderDebugLabels(camera_->GetProjectionMatrix() * camera_->GetViewMatrix(), w, h);
+#endif
         
         // Inventory screen (I key)
         if (state_ == GameState::Playing && inventory_open_) {
@@ -928,8 +1147,9 @@ void Game::Render() {
             bool sell_clicked = false;
             int slot_clicked = -1;
             int inventory_clicked = -1;
+            bool policy_clicked = false;
             
-            ui_manager_->RenderTurretMenu(selected_turret_, camera_.get(), input_, item_manager_.get(), selected_inventory_index_, w, h, sell_clicked, slot_clicked, inventory_clicked);
+            ui_manager_->RenderTurretMenu(selected_turret_, camera_.get(), input_, item_manager_.get(), selected_inventory_index_, w, h, sell_clicked, slot_clicked, inventory_clicked, policy_clicked);
             
             // Close menu on ESC
             if (input_->IsKeyJustPressed(256)) { // ESC
@@ -943,6 +1163,13 @@ void Game::Render() {
                 std::cout << "Turret menu closed (game resumed)" << std::endl;
             }
             
+            // Cycle the turret's targeting policy
+            if (policy_clicked) {
+                int next = (static_cast<int>(selected_turret_->GetTargetingPolicy()) + 1) % static_cast<int>(TargetingPolicy::Count);
+                selected_turret_->SetTargetingPolicy(static_cast<TargetingPolicy>(next));
+                std::cout << "Turret targeting: " << GetTargetingPolicyName(selected_turret_->GetTargetingPolicy()) << std::endl;
+            }
+            
             // Handle equipping items: first select item from grid, then click slot
             if (inventory_clicked >= 0) {
                 // Grid item clicked - select/toggle it
@@ -992,24 +1219,99 @@ void Game::Render() {
     }
 }
 
+bool Game::IsIdle() const {
+    return state_ != GameState::Playing || paused_;
+}
+
+void Game::PublishFrame() {
+    if (!initialized_) return;
+    render_queue_->EndFrame();
+}
+
+bool Game::WaitForFrame() {
+    return initialized_ && render_queue_->WaitForFrame();
+}
+
+void Game::SubmitFrame() {
+    // World first, then overlay shapes, then text
+    render_queue_->Flush();
+}
+
+void Game::FramePresented() {
+    render_queue_->FramePresented();
+}
+
+void Game::StopRendering() {
+    if (render_queue_) render_queue_->Stop();
+}
+
+void Game::SetupBenchmarkScene(const BenchmarkScene& scene) {
+    if (!initialized_) return;
+
+    state_ = GameState::Playing;
+    inventory_open_ = scene.inventory_items > 0;
+    paused_ = inventory_open_;
+
+    // Enemies on rings between 4 and 20 units, as entities rather than swarm groups
+    if (enemy_spawner_) {
+        const float kDefaultSpawnRadius = 25.0f;
+        enemy_spawner_->SetSwarmLodEnabled(false);
+        for (int i = 0; i < scene.enemies; ++i) {
+            enemy_spawner_->SetSpawnRadius(4.0f + 16.0f * static_cast<float>(i % 16) / 15.0f);
+            enemy_spawner_->SpawnEnemy();
+        }
+        enemy_spawner_->SetSpawnRadius(kDefaultSpawnRadius);
+        if (scene.damaged) {
+            for (const auto& enemy : enemy_spawner_->GetEnemies()) {
+                enemy->SetHealth(enemy->GetMaxHealth() * 0.5f);
+            }
+        }
+    }
+
+    // Projectiles spread by the golden angle, aimed at the core
+    if (projectile_manager_) {
+        const float kGoldenAngle = 2.39996f;
+        for (int i = 0; i < scene.projectiles; ++i) {
+            float angle = kGoldenAngle * static_cast<float>(i);
+            float radius = 4.0f + 16.0f * static_cast<float>(i % 17) / 16.0f;
+            glm::vec3 start(radius * glm::cos(angle), radius * glm::sin(angle), 0.0f);
+            projectile_manager_->CreateProjectile(start, glm::vec3(0.0f), 10.0f, 1, nullptr);
+        }
+    }
+
+    // Inventory: drop items far off-screen and pick each one up
+    if (item_manager_) {
+        for (int i = 0; i < scene.inventory_items; ++i) {
+            glm::vec3 position(1000.0f + 10.0f * static_cast<float>(i), 0.0f, 0.0f);
+            item_manager_->DropItem(position);
+            item_manager_->PickupItemAtPosition(position, 1.0f);
+        }
+    }
+}
+
 void Game::Shutdown() {
     std::cout << "Shutting down game..." << std::endl;
     
     // Clean up graphics objects
-    cube_mesh_.reset();
-    enemy_mesh_.reset();
-    turret_mesh_.reset();
-    projectile_mesh_.reset();
-    shader_.reset();
+    // UI first: it hands its shaders to the render queue
+    ui_manager_.reset();
+    render_queue_.reset();
+    scene_target_.reset();
+    geometry_.reset();
+    world_shader_.reset();
+    health_bar_shader_.reset();
+    debug_line_shader_.reset();
     camera_.reset();
     enemy_spawner_.reset();
     turret_manager_.reset();
     ray_caster_.reset();
     turret_preview_.reset();
     projectile_manager_.reset();
+    collision_system_.reset();
+    damage_system_.reset();
     wave_manager_.reset();
-    ui_manager_.reset();
     item_manager_.reset();
+    sim_clock_.reset();
     
     initialized_ = false;
     renderer_ = nullptr;
@@ -1,13 +1,19 @@
 // Main game logic coordinator and state manager
 #pragma once
 
+#include "graphics/frustum.h"
+#include "graphics/dynamic_resolution.h"
 #include <memory>
+#include <vector>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 class Renderer;
 class InputManager;
 class Shader;
-class Mesh;
+class GeometryRegistry;
+class RenderQueue;
+class SceneFramebuffer;
 class Camera;
 class EnemySpawner;
 class TurretManager;
@@ -19,6 +25,10 @@ class WaveManager;
 class UIManager;
 class ItemManager;
 class Item;
+class SimClock;
+class CollisionSystem;
+class DamageSystem;
+class FlowField;
 
 class Game {
 public:
@@ -27,33 +37,98 @@ public:
     
     bool Initialize(Renderer* renderer, InputManager* input);
     void Update();
-    void Render();
     void Shutdown();
     
+    // Nothing is simulated (menus, pause, inventory), so the loop may run slower
+    bool IsIdle() const;
+    
+    // Recording (simulation thread): build this frame's render snapshot and publish it
+    void RecordFrame();
+    void PublishFrame();
+    
+    // Submission (the thread that owns the GL context): take the latest snapshot,
+    // draw it, and report its latency once the buffers have been swapped
+    bool WaitForFrame();
+    void SubmitFrame();
+    void FramePresented();
+    
+    // Release a render thread blocked in WaitForFrame (and the recorder in PublishFrame)
+    void StopRendering();
+    
+    RenderQueue* GetRenderQueue() const { return render_queue_.get(); }
+    
+    // Scripted content for the headless render benchmark: a running game with fixed
+    // entities and no waves (call after Initialize; nothing is simulated)
+    struct BenchmarkScene {
+        int enemies = 0;            // Spread from 4 to 20 units around the core
+        int projectiles = 0;        // Flying inward from the same band
+        bool damaged = true;        // Enemies at half health, so health bars draw
+        int inventory_items = 0;    // Over 0: the inventory screen is open with these
+    };
+    void SetupBenchmarkScene(const BenchmarkScene& scene);
+    
 private:
     Renderer* renderer_;
     InputManager* input_;
     
     // Graphics objects
-    std::unique_ptr<Shader> shader_;
-    std::unique_ptr<Mesh> cube_mesh_;
-    std::unique_ptr<Mesh> enemy_mesh_;
-    std::unique_ptr<Mesh> turret_mesh_;
-    std::unique_ptr<Mesh> projectile_mesh_;
+    std::unique_ptr<Shader> world_shader_;   // Instanced shader for registry geometry
+    std::unique_ptr<Shader> health_bar_shader_;  // Camera-facing bars filled from the instance value
+    std::unique_ptr<Shader> debug_line_shader_;  // Debug-draw lines (CORE_DEBUG_DRAW builds only)
+    std::unique_ptr<RenderQueue> render_queue_;
+    std::unique_ptr<SceneFramebuffer> scene_target_;   // 3D scene at the dynamic render scale
+    DynamicResolution dynamic_resolution_;
+    std::unique_ptr<GeometryRegistry> geometry_;
+    uint32_t cube_mesh_ = 0;        // GeometryRegistry mesh ids (the three cubes share one range)
+    uint32_t enemy_mesh_ = 0;
+    uint32_t turret_mesh_ = 0;
+    uint32_t projectile_mesh_ = 0;
+    uint32_t health_bar_mesh_ = 0;  // Quad, one instance per visible damaged enemy
     std::unique_ptr<Camera> camera_;
     
-    // Game systems
+    // Game systems (the simulation clock is declared first so it outlives the timers of every system)
+    std::unique_ptr<SimClock> sim_clock_;
     std::unique_ptr<EnemySpawner> enemy_spawner_;
     std::unique_ptr<TurretManager> turret_manager_;
     std::unique_ptr<RayCaster> ray_caster_;
     std::unique_ptr<TurretPreview> turret_preview_;
     std::unique_ptr<ProjectileManager> projectile_manager_;
+    std::unique_ptr<CollisionSystem> collision_system_;
+    std::unique_ptr<DamageSystem> damage_system_;
+    std::unique_ptr<FlowField> flow_field_;
     std::unique_ptr<WaveManager> wave_manager_;
     std::unique_ptr<UIManager> ui_manager_;
     std::unique_ptr<ItemManager> item_manager_;
     
     bool initialized_;
     
+    // Scratch for drawing enemies still grouped in the swarm
+    std::vector<glm::vec3> swarm_positions_;
+    std::vector<glm::vec3> swarm_colors_;
+    
+    // Frustum culling: each entity list is gathered into a batch (source index and
+    // position), tested in one pass, and only visible entries are drawn
+    static constexpr float kCubeBoundingRadius = 0.87f;        // Unit cube half-diagonal
+    static constexpr float kProjectileBoundingRadius = 0.5f;   // Disc radius
+    
+    // Enemy health bars: world units, bar centre above the enemy's centre
+    static constexpr float kHealthBarWidth = 1.0f;
+    static constexpr float kHealthBarHeight = 0.12f;
+    static constexpr float kHealthBarOffset = 0.85f;
+    Frustum frustum_;
+    std::vector<uint32_t> cull_indices_;
+    std::vector<glm::vec3> cull_positions_;
+    std::vector<uint8_t> cull_visible_;
+    void BeginCullBatch();
+    void AddToCullBatch(uint32_t index, const glm::vec3& position) {
+        cull_indices_.push_back(index);
+        cull_positions_.push_back(position);
+    }
+    size_t CullBatch(float radius) { return CullPositions(cull_positions_, radius); }
+    size_t CullPositions(const std::vector<glm::vec3>& positions, float radius); // Fills cull_visible_
+    
+    bool debug_overlay_ = false; // F3 toggles the performance counter overlay (F4: render queue batching)
+    
     // Turret placement state
     bool turret_placement_mode_;
     glm::vec3 preview_position_;
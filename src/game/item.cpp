@@ -83,7 +83,7 @@ void Item::GenerateStats() {
             secondary_bonus_ = 50.0f;
             
             // Случайный легендарный эффект
-            std::uniform_int_distribution<int> effect_dist(1, 5);
+            std::uniform_int_distribution<int> effect_dist(1, 8);
             legendary_effect_ = static_cast<LegendaryEffect>(effect_dist(gen));
             break;
     }
@@ -181,6 +181,15 @@ std::string Item::GetDescription() const {
             case LegendaryEffect::Piercing:
                 desc += "\n[PIERCING]\nProjectiles pierce enemies";
                 break;
+            case LegendaryEffect::Frost:
+                desc += "\n[FROST]\nHits slow enemies";
+                break;
+            case LegendaryEffect::Burn:
+                desc += "\n[BURN]\nHits set enemies on fire";
+                break;
+            case LegendaryEffect::Stun:
+                desc += "\n[STUN]\nHits stun enemies";
+                break;
             default: break;
         }
     }
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <string>
 
 // Item rarity levels
@@ -28,9 +29,17 @@ enum class LegendaryEffect {
     SplitShot,       // Снаряд раздваивается при попадании
     Multishot,       // Стреляет 3 снарядами одновременно
     Explosive,       // AoE урон вокруг попадания
-    Piercing         // Снаряд пробивает врагов насквозь
+    Piercing,        // Снаряд пробивает врагов насквозь
+    Frost,           // Попадание замедляет врага
+    Burn,            // Попадание поджигает врага (урон со временем)
+    Stun             // Попадание оглушает врага
 };
 
+// Bit set of legendary effects carried by a turret or projectile
+using EffectMask = uint32_t;
+inline EffectMask EffectBit(LegendaryEffect effect) { return 1u << static_cast<uint32_t>(effect); }
+inline bool HasEffect(EffectMask mask, LegendaryEffect effect) { return (mask & EffectBit(effect)) != 0; }
+
 class Item {
 public:
     Item();
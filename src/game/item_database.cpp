@@ -51,7 +51,7 @@ void ItemDatabase::GenerateItemTemplates() {
                         LegendaryEffect effect = LegendaryEffect::None;
                         if (rarity == ItemRarity::Legendary) {
                             // Generate legendary items with different effects
-                            for (int effect_val = 1; effect_val <= 5; ++effect_val) {
+                            for (int effect_val = 1; effect_val <= 8; ++effect_val) {
                                 effect = static_cast<LegendaryEffect>(effect_val);
                                 std::string legendary_name = GetRarityName(rarity) + " " + GetStatName(primary_stat) + 
                                                             "/" + GetStatName(secondary_stat) + " " + GetEffectName(effect);
@@ -365,6 +365,9 @@ std::string ItemDatabase::GetEffectName(LegendaryEffect effect) const {
         case LegendaryEffect::Multishot: return "Multishot";
         case LegendaryEffect::Explosive: return "Explosive";
         case LegendaryEffect::Piercing: return "Piercing";
+        case LegendaryEffect::Frost: return "Frost";
+        case LegendaryEffect::Burn: return "Burn";
+        case LegendaryEffect::Stun: return "Stun";
         default: return "None";
     }
 }
@@ -376,6 +379,9 @@ std::string ItemDatabase::GetEffectDescription(LegendaryEffect effect) const {
         case LegendaryEffect::Multishot: return "Fires 3 projectiles";
         case LegendaryEffect::Explosive: return "AoE damage on hit";
         case LegendaryEffect::Piercing: return "Projectiles pierce enemies";
+        case LegendaryEffect::Frost: return "Hits slow enemies";
+        case LegendaryEffect::Burn: return "Hits set enemies on fire";
+        case LegendaryEffect::Stun: return "Hits stun enemies";
         default: return "No special effect";
     }
 }
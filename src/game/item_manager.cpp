@@ -39,6 +39,19 @@ void ItemManager::DropItem(const glm::vec3& position) {
     }
 }
 
+void ItemManager::DropItems(const std::vector<glm::vec3>& positions) {
+    dropped_items_.reserve(dropped_items_.size() + positions.size());
+    for (const glm::vec3& position : positions) {
+        auto item = std::make_unique<Item>();
+        if (item->Initialize(position, GenerateRandomRarity())) {
+            dropped_items_.push_back(std::move(item));
+        }
+    }
+    
+    // Auto-cleanup if too many items on ground
+    CleanupOldDrops(MAX_DROPPED_ITEMS);
+}
+
 Item* ItemManager::PickupItemAtPosition(const glm::vec3& position, float radius) {
     for (auto& item : dropped_items_) {
         if (!item || !item->IsActive()) continue;
@@ -18,6 +18,7 @@ public:
     
     // Drop item at position with random rarity
     void DropItem(const glm::vec3& position);
+    void DropItems(const std::vector<glm::vec3>& positions); // Batch drop, cleans up once
     
     // Pickup item at position (returns true if item was picked up)
     Item* PickupItemAtPosition(const glm::vec3& position, float radius = 2.0f);
@@ -1,24 +1,31 @@
-// Implementation of homing projectile physics
+// Implementation of projectile flight
 #include "projectile.h"
-#include "enemy.h"
+#include "utils/math.h"
+#include <algorithm>
 #include <iostream>
 
 Projectile::Projectile()
-    : position_(0.0f), target_position_(0.0f), direction_(0.0f), speed_(0.0f), damage_(0),
+    : mode_(ProjectileMode::Homing), position_(0.0f), previous_position_(0.0f), target_position_(0.0f), direction_(0.0f), speed_(0.0f), damage_(0),
       color_(0.0f, 1.0f, 1.0f), // Cyan color like in TRON
       initialized_(false), active_(false), has_hit_target_(false),
-      lifetime_(3.0f), current_lifetime_(0.0f), target_enemy_(nullptr) {
+      lifetime_(kDefaultLifetime), launch_time_(0.0), hit_time_(0.0), sim_clock_(nullptr), target_enemy_id_(0), reserved_damage_(0.0f), effects_(0) {
 }
 
 Projectile::~Projectile() {
+    if (sim_clock_) {
+        sim_clock_->Cancel(expiry_timer_);
+        sim_clock_->Cancel(hit_timer_);
+    }
 }
 
-bool Projectile::Initialize(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, Enemy* target_enemy) {
+bool Projectile::Initialize(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, uint32_t target_enemy_id) {
+    mode_ = ProjectileMode::Homing;
     position_ = start_position;
+    previous_position_ = start_position;
     target_position_ = target_position;
     speed_ = speed;
     damage_ = damage;
-    target_enemy_ = target_enemy;
+    target_enemy_id_ = target_enemy_id;
     
     // Calculate direction to target
     direction_ = target_position - start_position;
@@ -34,7 +41,6 @@ bool Projectile::Initialize(const glm::vec3& start_position, const glm::vec3& ta
     initialized_ = true;
     active_ = true;
     has_hit_target_ = false;
-    current_lifetime_ = 0.0f;
     
     std::cout << "Projectile initialized from (" << start_position.x << ", " << start_position.y << ", " << start_position.z 
               << ") to (" << target_position.x << ", " << target_position.y << ", " << target_position.z << ")" << std::endl;
@@ -42,35 +48,108 @@ bool Projectile::Initialize(const glm::vec3& start_position, const glm::vec3& ta
     return true;
 }
 
-void Projectile::Update(float delta_time) {
-    if (!active_ || !initialized_) return;
+bool Projectile::InitializeBallistic(const glm::vec3& start_position, const glm::vec3& direction, float speed, int damage,
+                                     uint32_t target_enemy_id, double launch_time) {
+    mode_ = ProjectileMode::Ballistic;
+    position_ = start_position;
+    previous_position_ = start_position;
+    direction_ = direction;
+    speed_ = speed;
+    damage_ = damage;
+    target_enemy_id_ = target_enemy_id;
+    launch_time_ = launch_time;
+    target_position_ = GetPositionAt(launch_time_ + lifetime_);
     
-    // Update lifetime
-    current_lifetime_ += delta_time;
+    initialized_ = true;
+    active_ = true;
+    has_hit_target_ = false;
     
-    // Check if projectile has expired
-    if (current_lifetime_ >= lifetime_) {
-        active_ = false;
-        std::cout << "Projectile expired after " << current_lifetime_ << " seconds" << std::endl;
-        return;
+    return true;
+}
+
+bool Projectile::InitializeStraight(const ShotSpec& shot) {
+    mode_ = ProjectileMode::Straight;
+    position_ = shot.origin;
+    previous_position_ = shot.origin;
+    direction_ = shot.direction;
+    speed_ = shot.speed;
+    damage_ = shot.damage;
+    effects_ = shot.effects;
+    lifetime_ = shot.lifetime;
+    target_enemy_id_ = 0;
+    target_position_ = shot.origin + shot.direction * shot.speed * shot.lifetime;
+    
+    pierced_ids_.clear();
+    if (shot.ignore_enemy_id != 0) {
+        pierced_ids_.push_back(shot.ignore_enemy_id);
     }
     
-    // If enemy is still alive, continue homing towards its current position
-    if (target_enemy_ && target_enemy_->IsAlive()) {
-        SetTarget(target_enemy_->GetPosition());
+    initialized_ = true;
+    active_ = true;
+    has_hit_target_ = false;
+    
+    return true;
+}
+
+void Projectile::Update(float delta_time) {
+    // Ballistic flight is closed-form; nothing to simulate per tick
+    if (!active_ || !initialized_ || mode_ == ProjectileMode::Ballistic) return;
+    
+    // Straight: unguided, the collision stage tests the segment swept this tick
+    if (mode_ == ProjectileMode::Straight) {
+        previous_position_ = position_;
+        position_ += direction_ * speed_ * delta_time;
+        return;
     }
+    
+    // Homing: ProjectileManager retargets us to the enemy's live position before this call
 
     // Move projectile towards current target_position_
+    previous_position_ = position_;
     position_ += direction_ * speed_ * delta_time;
     
-    // Mark as reached when we arrive near the intended destination.
-    // Deactivation and damage resolution are handled in ProjectileManager.
-    float distance_to_target = glm::length(target_position_ - position_);
-    if (distance_to_target <= 1.2f) {
+    // Mark as reached when we pass near the intended destination during this tick (swept,
+    // so a large timestep can't step over it). Damage resolution is handled in ProjectileManager.
+    float contact_time = 0.0f;
+    if (Math::SweptSphereContactTime(previous_position_ - target_position_, direction_ * speed_, 1.2f, delta_time, contact_time)) {
         has_hit_target_ = true;
     }
 }
 
+void Projectile::ContinueStraight(double time) {
+    if (mode_ != ProjectileMode::Ballistic) return;
+    
+    position_ = GetPositionAt(time);
+    previous_position_ = position_;
+    mode_ = ProjectileMode::Straight;
+}
+
+void Projectile::OnExpired() {
+    expiry_timer_ = SimClock::TimerHandle();
+    if (!active_) return;
+    
+    active_ = false;
+    std::cout << "Projectile expired after " << lifetime_ << " seconds" << std::endl;
+}
+
+glm::vec3 Projectile::GetPosition() const {
+    if (mode_ == ProjectileMode::Ballistic && sim_clock_) {
+        return GetPositionAt(sim_clock_->GetTime());
+    }
+    return position_;
+}
+
+glm::vec3 Projectile::GetPositionAt(double time) const {
+    if (mode_ != ProjectileMode::Ballistic) return position_;
+    
+    float elapsed = static_cast<float>(time - launch_time_);
+    return position_ + direction_ * speed_ * glm::max(0.0f, elapsed);
+}
+
+bool Projectile::HasPierced(uint32_t enemy_id) const {
+    return std::find(pierced_ids_.begin(), pierced_ids_.end(), enemy_id) != pierced_ids_.end();
+}
+
 void Projectile::Render() {
     // Rendering is handled by the Game class
 }
@@ -102,6 +181,6 @@ void Projectile::UpdateTarget(const glm::vec3& new_target_position) {
 bool Projectile::CheckHit(const glm::vec3& target_position, float hit_radius) const {
     if (!active_) return false;
     
-    float distance = glm::length(target_position - position_);
+    float distance = glm::length(target_position - GetPosition());
     return distance <= hit_radius;
 }
@@ -1,26 +1,62 @@
-// Homing projectile fired by turrets
+// Projectile fired by turrets (homing, ballistic or straight)
 #pragma once
 
+#include "sim_clock.h"
+#include "item.h"
 #include <glm/glm.hpp>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
-class Enemy; // forward declaration
+// Homing projectiles steer toward their target every tick and are hit-tested each tick.
+// Ballistic projectiles fly a straight line solved at fire time: their hit is a scheduled
+// event and their position is only evaluated for rendering. The target can leave the
+// predicted course in flight, so the hit is checked when it falls due; a shot that no
+// longer connects carries on as a straight projectile.
+// Straight projectiles (piercing shots, multishot side shots, split fragments) fly
+// unguided and are hit-tested by the collision stage until they expire.
+enum class ProjectileMode {
+    Homing,
+    Ballistic,
+    Straight
+};
+
+// Parameters of an unguided shot, used to spawn straight projectiles in bulk
+struct ShotSpec {
+    glm::vec3 origin;
+    glm::vec3 direction;        // Normalized
+    float speed;
+    int damage;
+    EffectMask effects;
+    float lifetime;
+    uint32_t ignore_enemy_id;   // Enemy the shot must not hit (0 = none)
+};
 
 class Projectile {
 public:
+    static constexpr float kDefaultLifetime = 3.0f;
+
     Projectile();
     ~Projectile();
 
-    bool Initialize(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, Enemy* target_enemy);
+    bool Initialize(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, uint32_t target_enemy_id);
+    bool InitializeBallistic(const glm::vec3& start_position, const glm::vec3& direction, float speed, int damage,
+                             uint32_t target_enemy_id, double launch_time);
+    bool InitializeStraight(const ShotSpec& shot);
     void Update(float delta_time);
     void Render(); // Placeholder, actual rendering in Game class
 
     // Getters
-    const glm::vec3& GetPosition() const { return position_; }
+    glm::vec3 GetPosition() const; // Ballistic: evaluated at the current sim time
+    glm::vec3 GetPositionAt(double time) const;
+    const glm::vec3& GetPreviousPosition() const { return previous_position_; } // Homing/straight: position before the last Update
+    const glm::vec3& GetDirection() const { return direction_; }
+    float GetSpeed() const { return speed_; }
     const glm::vec3& GetColor() const { return color_; }
     bool IsActive() const { return active_; }
     bool HasHitTarget() const { return has_hit_target_; }
     int GetDamage() const { return damage_; }
+    ProjectileMode GetMode() const { return mode_; }
 
     // Target management
     void SetTarget(const glm::vec3& target_position);
@@ -28,23 +64,59 @@ public:
     bool CheckHit(const glm::vec3& target_position, float hit_radius) const;
     void SetActive(bool active) { active_ = active; }
 
-    // Target ownership
-    Enemy* GetTargetEnemy() const { return target_enemy_; }
+    // Target is referenced by id: the enemy may be destroyed while the projectile is in flight
+    uint32_t GetTargetEnemyId() const { return target_enemy_id_; }
+    
+    // Damage reserved on the target enemy while in flight (released on hit, miss or expiry)
+    float GetReservedDamage() const { return reserved_damage_; }
+    void SetReservedDamage(float amount) { reserved_damage_ = amount; }
+
+    // Lifetime expiry and ballistic hits are scheduled on the sim clock instead of polled per frame
+    float GetLifetime() const { return lifetime_; }
+    void SetLifetime(float lifetime) { lifetime_ = lifetime; }
+    void SetSimClock(SimClock* sim_clock) { sim_clock_ = sim_clock; }
+    void SetExpiryTimer(SimClock::TimerHandle timer) { expiry_timer_ = timer; }
+    void SetHitTimer(SimClock::TimerHandle timer, double hit_time) { hit_timer_ = timer; hit_time_ = hit_time; }
+    double GetHitTime() const { return hit_time_; } // Ballistic: sim time of the predicted contact
+    void OnExpired();
+    void OnHitDue() { hit_timer_ = SimClock::TimerHandle(); }
+
+    // Ballistic shot whose predicted hit went stale: continue as a straight projectile
+    // from where the line was at `time`, so the collision stage takes over
+    void ContinueStraight(double time);
+
+    // Legendary effects carried from the firing turret
+    void SetEffects(EffectMask effects) { effects_ = effects; }
+    EffectMask GetEffects() const { return effects_; }
+    bool IsPiercing() const { return HasEffect(effects_, LegendaryEffect::Piercing); }
+
+    // Enemies already hit, so a piercing shot damages each enemy once
+    bool HasPierced(uint32_t enemy_id) const;
+    void AddPierced(uint32_t enemy_id) { pierced_ids_.push_back(enemy_id); }
 
 private:
-    glm::vec3 position_;
+    ProjectileMode mode_;
+    glm::vec3 position_;        // Homing: current position; ballistic: launch position
+    glm::vec3 previous_position_;
     glm::vec3 target_position_;
     glm::vec3 direction_;
     float speed_;
     int damage_;
     glm::vec3 color_;
-    
+
     bool initialized_;
     bool active_;
     bool has_hit_target_;
-    
+
     float lifetime_; // Maximum time before projectile disappears
-    float current_lifetime_;
+    double launch_time_; // Sim time the ballistic shot was fired
+    double hit_time_;    // Sim time of the predicted ballistic contact
+    SimClock* sim_clock_;
+    SimClock::TimerHandle expiry_timer_;
+    SimClock::TimerHandle hit_timer_;
 
-    Enemy* target_enemy_;
+    uint32_t target_enemy_id_;
+    float reserved_damage_;
+    EffectMask effects_;
+    std::vector<uint32_t> pierced_ids_; // Few entries: linear search beats a set
 };
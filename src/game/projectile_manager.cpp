@@ -2,15 +2,21 @@
 #include "projectile_manager.h"
 #include "projectile.h"
 #include "enemy.h"
-#include "wave_manager.h"
+#include "damage_system.h"
+#include "collision_system.h"
+#include "utils/debug_draw.h"
+#include "utils/math.h"
+#include "utils/metrics.h"
 #include <iostream>
 #include <limits>
 
 ProjectileManager::ProjectileManager()
-    : wave_manager_(nullptr)
+    : damage_system_(nullptr)
+    , sim_clock_(nullptr)
     , default_speed_(30.0f)
     , default_damage_(3)  // Снижено примерно в 10 раз (25 -> 3)
-    , default_color_(0.0f, 1.0f, 1.0f) {
+    , default_color_(0.0f, 1.0f, 1.0f)
+    , enemy_lookup_built_(false) {
 }
 
 ProjectileManager::~ProjectileManager() {
@@ -24,53 +30,296 @@ bool ProjectileManager::Initialize() {
 }
 
 void ProjectileManager::Update(float delta_time, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    enemy_lookup_built_ = false;
+    
+    if (sim_clock_) {
+        // Resolve ballistic hits predicted for this tick. The prediction assumed the
+        // target kept its course; waypoints, slows, stuns and crowd spacing can all move
+        // it off, so the hit only lands if both are still in contact at the predicted time.
+        for (void* owner : sim_clock_->GetDue(SimTimer::ProjectileHit)) {
+            Projectile* projectile = static_cast<Projectile*>(owner);
+            projectile->OnHitDue();
+            if (!projectile->IsActive()) continue;
+            
+            double hit_time = projectile->GetHitTime();
+            uint32_t enemy_index = FindEnemyIndex(projectile->GetTargetEnemyId(), enemies);
+            Enemy* target = enemy_index != kNoEnemy ? enemies[enemy_index].get() : nullptr;
+            if (target && target->IsAlive()) {
+                float distance = glm::length(projectile->GetPositionAt(hit_time) - target->GetPositionAt(hit_time));
+                if (distance <= kHitRadius + kHitTolerance) {
+                    ApplyHit(*projectile, *target, enemy_index, enemies);
+                    continue;
+                }
+                Metrics::Add("projectiles.ballistic_stale");
+            } else {
+                Metrics::Add("projectiles.wasted");
+            }
+            
+            // Missed: fly on as a straight shot from the start of this tick, so the
+            // collision stage sweeps the stretch past the predicted contact. The target
+            // can be engaged again.
+            ReleaseReservation(*projectile, enemies);
+            projectile->ContinueStraight(sim_clock_->GetPreviousTime());
+        }
+        
+        // Expire projectiles whose lifetime timer fired this tick; a miss frees its
+        // reservation so the target can be engaged again
+        for (void* owner : sim_clock_->GetDue(SimTimer::ProjectileExpire)) {
+            Projectile* projectile = static_cast<Projectile*>(owner);
+            projectile->OnExpired();
+            ReleaseReservation(*projectile, enemies);
+        }
+    }
+    
     // Update existing projectiles
     for (auto it = projectiles_.begin(); it != projectiles_.end();) {
         auto& projectile = *it;
         
         if (projectile && projectile->IsActive()) {
-            projectile->Update(delta_time);
+            // Ballistic projectiles are render-only between their fire and hit events
+            if (projectile->GetMode() == ProjectileMode::Ballistic) {
+                ++it;
+                continue;
+            }
             
-            // Semi-homing: while enemy alive, projectile tracks it; if enemy died,
-            // projectile keeps last known target position and finishes flight.
-            if (projectile->HasHitTarget()) {
-                bool damaged = false;
-                for (const auto& enemy : enemies) {
-                    if (enemy && enemy->IsAlive()) {
-                        if (projectile->CheckHit(enemy->GetPosition(), 1.2f)) {
-                            glm::vec3 enemy_pos = enemy->GetPosition(); // Save position before damage
-                            enemy->TakeDamage(projectile->GetDamage());
-                            std::cout << "Projectile hit enemy for " << projectile->GetDamage() << " damage!" << std::endl;
-                            if (!enemy->IsAlive() && wave_manager_) {
-                                wave_manager_->OnEnemyDestroyed(enemy_pos); // Pass enemy death position
-                            }
-                            damaged = true;
-                            break;
-                        }
-                    }
+            // If enemy is still alive, continue homing towards its current position
+            if (projectile->GetMode() == ProjectileMode::Homing) {
+                Enemy* target = FindEnemy(projectile->GetTargetEnemyId(), enemies);
+                if (target && target->IsAlive()) {
+                    projectile->SetTarget(target->GetPosition());
                 }
-                // Deactivate regardless of whether we damaged something
-                projectile->SetActive(false);
             }
             
+            projectile->Update(delta_time);
+            
             ++it;
         } else {
             // Remove inactive projectiles
+            if (projectile) {
+                ReleaseReservation(*projectile, enemies);
+            }
             it = projectiles_.erase(it);
         }
     }
+    
+#ifdef CORE_DEBUG_DRAW
+    if (DebugDraw::IsEnabled(DebugCategory::Projectiles)) {
+        // Where each projectile will be over the next quarter second
+        for (const auto& projectile : projectiles_) {
+            glm::vec3 position = projectile->GetPosition();
+            glm::vec3 ahead = position + projectile->GetDirection() * projectile->GetSpeed() * 0.25f;
+            DebugDraw::Line(DebugCategory::Projectiles, position, ahead, projectile->GetColor());
+        }
+    }
+#endif
+}
+
+void ProjectileManager::ApplyCollisions(const std::vector<CollisionHit>& hits, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    // Hits are ordered by projectile index, so damage lands in a fixed order
+    for (const CollisionHit& hit : hits) {
+        Projectile* projectile = projectiles_[hit.projectile_index].get();
+        Enemy* enemy = enemies[hit.enemy_index].get();
+        if (projectile->IsActive() && enemy->IsAlive()) {
+            ApplyHit(*projectile, *enemy, hit.enemy_index, enemies);
+        }
+    }
+    
+    // Semi-homing: while enemy alive, projectile tracks it; if enemy died,
+    // projectile keeps last known target position and finishes flight there.
+    for (const auto& projectile : projectiles_) {
+        if (projectile->IsActive() && projectile->GetMode() == ProjectileMode::Homing && projectile->HasHitTarget()) {
+            projectile->SetActive(false);
+            ReleaseReservation(*projectile, enemies);
+            Metrics::Add("projectiles.wasted");
+        }
+    }
+    
+    // On-hit effects of every hit this tick (scheduled and collision), then split fragments
+    if (effect_system_.GetQueuedCount() > 0) {
+        shot_scratch_.clear();
+        effect_system_.Resolve(enemies, shot_scratch_);
+        CreateStraightProjectiles(shot_scratch_);
+    }
+}
+
+void ProjectileManager::SetDamageSystem(DamageSystem* damage_system) {
+    damage_system_ = damage_system;
+    effect_system_.SetDamageSystem(damage_system);
 }
 
 void ProjectileManager::Render() {
     // Rendering is handled by the Game class
 }
 
-void ProjectileManager::CreateProjectile(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, Enemy* target_enemy) {
+Projectile* ProjectileManager::CreateProjectile(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, const Enemy* target_enemy) {
+    auto projectile = std::make_unique<Projectile>();
+    uint32_t target_id = target_enemy ? target_enemy->GetID() : 0;
+    if (!projectile->Initialize(start_position, target_position, speed, damage, target_id)) return nullptr;
+    
+    ScheduleExpiry(*projectile);
+    projectiles_.push_back(std::move(projectile));
+    std::cout << "Created projectile #" << projectiles_.size() 
+              << " from (" << start_position.x << ", " << start_position.y << ", " << start_position.z << ")"
+              << " to (" << target_position.x << ", " << target_position.y << ", " << target_position.z << ")" << std::endl;
+    return projectiles_.back().get();
+}
+
+Projectile* ProjectileManager::CreateBallisticProjectile(const glm::vec3& start_position, const Enemy& target, float speed, int damage) {
     auto projectile = std::make_unique<Projectile>();
-    if (projectile->Initialize(start_position, target_position, speed, damage, target_enemy)) {
-        projectiles_.push_back(std::move(projectile));
-        std::cout << "Created projectile #" << projectiles_.size() 
-                  << " from (" << start_position.x << ", " << start_position.y << ", " << start_position.z << ")"
-                  << " to (" << target_position.x << ", " << target_position.y << ", " << target_position.z << ")" << std::endl;
+    
+    glm::vec3 direction(0.0f);
+    float intercept_time = 0.0f;
+    if (!sim_clock_ || !SolveAim(start_position, target, speed, projectile->GetLifetime(), direction, intercept_time)) {
+        return CreateProjectile(start_position, target.GetPosition(), speed, damage, &target);
     }
+    
+    // The hit lands when the spheres first touch, slightly before the centers meet
+    glm::vec3 relative_position = target.GetPosition() - start_position;
+    float hit_time = intercept_time;
+    Math::SweptSphereContactTime(relative_position, target.GetVelocity() - direction * speed, kHitRadius, intercept_time, hit_time);
+    
+    if (!projectile->InitializeBallistic(start_position, direction, speed, damage, target.GetID(), sim_clock_->GetTime())) return nullptr;
+    
+    ScheduleExpiry(*projectile);
+    double now = sim_clock_->GetTime();
+    projectile->SetHitTimer(sim_clock_->ScheduleAt(SimTimer::ProjectileHit, now + hit_time, projectile.get()), now + hit_time);
+    projectiles_.push_back(std::move(projectile));
+    std::cout << "Created ballistic projectile #" << projectiles_.size() 
+              << ", predicted hit in " << hit_time << " seconds" << std::endl;
+    return projectiles_.back().get();
+}
+
+void ProjectileManager::CreateStraightProjectiles(const std::vector<ShotSpec>& shots) {
+    if (shots.empty()) return;
+    
+    projectiles_.reserve(projectiles_.size() + shots.size());
+    for (const ShotSpec& shot : shots) {
+        auto projectile = std::make_unique<Projectile>();
+        if (projectile->InitializeStraight(shot)) {
+            ScheduleExpiry(*projectile);
+            projectiles_.push_back(std::move(projectile));
+        }
+    }
+    Metrics::Add("projectiles.straight_spawned", static_cast<double>(shots.size()));
+}
+
+void ProjectileManager::FireAt(const glm::vec3& start_position, Enemy& target, float speed, int damage, EffectMask effects, bool homing) {
+    glm::vec3 direction(0.0f);
+    float intercept_time = 0.0f;
+    if (!SolveAim(start_position, target, speed, Projectile::kDefaultLifetime, direction, intercept_time)) {
+        // No intercept: aim at the current position
+        glm::vec3 to_target = target.GetPosition() - start_position;
+        direction = glm::length(to_target) > 0.001f ? glm::normalize(to_target) : glm::vec3(1.0f, 0.0f, 0.0f);
+    }
+    
+    shot_scratch_.clear();
+    if (HasEffect(effects, LegendaryEffect::Piercing)) {
+        // Piercing shots fly the aim line and hit everything on it, so no hit is scheduled
+        shot_scratch_.push_back({start_position, direction, speed, damage, effects, Projectile::kDefaultLifetime, 0});
+    } else {
+        Projectile* projectile = homing
+            ? CreateProjectile(start_position, target.GetPosition(), speed, damage, &target)
+            : CreateBallisticProjectile(start_position, target, speed, damage);
+        if (projectile) {
+            projectile->SetEffects(effects);
+            projectile->SetReservedDamage(static_cast<float>(damage));
+            target.ReserveDamage(static_cast<float>(damage));
+            Metrics::Add("projectiles.fired");
+        }
+    }
+    
+    if (HasEffect(effects, LegendaryEffect::Multishot)) {
+        // Side shots fan out around the main shot and don't multiply again
+        EffectMask side_effects = effects & ~EffectBit(LegendaryEffect::Multishot);
+        for (int i = 0; i < kMultishotExtraShots; ++i) {
+            float side = (i % 2 == 0) ? 1.0f : -1.0f;
+            float angle = side * kMultishotAngleDegrees * static_cast<float>(i / 2 + 1);
+            shot_scratch_.push_back({start_position, EffectSystem::RotateAroundUp(direction, angle), speed, damage,
+                                     side_effects, Projectile::kDefaultLifetime, 0});
+        }
+        Metrics::Add("effects.multishot_volleys");
+    }
+    
+    CreateStraightProjectiles(shot_scratch_);
+}
+
+uint32_t ProjectileManager::FindEnemyIndex(uint32_t id, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    if (id == 0) return kNoEnemy;
+    
+    if (!enemy_lookup_built_) {
+        enemy_lookup_.clear();
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            if (enemies[i]) {
+                enemy_lookup_[enemies[i]->GetID()] = static_cast<uint32_t>(i);
+            }
+        }
+        enemy_lookup_built_ = true;
+    }
+    
+    auto it = enemy_lookup_.find(id);
+    return it != enemy_lookup_.end() ? it->second : kNoEnemy;
+}
+
+Enemy* ProjectileManager::FindEnemy(uint32_t id, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    uint32_t index = FindEnemyIndex(id, enemies);
+    return index != kNoEnemy ? enemies[index].get() : nullptr;
+}
+
+bool ProjectileManager::SolveAim(const glm::vec3& start_position, const Enemy& target, float speed, float max_time,
+                                 glm::vec3& out_direction, float& out_time) const {
+    // Intercept with the target's current motion segment. It holds only while the target
+    // keeps that segment: a new waypoint, a slow or stun, or a separation push can move it
+    // off, so Update re-checks ballistic hits against kHitRadius when they fall due.
+    glm::vec3 relative_position = target.GetPosition() - start_position;
+    glm::vec3 target_velocity = target.GetVelocity();
+    if (!Math::SolveInterceptTime(relative_position, target_velocity, speed, out_time) || out_time > max_time) {
+        return false;
+    }
+    
+    glm::vec3 aim = relative_position + target_velocity * out_time;
+    if (glm::length(aim) < 0.001f) return false;
+    
+    out_direction = glm::normalize(aim);
+    return true;
+}
+
+void ProjectileManager::ApplyHit(Projectile& projectile, Enemy& enemy, uint32_t enemy_index, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    // The damage now sits in the buffer; drop the in-flight reservation (which may be on
+    // another enemy if a homing shot hit something on the way)
+    ReleaseReservation(projectile, enemies);
+    
+    if (damage_system_) {
+        damage_system_->AddDamage(enemy.GetID(), static_cast<float>(projectile.GetDamage()));
+    }
+    std::cout << "Projectile hit enemy for " << projectile.GetDamage() << " damage!" << std::endl;
+    
+    if (EffectSystem::HasOnHitEffects(projectile.GetEffects())) {
+        effect_system_.QueueHit({projectile.GetEffects(), enemy_index, enemy.GetPosition(), projectile.GetDirection(),
+                                 projectile.GetSpeed(), static_cast<float>(projectile.GetDamage())});
+    }
+    
+    // Piercing shots keep flying; remember the enemy so it is only hit once
+    if (projectile.IsPiercing()) {
+        projectile.AddPierced(enemy.GetID());
+        return;
+    }
+    projectile.SetActive(false);
+}
+
+void ProjectileManager::ReleaseReservation(Projectile& projectile, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    float reserved = projectile.GetReservedDamage();
+    if (reserved <= 0.0f) return;
+    
+    Enemy* target = FindEnemy(projectile.GetTargetEnemyId(), enemies);
+    if (target) {
+        target->ReleaseDamage(reserved);
+    }
+    projectile.SetReservedDamage(0.0f);
+}
+
+void ProjectileManager::ScheduleExpiry(Projectile& projectile) {
+    if (!sim_clock_) return;
+    
+    projectile.SetSimClock(sim_clock_);
+    projectile.SetExpiryTimer(sim_clock_->Schedule(SimTimer::ProjectileExpire, projectile.GetLifetime(), &projectile));
 }
@@ -3,11 +3,15 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <glm/glm.hpp>
 #include "projectile.h"
 #include "enemy.h"
+#include "effect_system.h"
 
-class WaveManager;
+class DamageSystem;
+class SpatialGrid;
+struct CollisionHit;
 
 class ProjectileManager {
 public:
@@ -15,25 +19,72 @@ public:
     ~ProjectileManager();
 
     bool Initialize();
+    // Resolve scheduled events and integrate homing projectiles (collision runs as a separate stage)
     void Update(float delta_time, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    
+    // Damage step: apply the hits found by the collision stage this tick
+    void ApplyCollisions(const std::vector<CollisionHit>& hits, const std::vector<std::unique_ptr<Enemy>>& enemies);
     void Render(); // Placeholder, actual rendering in Game class
 
     // Projectile creation
-    void CreateProjectile(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, Enemy* target_enemy);
+    Projectile* CreateProjectile(const glm::vec3& start_position, const glm::vec3& target_position, float speed, int damage, const Enemy* target_enemy);
+    
+    // Fire a straight shot at the predicted intercept with `target` and schedule the hit.
+    // The hit lands only if the target is still in contact when it falls due; otherwise
+    // the shot continues as a straight projectile. Falls back to a homing projectile when
+    // no intercept exists within the projectile lifetime.
+    Projectile* CreateBallisticProjectile(const glm::vec3& start_position, const Enemy& target, float speed, int damage);
+    
+    // Spawn unguided projectiles in one batch (multishot volleys, split fragments)
+    void CreateStraightProjectiles(const std::vector<ShotSpec>& shots);
     
-    // Wave manager integration
-    void SetWaveManager(WaveManager* wave_manager) { wave_manager_ = wave_manager; }
+    // Turret shot carrying legendary effects: Piercing fires a straight shot along the
+    // aim line, otherwise homing or ballistic; Multishot adds side shots to the volley.
+    // The main homing/ballistic shot reserves its damage on `target` until it resolves.
+    void FireAt(const glm::vec3& start_position, Enemy& target, float speed, int damage, EffectMask effects, bool homing);
+    
+    // Hits are queued on the damage system and applied once per tick
+    void SetDamageSystem(DamageSystem* damage_system);
+    void SetSimClock(SimClock* sim_clock) { sim_clock_ = sim_clock; }
+    // Enemy grid for area and chain effects; must be built from the list passed to Update
+    void SetEnemyGrid(const SpatialGrid* grid) { effect_system_.SetEnemyGrid(grid); }
+    // Receives the status effects of Frost, Burn and Stun hits
+    void SetStatusSystem(StatusSystem* status_system) { effect_system_.SetStatusSystem(status_system); }
     
     // Getters
     const std::vector<std::unique_ptr<Projectile>>& GetProjectiles() const { return projectiles_; }
     int GetProjectileCount() const { return projectiles_.size(); }
 
+    static constexpr float kHitRadius = 1.2f;
+    static constexpr float kHitTolerance = 0.05f; // Float slack on a ballistic contact that still holds
+    static constexpr int kMultishotExtraShots = 2;
+    static constexpr float kMultishotAngleDegrees = 15.0f;
+
 private:
     std::vector<std::unique_ptr<Projectile>> projectiles_;
-    WaveManager* wave_manager_;
+    DamageSystem* damage_system_;
+    SimClock* sim_clock_;
     
     // Projectile properties
     float default_speed_;
     int default_damage_;
     glm::vec3 default_color_;
+    
+    // On-hit effects of this tick's hits, resolved after the collision stage
+    EffectSystem effect_system_;
+    std::vector<ShotSpec> shot_scratch_;
+    
+    // Id -> enemy index lookup, built at most once per Update when a projectile needs its target
+    std::unordered_map<uint32_t, uint32_t> enemy_lookup_;
+    bool enemy_lookup_built_;
+    
+    static constexpr uint32_t kNoEnemy = 0xFFFFFFFFu;
+    
+    uint32_t FindEnemyIndex(uint32_t id, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    Enemy* FindEnemy(uint32_t id, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    bool SolveAim(const glm::vec3& start_position, const Enemy& target, float speed, float max_time,
+                  glm::vec3& out_direction, float& out_time) const;
+    void ApplyHit(Projectile& projectile, Enemy& enemy, uint32_t enemy_index, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    void ReleaseReservation(Projectile& projectile, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    void ScheduleExpiry(Projectile& projectile);
 };
@@ -0,0 +1,160 @@
+// Implementation of crowd separation for enemies
+#include "separation_system.h"
+#include "enemy.h"
+#include "targeting_index.h"
+#include "utils/metrics.h"
+#include <algorithm>
+#include <iostream>
+
+SeparationSystem::SeparationSystem()
+    : min_bounds_(-40.0f)
+    , max_bounds_(40.0f)
+    , targeting_index_(nullptr)
+    , cursor_(0)
+    , last_updated_count_(0)
+    , snapshot_age_(0) {
+}
+
+bool SeparationSystem::Initialize(const glm::vec3& min_bounds, const glm::vec3& max_bounds) {
+    min_bounds_ = min_bounds;
+    max_bounds_ = max_bounds;
+    if (!grid_.Initialize(min_bounds_, max_bounds_, settings_.radius)) {
+        std::cerr << "Failed to initialize separation grid!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void SeparationSystem::SetSettings(const SeparationSettings& settings) {
+    bool resize_grid = settings.radius != settings_.radius;
+    settings_ = settings;
+    settings_.max_neighbors = std::max(0, settings_.max_neighbors);
+    settings_.agent_budget = std::max<size_t>(1, settings_.agent_budget);
+    if (resize_grid) {
+        grid_.Initialize(min_bounds_, max_bounds_, settings_.radius);
+        snapshot_ids_.clear();
+    }
+    if (targeting_index_) {
+        targeting_index_->SetTrackDeviation(settings_.max_offset, settings_.max_speed);
+    }
+}
+
+void SeparationSystem::SetTargetingIndex(TargetingIndex* targeting_index) {
+    targeting_index_ = targeting_index;
+    if (targeting_index_) {
+        targeting_index_->SetTrackDeviation(settings_.max_offset, settings_.max_speed);
+    }
+}
+
+void SeparationSystem::Update(float delta_time, const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    last_updated_count_ = 0;
+    size_t count = enemies.size();
+    if (count == 0 || delta_time <= 0.0f) return;
+
+    // Retake the snapshot once the last one has served a full round of agents
+    size_t budget = std::min(count, settings_.agent_budget);
+    if (snapshot_ids_.empty() || snapshot_age_ * budget >= count) {
+        positions_.resize(count);
+        snapshot_ids_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            positions_[i] = enemies[i]->GetPosition();
+            snapshot_ids_[i] = enemies[i]->GetID();
+        }
+        grid_.Build(positions_);
+        snapshot_age_ = 0;
+        Metrics::Add("separation.snapshots");
+    }
+    snapshot_age_++;
+
+    size_t max_neighbors = static_cast<size_t>(settings_.max_neighbors);
+    offset_x_.resize(max_neighbors);
+    offset_y_.resize(max_neighbors);
+    offset_z_.resize(max_neighbors);
+    weights_.resize(max_neighbors);
+
+    // Agents skipped this tick catch up with a longer step next time, but never move
+    // faster than max_speed, so the targeting speed allowance stays a true bound
+    float step = delta_time * static_cast<float>(count) / static_cast<float>(budget);
+    float max_step = settings_.max_speed * delta_time;
+    size_t neighbor_total = 0;
+    if (cursor_ >= count) cursor_ = 0;
+
+    for (size_t visited = 0; visited < budget; ++visited) {
+        size_t index = (cursor_ + visited) % count;
+        Enemy* enemy = enemies[index].get();
+        if (!enemy->IsAlive()) continue;
+
+        // One extra slot: the agent itself is among the hits
+        glm::vec3 position = enemy->GetPosition();
+        neighbors_.clear();
+        grid_.QueryRadiusCapped(position, settings_.radius, max_neighbors + 1, neighbors_);
+
+        size_t neighbor_count = 0;
+        for (uint32_t neighbor : neighbors_) {
+            if (snapshot_ids_[neighbor] == enemy->GetID() || neighbor_count == max_neighbors) continue;
+            glm::vec3 offset = position - positions_[neighbor];
+            offset_x_[neighbor_count] = offset.x;
+            offset_y_[neighbor_count] = offset.y;
+            offset_z_[neighbor_count] = offset.z;
+            neighbor_count++;
+        }
+        if (neighbor_count == 0) continue;
+        neighbor_total += neighbor_count;
+
+        glm::vec3 velocity = ComputeForce(neighbor_count);
+        float speed = glm::length(velocity);
+        if (speed > settings_.max_speed) {
+            velocity *= settings_.max_speed / speed;
+        }
+
+        // Sideways only: progress along the track (and so the arrival time) is unchanged
+        glm::vec3 delta = velocity * step;
+        glm::vec3 track = enemy->GetVelocity();
+        float track_speed = glm::length(track);
+        if (track_speed > 0.0f) {
+            glm::vec3 forward = track / track_speed;
+            delta -= forward * glm::dot(delta, forward);
+        }
+        float delta_length = glm::length(delta);
+        if (delta_length > max_step) {
+            delta *= max_step / delta_length;
+        }
+
+        glm::vec3 separation = enemy->GetSeparationOffset() + delta;
+        float separation_length = glm::length(separation);
+        if (separation_length > settings_.max_offset) {
+            separation *= settings_.max_offset / separation_length;
+        }
+        enemy->SetSeparationOffset(separation);
+        last_updated_count_++;
+    }
+    cursor_ = (cursor_ + budget) % count;
+
+    Metrics::Add("separation.agents", static_cast<double>(last_updated_count_));
+    Metrics::Add("separation.neighbors", static_cast<double>(neighbor_total));
+}
+
+glm::vec3 SeparationSystem::ComputeForce(size_t count) {
+    // Separation falls off as 1/distance; cohesion pulls toward the neighbor centroid
+    // (the negated mean offset). The weight loop is branch-free over contiguous arrays,
+    // so it vectorizes without relaxed floating-point flags; the sums stay ordered.
+    const float kMinDistanceSq = 1e-4f;
+    const float* x = offset_x_.data();
+    const float* y = offset_y_.data();
+    const float* z = offset_z_.data();
+    float* weight = weights_.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        weight[i] = 1.0f / (x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + kMinDistanceSq);
+    }
+
+    glm::vec3 push(0.0f);
+    glm::vec3 sum(0.0f);
+    for (size_t i = 0; i < count; ++i) {
+        push += glm::vec3(x[i], y[i], z[i]) * weight[i];
+        sum += glm::vec3(x[i], y[i], z[i]);
+    }
+
+    glm::vec3 centroid_offset = -sum / static_cast<float>(count);
+    return push * settings_.separation_weight + centroid_offset * settings_.cohesion_weight;
+}
@@ -0,0 +1,73 @@
+// Crowd separation/cohesion for enemies converging on the core
+#pragma once
+
+#include "spatial_grid.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Enemy;
+class TargetingIndex;
+
+struct SeparationSettings {
+    float radius = 2.0f;            // Neighbor query radius (also the grid cell size)
+    int max_neighbors = 8;          // Neighbors considered per agent
+    float separation_weight = 4.0f;
+    float cohesion_weight = 0.5f;
+    float max_speed = 2.0f;         // Fastest an agent drifts off its track
+    float max_offset = 3.0f;        // Farthest an agent drifts off its track
+    size_t agent_budget = 8192;     // Agents updated per tick; the rest wait their turn
+};
+
+// Enemies all fly at the core, so they pile into one point as they close in. This pass
+// gathers a capped set of neighbors per agent from a grid at the query radius and pushes
+// the agent sideways: away from close neighbors, gently toward the local centroid. The
+// push is stored as the enemy's separation offset, so the closed-form track and its
+// scheduled arrival stay untouched (ballistic shots re-check contact when their hit
+// falls due, so the offset can't fake a hit).
+//
+// Only `agent_budget` agents are visited per tick, round-robin. The grid is a snapshot
+// of every enemy's position, rebuilt once per full round rather than every tick, so
+// gathering it also averages out to about `agent_budget` enemies per tick. Between
+// rebuilds an agent sees its neighbors where the snapshot put them (at most one round
+// old); enemies spawned since then are visited but not yet seen as neighbors.
+class SeparationSystem {
+public:
+    SeparationSystem();
+    ~SeparationSystem() = default;
+
+    bool Initialize(const glm::vec3& min_bounds, const glm::vec3& max_bounds);
+
+    void SetSettings(const SeparationSettings& settings);
+    const SeparationSettings& GetSettings() const { return settings_; }
+
+    // Told how far and how fast enemies may deviate from their tracks
+    void SetTargetingIndex(TargetingIndex* targeting_index);
+
+    void Update(float delta_time, const std::vector<std::unique_ptr<Enemy>>& enemies);
+    size_t GetLastUpdatedCount() const { return last_updated_count_; }
+
+private:
+    SeparationSettings settings_;
+    glm::vec3 min_bounds_;
+    glm::vec3 max_bounds_;
+    SpatialGrid grid_;
+    TargetingIndex* targeting_index_;
+    size_t cursor_;                 // Round-robin start for the next tick
+    size_t last_updated_count_;
+
+    // Neighbor snapshot: positions and ids by grid index
+    std::vector<glm::vec3> positions_;
+    std::vector<uint32_t> snapshot_ids_;
+    size_t snapshot_age_;           // Ticks since the snapshot was taken
+
+    // Scratch
+    std::vector<uint32_t> neighbors_;
+    std::vector<float> offset_x_;   // Neighbor offsets as structure-of-arrays, so the
+    std::vector<float> offset_y_;   // force loop vectorizes
+    std::vector<float> offset_z_;
+    std::vector<float> weights_;
+
+    glm::vec3 ComputeForce(size_t count);
+};
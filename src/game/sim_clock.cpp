@@ -0,0 +1,47 @@
+// Implementation of simulation clock
+#include "sim_clock.h"
+#include <algorithm>
+#include <cmath>
+
+SimClock::SimClock() : time_(0.0), previous_time_(0.0) {
+}
+
+void SimClock::Advance(float delta_time) {
+    for (auto& list : due_) {
+        list.clear();
+    }
+
+    previous_time_ = time_;
+    if (delta_time > 0.0f) {
+        time_ += delta_time;
+    }
+
+    expired_.clear();
+    wheel_.AdvanceTo(static_cast<uint64_t>(time_ / kTickSeconds), expired_);
+
+    for (const auto& timer : expired_) {
+        due_[timer.channel].push_back(timer.payload);
+    }
+}
+
+SimClock::TimerHandle SimClock::Schedule(SimTimer kind, float delay_seconds, void* owner) {
+    long long delay_ticks = std::llround(std::max(0.0f, delay_seconds) / kTickSeconds);
+    if (delay_ticks < 1) delay_ticks = 1;
+    return wheel_.Schedule(wheel_.GetCurrentTick() + static_cast<uint64_t>(delay_ticks), static_cast<uint32_t>(kind), owner);
+}
+
+SimClock::TimerHandle SimClock::ScheduleAt(SimTimer kind, double time, void* owner) {
+    uint64_t due_tick = static_cast<uint64_t>(std::ceil(std::max(0.0, time) / kTickSeconds));
+    due_tick = std::max(due_tick, wheel_.GetCurrentTick() + 1);
+    return wheel_.Schedule(due_tick, static_cast<uint32_t>(kind), owner);
+}
+
+void SimClock::Cancel(TimerHandle& handle) {
+    wheel_.Cancel(handle);
+}
+
+float SimClock::GetRemaining(const TimerHandle& handle) const {
+    if (!wheel_.IsPending(handle)) return 0.0f;
+    double due_time = static_cast<double>(wheel_.GetDueTick(handle)) * kTickSeconds;
+    return static_cast<float>(std::max(0.0, due_time - time_));
+}
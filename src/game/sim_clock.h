@@ -0,0 +1,58 @@
+// Simulation clock with a central timing wheel for gameplay timers
+#pragma once
+
+#include "core/timing_wheel.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Kinds of gameplay timers; each kind gets its own due list per tick
+enum class SimTimer : uint32_t {
+    TurretReady,      // Turret finished reloading (owner: Turret*)
+    ProjectileExpire, // Projectile lifetime ran out (owner: Projectile*)
+    ProjectileHit,    // Ballistic projectile reaches its predicted intercept (owner: Projectile*)
+    NextSpawn,        // Next enemy spawn of a wave or free spawner (owner: system)
+    NextWave,         // Preparation phase finished (owner: WaveManager*)
+    EnemyReachCore,   // Enemy arrives at the core (owner: Enemy*)
+    Count
+};
+
+class SimClock {
+public:
+    using TimerHandle = TimingWheel::Handle;
+
+    // Timer resolution (1 ms)
+    static constexpr double kTickSeconds = 0.001;
+
+    SimClock();
+    ~SimClock() = default;
+
+    // Advance simulation time and collect the timers that became due
+    void Advance(float delta_time);
+
+    // Schedule `kind` to fire after `delay_seconds`; `owner` is handed back in the due list.
+    // Owners must cancel their handles before they are destroyed.
+    TimerHandle Schedule(SimTimer kind, float delay_seconds, void* owner);
+    // Schedule at an absolute sim time; fires on the first tick at or after it
+    TimerHandle ScheduleAt(SimTimer kind, double time, void* owner);
+    void Cancel(TimerHandle& handle);
+    bool IsPending(const TimerHandle& handle) const { return wheel_.IsPending(handle); }
+
+    // Seconds left until a pending timer fires (0 if it is not pending)
+    float GetRemaining(const TimerHandle& handle) const;
+
+    // Owners of timers of `kind` that fired during the last Advance()
+    const std::vector<void*>& GetDue(SimTimer kind) const { return due_[static_cast<size_t>(kind)]; }
+
+    double GetTime() const { return time_; }
+    double GetPreviousTime() const { return previous_time_; } // Time before the last Advance()
+    uint64_t GetTick() const { return wheel_.GetCurrentTick(); }
+    size_t GetPendingCount() const { return wheel_.GetPendingCount(); }
+
+private:
+    TimingWheel wheel_;
+    double time_;
+    double previous_time_;
+    std::array<std::vector<void*>, static_cast<size_t>(SimTimer::Count)> due_;
+    std::vector<TimingWheel::Expired> expired_;
+};
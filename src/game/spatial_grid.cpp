@@ -0,0 +1,200 @@
+// Implementation of uniform grid broadphase
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cstdlib>
+
+SpatialGrid::SpatialGrid()
+    : min_bounds_(0.0f)
+    , cell_size_(1.0f)
+    , inv_cell_size_(1.0f)
+    , dims_(1)
+    , stale_(false) {
+    cell_start_.assign(2, 0);
+}
+
+bool SpatialGrid::Initialize(const glm::vec3& min_bounds, const glm::vec3& max_bounds, float cell_size) {
+    if (cell_size <= 0.0f) return false;
+
+    min_bounds_ = min_bounds;
+    cell_size_ = cell_size;
+    inv_cell_size_ = 1.0f / cell_size;
+
+    glm::vec3 extent = glm::max(max_bounds - min_bounds, glm::vec3(cell_size));
+    dims_ = glm::ivec3(glm::ceil(extent * inv_cell_size_));
+
+    Clear();
+    return true;
+}
+
+void SpatialGrid::Build(const std::vector<glm::vec3>& positions) {
+    positions_ = positions;
+    stale_ = false;
+    SortIntoCells();
+}
+
+void SpatialGrid::Rebuild() const {
+    positions_.clear();
+    stale_ = false;
+    if (source_) source_(positions_);
+    SortIntoCells();
+}
+
+void SpatialGrid::SortIntoCells() const {
+    size_t cell_count = static_cast<size_t>(dims_.x) * dims_.y * dims_.z;
+
+    entry_cells_.resize(positions_.size());
+    entries_.resize(positions_.size());
+    cell_start_.assign(cell_count + 1, 0);
+
+    // Counting sort: histogram, prefix sum, scatter
+    for (size_t i = 0; i < positions_.size(); ++i) {
+        uint32_t cell = CellIndex(CellCoords(positions_[i]));
+        entry_cells_[i] = cell;
+        cell_start_[cell + 1]++;
+    }
+    for (size_t c = 0; c < cell_count; ++c) {
+        cell_start_[c + 1] += cell_start_[c];
+    }
+
+    cell_cursor_.assign(cell_start_.begin(), cell_start_.end() - 1);
+    for (size_t i = 0; i < positions_.size(); ++i) {
+        entries_[cell_cursor_[entry_cells_[i]]++] = static_cast<uint32_t>(i);
+    }
+}
+
+void SpatialGrid::Clear() {
+    size_t cell_count = static_cast<size_t>(dims_.x) * dims_.y * dims_.z;
+    positions_.clear();
+    entries_.clear();
+    cell_start_.assign(cell_count + 1, 0);
+    stale_ = false;
+}
+
+void SpatialGrid::QueryAABB(const glm::vec3& min_corner, const glm::vec3& max_corner, std::vector<uint32_t>& out) const {
+    Refresh();
+    if (positions_.empty()) return;
+
+    glm::ivec3 lo = CellCoords(min_corner);
+    glm::ivec3 hi = CellCoords(max_corner);
+
+    for (int z = lo.z; z <= hi.z; ++z) {
+        for (int y = lo.y; y <= hi.y; ++y) {
+            // Cells along x are contiguous, so one range covers the whole row
+            uint32_t row_begin = CellIndex(glm::ivec3(lo.x, y, z));
+            uint32_t row_end = CellIndex(glm::ivec3(hi.x, y, z)) + 1;
+            out.insert(out.end(), entries_.begin() + cell_start_[row_begin], entries_.begin() + cell_start_[row_end]);
+        }
+    }
+}
+
+void SpatialGrid::QueryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const {
+    size_t first = out.size();
+    QueryAABB(center - glm::vec3(radius), center + glm::vec3(radius), out);
+
+    float radius_sq = radius * radius;
+    size_t kept = first;
+    for (size_t i = first; i < out.size(); ++i) {
+        glm::vec3 offset = positions_[out[i]] - center;
+        if (glm::dot(offset, offset) <= radius_sq) {
+            out[kept++] = out[i];
+        }
+    }
+    out.resize(kept);
+}
+
+void SpatialGrid::QueryRadiusCapped(const glm::vec3& center, float radius, size_t max_count, std::vector<uint32_t>& out) const {
+    Refresh();
+    if (positions_.empty() || max_count == 0) return;
+
+    float radius_sq = radius * radius;
+    size_t found = 0;
+    auto scan_cell = [&](uint32_t cell) {
+        for (uint32_t e = cell_start_[cell]; e < cell_start_[cell + 1] && found < max_count; ++e) {
+            uint32_t index = entries_[e];
+            glm::vec3 offset = positions_[index] - center;
+            if (glm::dot(offset, offset) <= radius_sq) {
+                out.push_back(index);
+                found++;
+            }
+        }
+    };
+
+    uint32_t home = CellIndex(CellCoords(center));
+    scan_cell(home);
+
+    glm::ivec3 lo = CellCoords(center - glm::vec3(radius));
+    glm::ivec3 hi = CellCoords(center + glm::vec3(radius));
+    for (int z = lo.z; z <= hi.z && found < max_count; ++z) {
+        for (int y = lo.y; y <= hi.y && found < max_count; ++y) {
+            for (int x = lo.x; x <= hi.x && found < max_count; ++x) {
+                uint32_t cell = CellIndex(glm::ivec3(x, y, z));
+                if (cell != home) scan_cell(cell);
+            }
+        }
+    }
+}
+
+void SpatialGrid::QueryNearest(const glm::vec3& center, size_t k, float max_radius, std::vector<uint32_t>& out) const {
+    Refresh();
+    if (positions_.empty() || k == 0) return;
+
+    std::vector<std::pair<float, uint32_t>>& best = nearest_scratch_;
+    best.clear();
+
+    float max_radius_sq = max_radius * max_radius;
+    glm::ivec3 origin = CellCoords(center);
+    int max_shell = static_cast<int>(glm::ceil(max_radius * inv_cell_size_));
+
+    for (int shell = 0; shell <= max_shell; ++shell) {
+        glm::ivec3 lo = glm::max(origin - glm::ivec3(shell), glm::ivec3(0));
+        glm::ivec3 hi = glm::min(origin + glm::ivec3(shell), dims_ - glm::ivec3(1));
+
+        for (int z = lo.z; z <= hi.z; ++z) {
+            for (int y = lo.y; y <= hi.y; ++y) {
+                for (int x = lo.x; x <= hi.x; ++x) {
+                    // Only the cells on the surface of this shell are new
+                    int ring = std::max(std::abs(x - origin.x), std::max(std::abs(y - origin.y), std::abs(z - origin.z)));
+                    if (ring != shell) continue;
+
+                    uint32_t cell = CellIndex(glm::ivec3(x, y, z));
+                    for (uint32_t e = cell_start_[cell]; e < cell_start_[cell + 1]; ++e) {
+                        uint32_t index = entries_[e];
+                        glm::vec3 offset = positions_[index] - center;
+                        float distance_sq = glm::dot(offset, offset);
+                        if (distance_sq > max_radius_sq) continue;
+
+                        // Keep the k best sorted (k is small: insertion beats a heap)
+                        if (best.size() == k && distance_sq >= best.back().first) continue;
+                        auto it = std::upper_bound(best.begin(), best.end(), std::make_pair(distance_sq, index));
+                        best.insert(it, std::make_pair(distance_sq, index));
+                        if (best.size() > k) best.pop_back();
+                    }
+                }
+            }
+        }
+
+        // Every cell of the next shell is at least `shell` cells away along one axis
+        float next_shell_distance = shell * cell_size_;
+        if (best.size() == k && best.back().first <= next_shell_distance * next_shell_distance) break;
+    }
+
+    for (const auto& entry : best) {
+        out.push_back(entry.second);
+    }
+}
+
+void SpatialGrid::GetCellBounds(size_t cell, glm::vec3& min_corner, glm::vec3& max_corner) const {
+    int index = static_cast<int>(cell);
+    glm::ivec3 coords(index % dims_.x, (index / dims_.x) % dims_.y, index / (dims_.x * dims_.y));
+    min_corner = min_bounds_ + glm::vec3(coords) * cell_size_;
+    max_corner = min_corner + glm::vec3(cell_size_);
+}
+
+glm::ivec3 SpatialGrid::CellCoords(const glm::vec3& position) const {
+    glm::ivec3 coords = glm::ivec3(glm::floor((position - min_bounds_) * inv_cell_size_));
+    return glm::clamp(coords, glm::ivec3(0), dims_ - glm::ivec3(1));
+}
+
+uint32_t SpatialGrid::CellIndex(const glm::ivec3& coords) const {
+    return static_cast<uint32_t>((coords.z * dims_.y + coords.y) * dims_.x + coords.x);
+}
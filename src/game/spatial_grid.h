@@ -0,0 +1,75 @@
+// Uniform grid broadphase over point positions, rebuilt when they change
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Dense grid over fixed world bounds; positions outside the bounds are clamped into
+// the border cells, so queries stay correct and only lose efficiency there.
+// Entries are stored cell-sorted (counting sort), so a rebuild is O(n) with no
+// per-cell allocations. Query results are indices into the array passed to Build().
+class SpatialGrid {
+public:
+    SpatialGrid();
+    ~SpatialGrid() = default;
+
+    bool Initialize(const glm::vec3& min_bounds, const glm::vec3& max_bounds, float cell_size);
+
+    // Replace the grid contents with `positions`
+    void Build(const std::vector<glm::vec3>& positions);
+    void Clear();
+
+    // Lazy contents: after Invalidate() the next query rebuilds the grid from the
+    // positions `source` appends, so a tick without queries pays nothing for it
+    void SetSource(std::function<void(std::vector<glm::vec3>&)> source) { source_ = std::move(source); }
+    void Invalidate() { stale_ = true; }
+
+    // Append indices whose cell overlaps the box (candidates, not filtered by exact position)
+    void QueryAABB(const glm::vec3& min_corner, const glm::vec3& max_corner, std::vector<uint32_t>& out) const;
+
+    // Append indices whose position lies within `radius` of `center`
+    void QueryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+
+    // Like QueryRadius, but stops after `max_count` hits. The center's own cell is
+    // searched first, so a capped query in a dense crowd still sees its closest neighbors.
+    void QueryRadiusCapped(const glm::vec3& center, float radius, size_t max_count, std::vector<uint32_t>& out) const;
+
+    // Append up to `k` indices nearest to `center` within `max_radius`, closest first.
+    // Searches outward shell by shell and stops once no closer entry can exist.
+    void QueryNearest(const glm::vec3& center, size_t k, float max_radius, std::vector<uint32_t>& out) const;
+
+    size_t GetEntryCount() const { Refresh(); return positions_.size(); }
+    const glm::vec3& GetPosition(uint32_t index) const { return positions_[index]; }
+    float GetCellSize() const { return cell_size_; }
+
+    // Per-cell occupancy for debug views; cells are numbered x fastest, then y, then z
+    size_t GetCellCount() const { Refresh(); return cell_start_.empty() ? 0 : cell_start_.size() - 1; }
+    uint32_t GetCellOccupancy(size_t cell) const { return cell_start_[cell + 1] - cell_start_[cell]; }
+    void GetCellBounds(size_t cell, glm::vec3& min_corner, glm::vec3& max_corner) const;
+
+private:
+    glm::vec3 min_bounds_;
+    float cell_size_;
+    float inv_cell_size_;
+    glm::ivec3 dims_;
+
+    // Built contents; mutable so a const query can run a pending lazy rebuild
+    mutable std::vector<glm::vec3> positions_;      // Copy of the built positions, by original index
+    mutable std::vector<uint32_t> cell_start_;      // Prefix offsets into entries_ (size = cells + 1)
+    mutable std::vector<uint32_t> entries_;         // Original indices sorted by cell
+    mutable std::vector<uint32_t> entry_cells_;     // Scratch: cell of each position during Build
+    mutable std::vector<uint32_t> cell_cursor_;     // Scratch: write cursor per cell during Build
+    std::function<void(std::vector<glm::vec3>&)> source_;
+    mutable bool stale_;
+    mutable std::vector<std::pair<float, uint32_t>> nearest_scratch_; // Scratch for QueryNearest (not thread-safe)
+
+    void Refresh() const { if (stale_) Rebuild(); }
+    void Rebuild() const;
+    void SortIntoCells() const;     // Counting sort of positions_
+
+    glm::ivec3 CellCoords(const glm::vec3& position) const;
+    uint32_t CellIndex(const glm::ivec3& coords) const;
+};
@@ -0,0 +1,152 @@
+// Implementation of enemy status effects
+#include "status_system.h"
+#include "enemy.h"
+#include "damage_system.h"
+#include "targeting_index.h"
+#include "utils/metrics.h"
+#include <algorithm>
+
+StatusSystem::StatusSystem()
+    : damage_system_(nullptr)
+    , targeting_index_(nullptr) {
+}
+
+void StatusSystem::Apply(Enemy& enemy, StatusEffect effect, float hit_damage) {
+    if (!enemy.IsAlive()) return;
+
+    uint32_t slot = GetSlot(enemy);
+    switch (effect) {
+        case StatusEffect::Slow:
+            slow_timers_[slot] = std::max(slow_timers_[slot], kSlowDuration);
+            break;
+        case StatusEffect::Burn: {
+            // The strongest burn still running sets the rate
+            float dps = hit_damage * kBurnDamageFactor;
+            burn_dps_[slot] = burn_timers_[slot] > 0.0f ? std::max(burn_dps_[slot], dps) : dps;
+            burn_timers_[slot] = kBurnDuration;
+            break;
+        }
+        case StatusEffect::Stun:
+            if (stun_timers_[slot] <= 0.0f) {
+                stun_timers_[slot] = kStunDuration;
+            }
+            break;
+        default: break;
+    }
+
+    StatusMask mask = masks_[slot] | StatusBit(effect);
+    if (mask != masks_[slot]) {
+        masks_[slot] = mask;
+        OnMaskChanged(enemy, mask);
+    }
+}
+
+void StatusSystem::Update(float delta_time) {
+    if (enemies_.empty() || delta_time <= 0.0f) return;
+    size_t count = enemies_.size();
+
+    // Burn damage covers the part of the tick the burn was still running
+    if (damage_system_) {
+        for (size_t i = 0; i < count; ++i) {
+            float burning = std::min(burn_timers_[i], delta_time);
+            if (burning > 0.0f) {
+                damage_system_->AddDamage(enemies_[i]->GetID(), burn_dps_[i] * burning);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        slow_timers_[i] -= delta_time;
+        burn_timers_[i] -= delta_time;
+        stun_timers_[i] -= delta_time;
+    }
+
+    // Expire effects; backwards, so a swapped-in slot has already been checked
+    for (size_t i = count; i-- > 0;) {
+        StatusMask mask = 0;
+        if (slow_timers_[i] > 0.0f) mask |= StatusBit(StatusEffect::Slow);
+        if (burn_timers_[i] > 0.0f) mask |= StatusBit(StatusEffect::Burn);
+        if (stun_timers_[i] > 0.0f) mask |= StatusBit(StatusEffect::Stun);
+        if (mask == masks_[i]) continue;
+
+        masks_[i] = mask;
+        OnMaskChanged(*enemies_[i], mask);
+        if (mask == 0) {
+            RemoveSlot(static_cast<uint32_t>(i));
+        }
+    }
+
+    Metrics::Add("status.affected", static_cast<double>(count));
+}
+
+void StatusSystem::RemoveDead() {
+    for (size_t i = enemies_.size(); i-- > 0;) {
+        if (!enemies_[i]->IsAlive()) {
+            RemoveSlot(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+void StatusSystem::Clear() {
+    enemies_.clear();
+    masks_.clear();
+    slow_timers_.clear();
+    burn_timers_.clear();
+    burn_dps_.clear();
+    stun_timers_.clear();
+    slots_.clear();
+}
+
+uint32_t StatusSystem::GetSlot(Enemy& enemy) {
+    auto it = slots_.find(enemy.GetID());
+    if (it != slots_.end()) return it->second;
+
+    uint32_t slot = static_cast<uint32_t>(enemies_.size());
+    slots_[enemy.GetID()] = slot;
+    enemies_.push_back(&enemy);
+    masks_.push_back(0);
+    slow_timers_.push_back(0.0f);
+    burn_timers_.push_back(0.0f);
+    burn_dps_.push_back(0.0f);
+    stun_timers_.push_back(0.0f);
+    return slot;
+}
+
+void StatusSystem::RemoveSlot(uint32_t slot) {
+    slots_.erase(enemies_[slot]->GetID());
+
+    uint32_t last = static_cast<uint32_t>(enemies_.size() - 1);
+    if (slot != last) {
+        enemies_[slot] = enemies_[last];
+        masks_[slot] = masks_[last];
+        slow_timers_[slot] = slow_timers_[last];
+        burn_timers_[slot] = burn_timers_[last];
+        burn_dps_[slot] = burn_dps_[last];
+        stun_timers_[slot] = stun_timers_[last];
+        slots_[enemies_[slot]->GetID()] = slot;
+    }
+    enemies_.pop_back();
+    masks_.pop_back();
+    slow_timers_.pop_back();
+    burn_timers_.pop_back();
+    burn_dps_.pop_back();
+    stun_timers_.pop_back();
+}
+
+void StatusSystem::OnMaskChanged(Enemy& enemy, StatusMask mask) {
+    float multiplier = 1.0f;
+    if (HasStatus(mask, StatusEffect::Stun)) {
+        multiplier = 0.0f;
+    } else if (HasStatus(mask, StatusEffect::Slow)) {
+        multiplier = kSlowMultiplier;
+    }
+
+    enemy.SetStatusMask(mask);
+    enemy.SetSpeedMultiplier(multiplier);
+
+    // Steered enemies too: their estimate is the distance left at the new speed (the
+    // steering pass keeps it in step from the next tick on)
+    if (targeting_index_) {
+        targeting_index_->UpdateMotion(enemy, enemy.GetArrivalEstimate());
+    }
+}
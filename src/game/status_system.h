@@ -0,0 +1,72 @@
+// Status effects on enemies (slow, burn, stun) with batched per-tick processing
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Enemy;
+class DamageSystem;
+class TargetingIndex;
+
+enum class StatusEffect : uint8_t {
+    Slow,   // Moves at kSlowMultiplier of its speed
+    Burn,   // Takes damage over time
+    Stun,   // Stops moving
+    Count
+};
+
+// Bit set of status effects active on an enemy
+using StatusMask = uint8_t;
+inline StatusMask StatusBit(StatusEffect effect) { return static_cast<StatusMask>(1u << static_cast<uint32_t>(effect)); }
+inline bool HasStatus(StatusMask mask, StatusEffect effect) { return (mask & StatusBit(effect)) != 0; }
+
+// Only affected enemies get a slot: a packed effect mask plus one timer array per
+// effect, structure-of-arrays. Update walks the slots once per tick: timers count
+// down, burn damage goes to the damage buffer, and slots whose effects all ran out
+// are swapped out. Nothing runs when no enemy is affected. Speed changes reach the
+// enemy only when its mask changes, as a speed multiplier on its motion segment.
+class StatusSystem {
+public:
+    static constexpr float kSlowMultiplier = 0.5f;
+    static constexpr float kSlowDuration = 2.0f;
+    static constexpr float kBurnDuration = 3.0f;
+    static constexpr float kBurnDamageFactor = 0.25f;   // Burn damage per second, relative to the hit
+    static constexpr float kStunDuration = 0.5f;        // Not refreshed while stunned
+
+    StatusSystem();
+    ~StatusSystem() = default;
+
+    void SetDamageSystem(DamageSystem* damage_system) { damage_system_ = damage_system; }
+    void SetTargetingIndex(TargetingIndex* targeting_index) { targeting_index_ = targeting_index; } // Arrival re-keyed on speed changes
+
+    // Start or refresh `effect`; `hit_damage` scales burn damage
+    void Apply(Enemy& enemy, StatusEffect effect, float hit_damage);
+
+    // Count down timers, queue burn damage, expire effects
+    void Update(float delta_time);
+
+    // Drop dead enemies; must run before they are destroyed
+    void RemoveDead();
+    void Clear();
+
+    size_t GetAffectedCount() const { return enemies_.size(); }
+
+private:
+    DamageSystem* damage_system_;
+    TargetingIndex* targeting_index_;
+
+    // One slot per affected enemy
+    std::vector<Enemy*> enemies_;
+    std::vector<StatusMask> masks_;
+    std::vector<float> slow_timers_;
+    std::vector<float> burn_timers_;
+    std::vector<float> burn_dps_;
+    std::vector<float> stun_timers_;
+    std::unordered_map<uint32_t, uint32_t> slots_;   // Enemy id -> slot
+
+    uint32_t GetSlot(Enemy& enemy);
+    void RemoveSlot(uint32_t slot);
+    void OnMaskChanged(Enemy& enemy, StatusMask mask);
+};
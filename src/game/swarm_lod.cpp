@@ -0,0 +1,87 @@
+// Implementation of swarm groups for far-away enemies
+#include "swarm_lod.h"
+#include <algorithm>
+
+SwarmLod::SwarmLod()
+    : member_count_(0)
+    , engagement_radius_(0.0f)
+    , enabled_(false) {
+}
+
+void SwarmLod::AddMember(const glm::vec3& position, double time, const SwarmTraits& traits) {
+    float distance = glm::length(position);
+    if (distance <= 0.0f || traits.speed <= 0.0f) return;
+
+    auto it = std::find_if(groups_.begin(), groups_.end(), [&](const Group& group) {
+        return group.traits == traits;
+    });
+    if (it == groups_.end()) {
+        Group group;
+        group.traits = traits;
+        group.start_time = time;
+        group.start_distance = distance;
+        group.next_member = 0;
+        groups_.push_back(group);
+        it = groups_.end() - 1;
+    }
+
+    // Later spawns trail further behind, so this is almost always an append
+    Member member;
+    member.direction = position / distance;
+    member.lag = distance - it->GetDistance(time);
+    auto slot = std::upper_bound(it->members.begin() + it->next_member, it->members.end(), member.lag,
+                                 [](float lag, const Member& other) { return lag < other.lag; });
+    it->members.insert(slot, member);
+    member_count_++;
+}
+
+void SwarmLod::CollectSplits(double time, std::vector<SwarmSplit>& out) {
+    float split_radius = GetSplitRadius();
+
+    for (Group& group : groups_) {
+        float reference = group.GetDistance(time);
+        while (group.next_member < group.members.size()) {
+            const Member& member = group.members[group.next_member];
+            float distance = reference + member.lag;
+            if (distance > split_radius) break;
+
+            out.push_back({member.direction * distance, group.traits});
+            group.next_member++;
+            member_count_--;
+        }
+
+        // Drop the split prefix once it dominates the storage
+        if (group.next_member > 256 && group.next_member * 2 > group.members.size()) {
+            group.members.erase(group.members.begin(), group.members.begin() + group.next_member);
+            group.next_member = 0;
+        }
+    }
+
+    groups_.erase(std::remove_if(groups_.begin(), groups_.end(), [](const Group& group) {
+        return group.next_member == group.members.size();
+    }), groups_.end());
+}
+
+void SwarmLod::Clear() {
+    groups_.clear();
+    member_count_ = 0;
+}
+
+float SwarmLod::GetTotalHealth() const {
+    float total = 0.0f;
+    for (const Group& group : groups_) {
+        total += group.traits.health * static_cast<float>(group.members.size() - group.next_member);
+    }
+    return total;
+}
+
+void SwarmLod::GetMemberPositions(double time, std::vector<glm::vec3>& positions, std::vector<glm::vec3>& colors) const {
+    for (const Group& group : groups_) {
+        float reference = group.GetDistance(time);
+        for (size_t i = group.next_member; i < group.members.size(); ++i) {
+            const Member& member = group.members[i];
+            positions.push_back(member.direction * (reference + member.lag));
+            colors.push_back(group.traits.color);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+// Simulation LOD: far-away enemies travel as aggregated swarm groups
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Stats shared by every member of a group (one archetype at one difficulty)
+struct SwarmTraits {
+    uint32_t archetype;     // Index into the spawner's archetype table
+    float speed;
+    float health;
+    glm::vec3 color;
+
+    bool operator==(const SwarmTraits& other) const {
+        return archetype == other.archetype && speed == other.speed && health == other.health && color == other.color;
+    }
+};
+
+// A member leaving its group: becomes an individual enemy at `position`
+struct SwarmSplit {
+    glm::vec3 position;
+    SwarmTraits traits;
+};
+
+// Enemies fly straight at the core (the origin) at their variant's speed, so members
+// of one archetype share the same radial motion: a group stores one reference distance
+// moving inward over time, and each member only its direction and how far it trails
+// the reference. Nothing per member is touched while it travels; no entity, grid
+// entry, targeting record or arrival timer exists for it. Members leave the group in
+// order of distance once they cross the split radius (max turret reach plus a
+// margin), so the simulated entity count follows the engagement area, not the wave.
+// The saving is only the stretch of the approach outside turret reach: enemies already
+// inside it are entities either way, which is why the spawner starts grouped spawns
+// kSpawnLead past the split radius. Grouping is off until enabled; only the game
+// turns it on.
+class SwarmLod {
+public:
+    static constexpr float kSplitMargin = 5.0f;      // Beyond the farthest turret reach
+    static constexpr float kMinSplitRadius = 10.0f;  // Groups never get closer than this
+    static constexpr float kSpawnLead = 10.0f;       // Grouped spawns start this far past the split radius
+
+    SwarmLod();
+    ~SwarmLod() = default;
+
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+    bool IsEnabled() const { return enabled_; }
+
+    // Farthest distance from the core at which any turret can hit
+    void SetEngagementRadius(float radius) { engagement_radius_ = radius; }
+    float GetSplitRadius() const { return glm::max(engagement_radius_ + kSplitMargin, kMinSplitRadius); }
+    bool ShouldGroup(const glm::vec3& position) const { return enabled_ && glm::length(position) > GetSplitRadius(); }
+
+    void AddMember(const glm::vec3& position, double time, const SwarmTraits& traits);
+
+    // Append members that crossed the split radius by `time` and drop them from their groups
+    void CollectSplits(double time, std::vector<SwarmSplit>& out);
+    void Clear();
+
+    size_t GetGroupCount() const { return groups_.size(); }
+    size_t GetMemberCount() const { return member_count_; }
+    float GetTotalHealth() const;
+
+    // Member positions at `time` (for rendering), with their group's color
+    void GetMemberPositions(double time, std::vector<glm::vec3>& positions, std::vector<glm::vec3>& colors) const;
+
+private:
+    struct Member {
+        glm::vec3 direction;    // Unit vector from the core toward the member
+        float lag;              // Distance behind the group reference
+    };
+
+    struct Group {
+        SwarmTraits traits;
+        double start_time;
+        float start_distance;           // Reference distance from the core at start_time
+        std::vector<Member> members;    // Ordered by lag, closest to the core first
+        size_t next_member;             // Members before this index have split off
+
+        float GetDistance(double time) const {
+            return start_distance - traits.speed * static_cast<float>(time - start_time);
+        }
+    };
+
+    std::vector<Group> groups_;
+    size_t member_count_;
+    float engagement_radius_;
+    bool enabled_;
+};
@@ -0,0 +1,299 @@
+// Implementation of the targeting priority index
+#include "targeting_index.h"
+#include "enemy.h"
+#include "spatial_grid.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+
+namespace {
+    bool IsTargetable(const Enemy* enemy, const glm::vec3& position, float range_sq) {
+        if (!enemy || !enemy->IsAlive() || enemy->IsDoomed()) return false;
+        glm::vec3 offset = enemy->GetPosition() - position;
+        return glm::dot(offset, offset) <= range_sq;
+    }
+
+    int WrapSector(int sector) {
+        int count = TargetingIndex::kSectorCount;
+        return ((sector % count) + count) % count;
+    }
+}
+
+const char* GetTargetingPolicyName(TargetingPolicy policy) {
+    switch (policy) {
+        case TargetingPolicy::Closest: return "Closest";
+        case TargetingPolicy::First: return "First";
+        case TargetingPolicy::Strongest: return "Strongest";
+        case TargetingPolicy::Weakest: return "Weakest";
+        case TargetingPolicy::Fastest: return "Fastest";
+        default: return "Unknown";
+    }
+}
+
+TargetingIndex::TargetingIndex()
+    : grid_(nullptr)
+    , max_speed_(0.0f)
+    , deviation_offset_(0.0f)
+    , deviation_speed_(0.0f)
+    , sequence_(0)
+    , change_log_start_(1) {
+}
+
+void TargetingIndex::Insert(Enemy* enemy, double arrival_time) {
+    if (!enemy) return;
+    Remove(enemy->GetID());
+
+    Record record;
+    record.enemy = enemy;
+    record.sector = GetSector(enemy->GetTrackPosition());
+    record.keys[ByArrival] = static_cast<float>(arrival_time);
+    record.keys[ByHealth] = enemy->GetHealth();
+    record.keys[BySpeed] = enemy->GetSpeed();
+
+    for (int kind = 0; kind < SetKindCount; ++kind) {
+        sets_[record.sector][kind].insert({record.keys[kind], enemy->GetID(), enemy});
+    }
+    records_.emplace(enemy->GetID(), record);
+    max_speed_ = std::max(max_speed_, enemy->GetSpeed());
+    LogChange(enemy->GetID(), enemy->GetPosition(), false);
+}
+
+void TargetingIndex::Remove(uint32_t enemy_id) {
+    auto it = records_.find(enemy_id);
+    if (it == records_.end()) return;
+
+    const Record& record = it->second;
+    for (int kind = 0; kind < SetKindCount; ++kind) {
+        sets_[record.sector][kind].erase({record.keys[kind], enemy_id, record.enemy});
+    }
+    records_.erase(it);
+    LogChange(enemy_id, glm::vec3(0.0f), true);
+}
+
+void TargetingIndex::UpdateHealth(const Enemy& enemy) {
+    auto it = records_.find(enemy.GetID());
+    if (it == records_.end()) return;
+
+    Record& record = it->second;
+    float health = enemy.GetHealth();
+    if (health == record.keys[ByHealth]) return;
+
+    std::set<Key>& set = sets_[record.sector][ByHealth];
+    set.erase({record.keys[ByHealth], enemy.GetID(), record.enemy});
+    record.keys[ByHealth] = health;
+    set.insert({health, enemy.GetID(), record.enemy});
+}
+
+void TargetingIndex::UpdateMotion(const Enemy& enemy, double arrival_time) {
+    auto it = records_.find(enemy.GetID());
+    if (it == records_.end()) return;
+
+    Record& record = it->second;
+    int sector = GetSector(enemy.GetTrackPosition());
+    float arrival = static_cast<float>(arrival_time);
+    if (sector == record.sector && arrival == record.keys[ByArrival]) return;
+
+    for (int kind = 0; kind < SetKindCount; ++kind) {
+        sets_[record.sector][kind].erase({record.keys[kind], enemy.GetID(), record.enemy});
+    }
+    record.sector = sector;
+    record.keys[ByArrival] = arrival;
+    for (int kind = 0; kind < SetKindCount; ++kind) {
+        sets_[sector][kind].insert({record.keys[kind], enemy.GetID(), record.enemy});
+    }
+}
+
+void TargetingIndex::SetTrackDeviation(float max_offset, float max_speed) {
+    deviation_offset_ = std::max(0.0f, max_offset);
+    deviation_speed_ = std::max(0.0f, max_speed);
+}
+
+void TargetingIndex::Clear() {
+    for (auto& sector : sets_) {
+        for (auto& set : sector) {
+            set.clear();
+        }
+    }
+    records_.clear();
+    max_speed_ = 0.0f;
+    
+    // Invalidate every cache: nobody can catch up across a clear
+    sequence_++;
+    changes_.clear();
+    change_log_start_ = sequence_ + 1;
+}
+
+bool TargetingIndex::GetChangesSince(uint64_t sequence, const TargetingChange*& begin, const TargetingChange*& end) const {
+    if (sequence + 1 < change_log_start_ || sequence > sequence_) return false;
+
+    const TargetingChange* log = changes_.data();
+    begin = log + (sequence + 1 - change_log_start_);
+    end = log + changes_.size();
+    return true;
+}
+
+void TargetingIndex::LogChange(uint32_t enemy_id, const glm::vec3& position, bool removed) {
+    // Keep at least the last kChangeLogCapacity entries; older readers rebuild
+    if (changes_.size() >= 2 * kChangeLogCapacity) {
+        changes_.erase(changes_.begin(), changes_.begin() + kChangeLogCapacity);
+        change_log_start_ += kChangeLogCapacity;
+    }
+    changes_.push_back({enemy_id, position, removed});
+    sequence_++;
+}
+
+void TargetingIndex::GatherCandidates(const glm::vec3& position, float radius, const std::vector<std::unique_ptr<Enemy>>& enemies,
+                                      std::vector<Enemy*>& out) const {
+    float radius_sq = radius * radius;
+    if (grid_ && grid_->GetEntryCount() == enemies.size()) {
+        nearest_scratch_.clear();
+        grid_->QueryRadius(position, radius, nearest_scratch_);
+        for (uint32_t index : nearest_scratch_) {
+            if (enemies[index]->IsAlive()) {
+                out.push_back(enemies[index].get());
+            }
+        }
+        return;
+    }
+
+    for (const auto& enemy : enemies) {
+        if (!enemy || !enemy->IsAlive()) continue;
+        glm::vec3 offset = enemy->GetPosition() - position;
+        if (glm::dot(offset, offset) <= radius_sq) {
+            out.push_back(enemy.get());
+        }
+    }
+}
+
+Enemy* TargetingIndex::Find(uint32_t enemy_id) const {
+    auto it = records_.find(enemy_id);
+    return it != records_.end() ? it->second.enemy : nullptr;
+}
+
+Enemy* TargetingIndex::Select(TargetingPolicy policy, const glm::vec3& position, float range,
+                              const std::vector<std::unique_ptr<Enemy>>& enemies) const {
+    SetKind kind = ByArrival;
+    bool descending = false;
+    switch (policy) {
+        case TargetingPolicy::Closest: return SelectClosest(position, range, enemies);
+        case TargetingPolicy::First: kind = ByArrival; break;
+        case TargetingPolicy::Strongest: kind = ByHealth; descending = true; break;
+        case TargetingPolicy::Weakest: kind = ByHealth; break;
+        case TargetingPolicy::Fastest: kind = BySpeed; descending = true; break;
+        default: return nullptr;
+    }
+
+    // Sectors overlapped by the range disk in the ground plane (grown by how far an
+    // enemy may sit off the track its sector was keyed on); all of them when the disk
+    // contains the core
+    int first_sector = 0;
+    int sector_span = kSectorCount;
+    float sector_range = range + deviation_offset_;
+    float planar_distance = glm::length(glm::vec2(position.x, position.y));
+    if (planar_distance > sector_range) {
+        float sector_width = glm::two_pi<float>() / kSectorCount;
+        float center = glm::atan(position.y, position.x) + glm::pi<float>();
+        float half_angle = glm::asin(sector_range / planar_distance);
+        first_sector = static_cast<int>(glm::floor((center - half_angle) / sector_width));
+        int last_sector = static_cast<int>(glm::floor((center + half_angle) / sector_width));
+        sector_span = std::min(last_sector - first_sector + 1, kSectorCount);
+    }
+
+    float range_sq = range * range;
+    const Key* best = nullptr;
+    // Exact key order in walk direction (descending ties go to the higher id)
+    auto better = [descending](const Key& a, const Key& b) { return descending ? b < a : a < b; };
+
+    for (int i = 0; i < sector_span; ++i) {
+        const std::set<Key>& set = sets_[WrapSector(first_sector + i)][kind];
+
+        // Walk from the best end; stop at the first hit or once nothing can beat the best so far
+        auto visit = [&](const Key& key) {
+            if (best && !better(key, *best)) return true;
+            if (!IsTargetable(key.enemy, position, range_sq)) return false;
+            best = &key;
+            return true;
+        };
+        if (descending) {
+            for (auto it = set.rbegin(); it != set.rend() && !visit(*it); ++it) {}
+        } else {
+            for (auto it = set.begin(); it != set.end() && !visit(*it); ++it) {}
+        }
+    }
+    return best ? best->enemy : nullptr;
+}
+
+Enemy* TargetingIndex::SelectFrom(TargetingPolicy policy, const std::vector<Enemy*>& candidates, const glm::vec3& position,
+                                  float range) const {
+    float range_sq = range * range;
+    Enemy* best = nullptr;
+    float best_key = 0.0f;
+
+    for (Enemy* enemy : candidates) {
+        if (!IsTargetable(enemy, position, range_sq)) continue;
+
+        float key = 0.0f;
+        switch (policy) {
+            case TargetingPolicy::Closest: {
+                glm::vec3 offset = enemy->GetPosition() - position;
+                key = glm::dot(offset, offset);
+                break;
+            }
+            case TargetingPolicy::First: {
+                auto it = records_.find(enemy->GetID());
+                key = it != records_.end() ? it->second.keys[ByArrival] : static_cast<float>(enemy->GetArrivalTime());
+                break;
+            }
+            case TargetingPolicy::Strongest: key = -enemy->GetHealth(); break;
+            case TargetingPolicy::Weakest: key = enemy->GetHealth(); break;
+            case TargetingPolicy::Fastest: key = -enemy->GetSpeed(); break;
+            default: break;
+        }
+
+        if (!best || key < best_key || (key == best_key && enemy->GetID() < best->GetID())) {
+            best = enemy;
+            best_key = key;
+        }
+    }
+    return best;
+}
+
+Enemy* TargetingIndex::SelectClosest(const glm::vec3& position, float range,
+                                     const std::vector<std::unique_ptr<Enemy>>& enemies) const {
+    float range_sq = range * range;
+
+    if (!grid_ || grid_->GetEntryCount() != enemies.size()) {
+        // Grid not built from this list: scan
+        Enemy* closest = nullptr;
+        float closest_sq = range_sq;
+        for (const auto& enemy : enemies) {
+            if (!IsTargetable(enemy.get(), position, range_sq)) continue;
+            glm::vec3 offset = enemy->GetPosition() - position;
+            float distance_sq = glm::dot(offset, offset);
+            if (!closest || distance_sq < closest_sq) {
+                closest = enemy.get();
+                closest_sq = distance_sq;
+            }
+        }
+        return closest;
+    }
+
+    // Nearest-first; widen k only when every candidate so far was doomed
+    size_t k = 8;
+    while (true) {
+        nearest_scratch_.clear();
+        grid_->QueryNearest(position, k, range, nearest_scratch_);
+        for (uint32_t index : nearest_scratch_) {
+            Enemy* enemy = enemies[index].get();
+            if (IsTargetable(enemy, position, range_sq)) return enemy;
+        }
+        if (nearest_scratch_.size() < k) return nullptr;
+        k *= 4;
+    }
+}
+
+int TargetingIndex::GetSector(const glm::vec3& position) {
+    float sector_width = glm::two_pi<float>() / kSectorCount;
+    float angle = glm::atan(position.y, position.x) + glm::pi<float>();
+    int sector = static_cast<int>(angle / sector_width);
+    return std::min(std::max(sector, 0), kSectorCount - 1);
+}
@@ -0,0 +1,122 @@
+// Incrementally maintained enemy priority sets for turret target selection
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+class Enemy;
+class SpatialGrid;
+
+enum class TargetingPolicy {
+    Closest,    // Nearest to the turret
+    First,      // Will reach the core first
+    Strongest,  // Most health left
+    Weakest,    // Least health left
+    Fastest,    // Highest speed
+    Count
+};
+
+const char* GetTargetingPolicyName(TargetingPolicy policy);
+
+// Insert or removal recorded by the index, so per-turret caches can catch up cheaply
+struct TargetingChange {
+    uint32_t enemy_id;
+    glm::vec3 position;     // Position at insertion (unused for removals)
+    bool removed;
+};
+
+// Enemies fly straight at the core, so their azimuth around it never changes. The
+// index splits the play area into azimuth sectors and keeps, per sector, enemies
+// ordered by core-arrival time, health and speed. Arrival time is an absolute sim
+// time and stays constant while an enemy flies at constant speed; health keys only
+// change when damage is applied, so nothing is re-sorted per tick. A turret query
+// visits only the sectors its range disk overlaps and walks each set from the best
+// end. Closest is answered by the spatial grid instead. Enemies steered around turret
+// zones do drift across sectors; the spawner re-keys them with UpdateMotion.
+class TargetingIndex {
+public:
+    static constexpr int kSectorCount = 32;
+    static constexpr size_t kChangeLogCapacity = 1024;
+
+    TargetingIndex();
+    ~TargetingIndex() = default;
+
+    // Grid used for Closest; must be built from the enemy list passed to Select
+    void SetSpatialGrid(const SpatialGrid* grid) { grid_ = grid; }
+
+    // `arrival_time` is the sim time at which the enemy reaches the core
+    void Insert(Enemy* enemy, double arrival_time);
+    void Remove(uint32_t enemy_id);
+    void UpdateHealth(const Enemy& enemy);
+    // Re-key a steered enemy: sector from its current track position, new arrival estimate
+    void UpdateMotion(const Enemy& enemy, double arrival_time);
+    void Clear();
+
+    Enemy* Find(uint32_t enemy_id) const;
+    size_t GetCount() const { return records_.size(); }
+
+    // Enemies may sit up to `max_offset` off their track (crowd separation) and drift
+    // off it at up to `max_speed`. Sectors are keyed on the track, so sector walks widen
+    // by the offset and the speed bound below includes the drift.
+    void SetTrackDeviation(float max_offset, float max_speed);
+
+    // Upper bound on the speed of any indexed enemy (only grows until Clear)
+    float GetMaxSpeed() const { return max_speed_ + deviation_speed_; }
+
+    // Every insert and removal bumps the sequence number. GetChangesSince returns the
+    // changes after `sequence`, or false when the log no longer reaches back that far.
+    uint64_t GetSequence() const { return sequence_; }
+    bool GetChangesSince(uint64_t sequence, const TargetingChange*& begin, const TargetingChange*& end) const;
+
+    // Live enemies within `radius` of `position` (grid query when available)
+    void GatherCandidates(const glm::vec3& position, float radius, const std::vector<std::unique_ptr<Enemy>>& enemies,
+                          std::vector<Enemy*>& out) const;
+
+    // Best enemy for `policy` that is alive, not doomed by in-flight damage and within
+    // `range` of `position`; nullptr if there is none
+    Enemy* Select(TargetingPolicy policy, const glm::vec3& position, float range,
+                  const std::vector<std::unique_ptr<Enemy>>& enemies) const;
+
+    // Same choice restricted to a small candidate list (no sector walk)
+    Enemy* SelectFrom(TargetingPolicy policy, const std::vector<Enemy*>& candidates, const glm::vec3& position, float range) const;
+
+private:
+    struct Key {
+        float value;
+        uint32_t id;
+        Enemy* enemy;
+        bool operator<(const Key& other) const {
+            return value < other.value || (value == other.value && id < other.id);
+        }
+    };
+
+    enum SetKind { ByArrival, ByHealth, BySpeed, SetKindCount };
+
+    struct Record {
+        Enemy* enemy;
+        int sector;
+        float keys[SetKindCount];
+    };
+
+    // Ascending; Strongest and Fastest walk their sets from the back
+    std::set<Key> sets_[kSectorCount][SetKindCount];
+    std::unordered_map<uint32_t, Record> records_;
+    const SpatialGrid* grid_;
+    float max_speed_;
+    float deviation_offset_;
+    float deviation_speed_;
+    mutable std::vector<uint32_t> nearest_scratch_; // Scratch for Closest and candidate queries (not thread-safe)
+
+    uint64_t sequence_;
+    uint64_t change_log_start_;                     // Sequence number of changes_[0]
+    std::vector<TargetingChange> changes_;
+
+    void LogChange(uint32_t enemy_id, const glm::vec3& position, bool removed);
+
+    static int GetSector(const glm::vec3& position);
+    Enemy* SelectClosest(const glm::vec3& position, float range, const std::vector<std::unique_ptr<Enemy>>& enemies) const;
+};
@@ -2,11 +2,15 @@
 #include "turret.h"
 #include "enemy.h"
 #include "projectile_manager.h"
+#include "damage_system.h"
 #include "item.h"
+#include "utils/metrics.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
 #include <algorithm>
+#include <cassert>
 #include <iostream>
+#include <limits>
 
 Turret::Turret() :
     position_(0.0f),
@@ -21,15 +25,28 @@ Turret::Turret() :
     initialized_(false),
     cost_(0),                   // Will be set when placed
     item_slots_({nullptr, nullptr, nullptr}), // 3 empty slots
+    effect_mask_(0),
     current_target_(nullptr),
+    current_target_id_(0),
     rotation_(0.0f),
     target_rotation_(0.0f),
     rotation_speed_(180.0f),    // 180 degrees per second
-    last_fire_time_(0.0f),
-    reload_time_(0.0f) {
+    sim_clock_(nullptr),
+    ready_to_fire_(false),
+    reload_time_(0.0f),
+    homing_(false),
+    targeting_policy_(TargetingPolicy::Closest),
+    candidate_expiry_(0.0),
+    candidate_sequence_(0),
+    candidate_range_(0.0f),
+    candidate_max_speed_(0.0f),
+    candidates_valid_(false) {
 }
 
 Turret::~Turret() {
+    if (sim_clock_) {
+        sim_clock_->Cancel(reload_timer_);
+    }
 }
 
 bool Turret::Initialize(const glm::vec3& position) {
@@ -40,15 +57,15 @@ bool Turret::Initialize(const glm::vec3& position) {
     reload_time_ = 1.0f / fire_rate_;  // Calculate reload time from fire rate
     initialized_ = true;
     
+    // First shot becomes available after one reload
+    StartReload();
+    
     return true;
 }
 
 void Turret::Update(float delta_time) {
     if (!active_ || !initialized_) return;
     
-    // Update fire timer
-    UpdateFireTimer(delta_time);
-    
     // Update rotation towards target
     UpdateRotation(delta_time);
     
@@ -63,79 +80,183 @@ void Turret::Render() {
     // This will be called from the game render loop
 }
 
-void Turret::UpdateTarget(const std::vector<std::unique_ptr<Enemy>>& enemies) {
+void Turret::UpdateTarget(const std::vector<std::unique_ptr<Enemy>>& enemies, const TargetingIndex* index) {
     if (!active_) return;
     
-    // Clear current target if it's no longer valid
-    if (current_target_ && (!current_target_->IsAlive() || !IsInRange(current_target_))) {
-        current_target_ = nullptr;
+    if (index) {
+        bool rebuilt = RefreshCandidates(enemies, *index);
+#ifndef NDEBUG
+        VerifyCandidates(enemies);
+#endif
+        
+        // Cached pointers are safe: removing a candidate forces a rebuild first
+        Enemy* previous_target = nullptr;
+        if (current_target_id_ != 0) {
+            previous_target = rebuilt ? index->Find(current_target_id_) : FindCandidate(current_target_id_);
+        }
+        bool previous_valid = previous_target && previous_target->IsAlive() && !previous_target->IsDoomed() &&
+                              IsInRange(previous_target);
+        
+        // Common case: target still good and no rebuild, so no search work at all
+        if (previous_valid && (!rebuilt || targeting_policy_ == TargetingPolicy::Closest)) {
+            current_target_ = previous_target;
+            return;
+        }
+        
+        Metrics::Add("targeting.selections");
+        Enemy* selected = rebuilt ? index->Select(targeting_policy_, position_, range_, enemies)
+                                  : index->SelectFrom(targeting_policy_, candidates_, position_, range_);
+        if (selected && selected != previous_target) {
+            std::cout << "Turret acquired target (" << GetTargetingPolicyName(targeting_policy_) << ") at distance: "
+                      << CalculateDistanceToTarget(selected) << std::endl;
+        }
+        current_target_ = selected;
+        current_target_id_ = selected ? selected->GetID() : 0;
+        return;
     }
     
-    // If we don't have a target, find the closest enemy in range
-    if (!current_target_) {
-        Enemy* closest_enemy = nullptr;
-        float closest_distance = range_;
+    // Resolve the current target by id (the enemy list may have dropped it since last tick)
+    // and find the closest enemy in range in the same pass. Enemies that projectiles in
+    // flight will already kill are skipped, so no shots are wasted on them.
+    Enemy* previous_target = nullptr;
+    Enemy* closest_enemy = nullptr;
+    float closest_distance = range_;
+    
+    for (const auto& enemy : enemies) {
+        if (!enemy || !enemy->IsAlive() || enemy->IsDoomed()) continue;
         
-        for (const auto& enemy : enemies) {
-            if (!enemy || !enemy->IsAlive()) continue;
-            
-            float distance = CalculateDistanceToTarget(enemy.get());
-            if (distance <= range_ && distance < closest_distance) {
-                closest_enemy = enemy.get();
-                closest_distance = distance;
-            }
+        if (current_target_id_ != 0 && enemy->GetID() == current_target_id_) {
+            previous_target = enemy.get();
         }
         
-        if (closest_enemy) {
-            current_target_ = closest_enemy;
-            std::cout << "Turret acquired target at distance: " << closest_distance << std::endl;
+        float distance = CalculateDistanceToTarget(enemy.get());
+        if (distance <= range_ && distance < closest_distance) {
+            closest_enemy = enemy.get();
+            closest_distance = distance;
+        }
+    }
+    
+    // Keep the current target while it is alive and in range
+    if (previous_target && IsInRange(previous_target)) {
+        current_target_ = previous_target;
+        return;
+    }
+    
+    current_target_ = closest_enemy;
+    current_target_id_ = closest_enemy ? closest_enemy->GetID() : 0;
+    if (closest_enemy) {
+        std::cout << "Turret acquired target at distance: " << closest_distance << std::endl;
+    }
+}
+
+bool Turret::RefreshCandidates(const std::vector<std::unique_ptr<Enemy>>& enemies, const TargetingIndex& index) {
+    double now = sim_clock_ ? sim_clock_->GetTime() : 0.0;
+    bool valid = candidates_valid_ && sim_clock_ && now < candidate_expiry_ && candidate_range_ == range_;
+    
+    // Catch up with spawns and removals since the cache was built
+    if (valid && index.GetSequence() != candidate_sequence_) {
+        const TargetingChange* begin = nullptr;
+        const TargetingChange* end = nullptr;
+        valid = index.GetChangesSince(candidate_sequence_, begin, end) && index.GetMaxSpeed() <= candidate_max_speed_;
+        
+        float reach = range_ + kCandidateMargin;
+        for (const TargetingChange* change = begin; valid && change != end; ++change) {
+            if (change->removed) {
+                valid = !std::binary_search(candidate_ids_.begin(), candidate_ids_.end(), change->enemy_id);
+            } else {
+                valid = glm::length(change->position - position_) > reach;
+            }
         }
+        candidate_sequence_ = index.GetSequence();
+    }
+    if (valid) return false;
+    
+    candidates_.clear();
+    index.GatherCandidates(position_, range_ + kCandidateMargin, enemies, candidates_);
+    std::sort(candidates_.begin(), candidates_.end(), [](const Enemy* a, const Enemy* b) { return a->GetID() < b->GetID(); });
+    candidate_ids_.clear();
+    for (const Enemy* enemy : candidates_) {
+        candidate_ids_.push_back(enemy->GetID());
+    }
+    
+    // Nothing outside range + margin can cover the margin before the horizon
+    candidate_max_speed_ = index.GetMaxSpeed();
+    candidate_expiry_ = candidate_max_speed_ > 0.0f ? now + kCandidateMargin / candidate_max_speed_
+                                                    : std::numeric_limits<double>::infinity();
+    candidate_sequence_ = index.GetSequence();
+    candidate_range_ = range_;
+    candidates_valid_ = true;
+    
+    Metrics::Add("targeting.rescans");
+    return true;
+}
+
+Enemy* Turret::FindCandidate(uint32_t enemy_id) const {
+    auto it = std::lower_bound(candidate_ids_.begin(), candidate_ids_.end(), enemy_id);
+    if (it == candidate_ids_.end() || *it != enemy_id) return nullptr;
+    return candidates_[it - candidate_ids_.begin()];
+}
+
+void Turret::VerifyCandidates(const std::vector<std::unique_ptr<Enemy>>& enemies) const {
+    // Exhaustive check: every live enemy in range must be in the cache
+    for (const auto& enemy : enemies) {
+        if (!enemy || !enemy->IsAlive() || !IsInRange(enemy.get())) continue;
+        assert(std::binary_search(candidate_ids_.begin(), candidate_ids_.end(), enemy->GetID()) &&
+               "Turret candidate cache is missing an enemy in range");
     }
 }
 
 void Turret::ClearTarget() {
     current_target_ = nullptr;
+    current_target_id_ = 0;
 }
 
-void Turret::Fire() {
-    if (!current_target_ || !CanFire()) return;
+void Turret::Fire(DamageSystem* damage_system) {
+    if (!current_target_ || !CanFire() || !damage_system) return;
     
     std::cout << "Turret fired at enemy!" << std::endl;
     
-    // Deal damage to target
-    current_target_->TakeDamage(damage_);
-    
-    // Update fire timing
-    last_fire_time_ = 0.0f;  // Reset timer (will be updated by game loop)
+    // Deal damage to target (applied with the rest of this tick's damage)
+    damage_system->AddDamage(current_target_->GetID(), damage_);
     
-    // Clear target if enemy died
-    if (!current_target_->IsAlive()) {
-        current_target_ = nullptr;
-    }
+    // Start reloading
+    StartReload();
 }
 
 void Turret::Fire(ProjectileManager* projectile_manager) {
     if (!current_target_ || !CanFire()) return;
     
-    // Create projectile from turret position to current target position
-    projectile_manager->CreateProjectile(position_, current_target_->GetPosition(), 30.0f, damage_, current_target_);
+    // Homing or straight at the predicted intercept point; legendary effects shape the volley
+    projectile_manager->FireAt(position_, *current_target_, 30.0f, damage_, effect_mask_, homing_);
     
-    // Update fire timing
-    last_fire_time_ = 0.0f;
+    // Start reloading
+    StartReload();
     
     std::cout << "Turret fired projectile at enemy!" << std::endl;
 }
 
 bool Turret::CanFire() const {
-    return last_fire_time_ >= reload_time_;
+    return ready_to_fire_;
 }
 
-void Turret::UpdateFireTimer(float delta_time) {
-    last_fire_time_ += delta_time;
+void Turret::OnReloadComplete() {
+    reload_timer_ = SimClock::TimerHandle();
+    ready_to_fire_ = true;
 }
 
 void Turret::ResetFireTimer() {
-    last_fire_time_ = 0.0f;
+    StartReload();
+}
+
+void Turret::StartReload() {
+    ready_to_fire_ = false;
+    if (!sim_clock_) {
+        // No clock attached: fire without reload throttling
+        ready_to_fire_ = true;
+        return;
+    }
+    sim_clock_->Cancel(reload_timer_);
+    reload_timer_ = sim_clock_->Schedule(SimTimer::TurretReady, reload_time_, this);
 }
 
 int Turret::GetEquippedItemCount() const {
@@ -231,6 +352,8 @@ void Turret::RecalculateStats() {
     fire_rate_ = base_fire_rate_;
     range_ = base_range_;
     
+    effect_mask_ = 0;
+    
     // Accumulate bonuses (additive, not multiplicative)
     float damage_bonus = 0.0f;
     float fire_rate_bonus = 0.0f;
@@ -240,6 +363,11 @@ void Turret::RecalculateStats() {
     for (const auto& item : item_slots_) {
         if (!item) continue;
         
+        // Legendary effects stack as flags
+        if (item->GetEffect() != LegendaryEffect::None) {
+            effect_mask_ |= EffectBit(item->GetEffect());
+        }
+        
         // Apply primary bonus
         switch (item->GetPrimaryStat()) {
             case ItemStat::Damage:
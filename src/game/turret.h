@@ -1,6 +1,9 @@
 // Defensive turret that auto-targets and shoots enemies
 #pragma once
 
+#include "sim_clock.h"
+#include "item.h"
+#include "targeting_index.h"
 #include <glm/glm.hpp>
 #include <memory>
 #include <vector>
@@ -8,10 +11,13 @@
 
 class Enemy;
 class ProjectileManager;
-class Item;
+class DamageSystem;
 
 class Turret {
 public:
+    // Candidate cache covers range + margin; it stays valid for margin / max enemy speed
+    static constexpr float kCandidateMargin = 4.0f;
+
     Turret();
     ~Turret();
 
@@ -35,7 +41,10 @@ public:
     bool IsActive() const { return active_; }
     glm::vec3 GetColor() const { return color_; }
     float GetRotation() const { return rotation_; }
-    Enemy* GetCurrentTarget() const { return current_target_; }
+    Enemy* GetCurrentTarget() const { return current_target_; } // Valid for the current tick only
+    bool IsHoming() const { return homing_; }
+    TargetingPolicy GetTargetingPolicy() const { return targeting_policy_; }
+    EffectMask GetEffectMask() const { return effect_mask_; } // Legendary effects of equipped items
     int GetCost() const { return cost_; }
     const std::array<Item*, 3>& GetItemSlots() const { return item_slots_; }
 
@@ -47,17 +56,23 @@ public:
     void SetColor(const glm::vec3& color) { color_ = color; }
     void SetActive(bool active) { active_ = active; }
     void SetCost(int cost) { cost_ = cost; }
+    void SetSimClock(SimClock* sim_clock) { sim_clock_ = sim_clock; }
+    void SetHoming(bool homing) { homing_ = homing; } // Homing shots instead of predicted ballistic ones
+    void SetTargetingPolicy(TargetingPolicy policy) { targeting_policy_ = policy; current_target_id_ = 0; } // Re-targets next tick
 
     // Targeting
-    void UpdateTarget(const std::vector<std::unique_ptr<Enemy>>& enemies);
+    // The target is kept while it stays alive, in range and not doomed; a new one is
+    // chosen from the cached candidates, and policies other than Closest re-select
+    // whenever the cache is rebuilt. Without an index only Closest is available (full scan).
+    void UpdateTarget(const std::vector<std::unique_ptr<Enemy>>& enemies, const TargetingIndex* index = nullptr);
     void ClearTarget();
 
     // Combat
-    void Fire();
+    void Fire(DamageSystem* damage_system); // Instant hit, queued on the damage buffer
     void Fire(ProjectileManager* projectile_manager);
     bool CanFire() const;
-    void UpdateFireTimer(float delta_time);
-    void ResetFireTimer(); // Reset fire timer (for pause/unpause)
+    void OnReloadComplete(); // Called by TurretManager when the TurretReady timer fires
+    void ResetFireTimer(); // Restart reload from zero (for pause/unpause)
 
     // Visual
     void UpdateRotation(float delta_time);
@@ -80,20 +95,41 @@ private:
     bool initialized_;          // Is turret initialized
     int cost_;                  // Cost when placed (for sell refund)
     std::array<Item*, 3> item_slots_; // 3 slots for items
+    EffectMask effect_mask_;    // Legendary effects granted by equipped items
 
     // Targeting
-    Enemy* current_target_;     // Current target enemy
+    Enemy* current_target_;     // Current target enemy (re-resolved from the enemy list every tick)
+    uint32_t current_target_id_; // Id of the current target (0 = none)
     float rotation_;            // Turret rotation angle (Y-axis)
     float target_rotation_;     // Target rotation angle
     float rotation_speed_;      // Rotation speed in degrees per second
 
-    // Combat timing
-    float last_fire_time_;      // Time of last shot
+    // Combat timing (reload expiry is scheduled on the sim clock, not polled)
+    SimClock* sim_clock_;
+    SimClock::TimerHandle reload_timer_;
+    bool ready_to_fire_;        // Reload finished, waiting for a target
     float reload_time_;         // Time between shots
+    bool homing_;               // Fire homing projectiles instead of ballistic ones
+    TargetingPolicy targeting_policy_;
+
+    // Candidate cache: every enemy that can enter range before candidate_expiry_. Rebuilt
+    // when the horizon passes, the range changes, a candidate is removed or an enemy
+    // spawns close enough; otherwise a still-valid target costs no search at all.
+    std::vector<Enemy*> candidates_;      // Ordered by id
+    std::vector<uint32_t> candidate_ids_; // Ids of candidates_, for binary search against index removals
+    double candidate_expiry_;
+    uint64_t candidate_sequence_;         // Index change sequence the cache has seen
+    float candidate_range_;
+    float candidate_max_speed_;
+    bool candidates_valid_;
 
     // Helper functions
+    bool RefreshCandidates(const std::vector<std::unique_ptr<Enemy>>& enemies, const TargetingIndex& index);
+    Enemy* FindCandidate(uint32_t enemy_id) const;
+    void VerifyCandidates(const std::vector<std::unique_ptr<Enemy>>& enemies) const;
     float CalculateDistanceToTarget(Enemy* enemy) const;
     bool IsInRange(Enemy* enemy) const;
     bool HasLineOfSight(Enemy* enemy) const;
     glm::vec3 GetDirectionToTarget() const;
+    void StartReload();
 };
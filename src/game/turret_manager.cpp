@@ -1,5 +1,7 @@
 // Implementation of turret management and placement
 #include "turret_manager.h"
+#include "flow_field.h"
+#include "utils/debug_draw.h"
 #include <algorithm>
 #include <iostream>
 
@@ -8,7 +10,10 @@ TurretManager::TurretManager() :
     max_distance_from_center_(20.0f),     // At most 20 units from center
     min_distance_between_turrets_(3.0f),  // At least 3 units between turrets
     max_turrets_(15),                     // Maximum 15 turrets
-    projectile_manager_(nullptr) {
+    projectile_manager_(nullptr),
+    sim_clock_(nullptr),
+    targeting_index_(nullptr),
+    flow_field_(nullptr) {
 }
 
 TurretManager::~TurretManager() {
@@ -25,32 +30,60 @@ bool TurretManager::Initialize() {
 }
 
 void TurretManager::Update(float delta_time, const std::vector<std::unique_ptr<Enemy>>& enemies) {
-    // Update all turrets
+    // Turrets whose reload finished this tick become ready to fire
+    if (sim_clock_) {
+        for (void* owner : sim_clock_->GetDue(SimTimer::TurretReady)) {
+            Turret* turret = static_cast<Turret*>(owner);
+            turret->OnReloadComplete();
+            ready_turrets_.push_back(turret);
+        }
+    }
+    
+    // Update targeting and rotation of all turrets
     for (auto& turret : turrets_) {
         if (turret && turret->IsActive()) {
-            // Update targeting for this turret
-            turret->UpdateTarget(enemies);
-            
-            // Update turret logic
+            turret->UpdateTarget(enemies, targeting_index_);
             turret->Update(delta_time);
             
-            // Fire projectiles if turret can fire
-            if (turret->CanFire() && turret->GetCurrentTarget() && projectile_manager_) {
-                std::cout << "TurretManager: Turret can fire, calling Fire()" << std::endl;
-                turret->Fire(projectile_manager_);
-            } else {
-                if (!turret->CanFire()) {
-                    // std::cout << "TurretManager: Turret cannot fire yet" << std::endl;
-                }
-                if (!turret->GetCurrentTarget()) {
-                    // std::cout << "TurretManager: Turret has no target" << std::endl;
-                }
-                if (!projectile_manager_) {
-                    std::cout << "TurretManager: ProjectileManager is null!" << std::endl;
-                }
+            DEBUG_DRAW_CIRCLE(DebugCategory::Turrets, turret->GetPosition(), turret->GetRange(), glm::vec3(1.0f, 1.0f, 0.0f));
+            if (turret->GetCurrentTarget()) {
+                DEBUG_DRAW_LINE(DebugCategory::Targets, turret->GetPosition(), turret->GetCurrentTarget()->GetPosition(),
+                                glm::vec3(1.0f, 0.5f, 0.0f));
             }
         }
     }
+    
+    DEBUG_DRAW_CIRCLE(DebugCategory::Placement, glm::vec3(0.0f), min_distance_from_center_, glm::vec3(1.0f, 0.0f, 0.0f));
+    DEBUG_DRAW_CIRCLE(DebugCategory::Placement, glm::vec3(0.0f), max_distance_from_center_, glm::vec3(0.0f, 1.0f, 0.0f));
+    
+    if (!projectile_manager_) {
+        if (!ready_turrets_.empty()) {
+            std::cout << "TurretManager: ProjectileManager is null!" << std::endl;
+        }
+        return;
+    }
+    
+    // Only reloaded turrets are considered for firing
+    for (size_t i = 0; i < ready_turrets_.size();) {
+        Turret* turret = ready_turrets_[i];
+        
+        // A turret that fired earlier this tick may have already committed lethal damage
+        if (turret->IsActive() && turret->GetCurrentTarget() && turret->GetCurrentTarget()->IsDoomed()) {
+            turret->UpdateTarget(enemies, targeting_index_);
+        }
+        
+        if (turret->IsActive() && turret->GetCurrentTarget()) {
+            std::cout << "TurretManager: Turret can fire, calling Fire()" << std::endl;
+            turret->Fire(projectile_manager_);
+        }
+        
+        if (turret->CanFire()) {
+            ++i;
+        } else {
+            ready_turrets_[i] = ready_turrets_.back();
+            ready_turrets_.pop_back();
+        }
+    }
 }
 
 void TurretManager::SetProjectileManager(class ProjectileManager* projectile_manager) {
@@ -85,7 +118,14 @@ bool TurretManager::PlaceTurret(const glm::vec3& position) {
     
     // Create new turret
     auto turret = std::make_unique<Turret>();
+    turret->SetSimClock(sim_clock_);
     if (turret->Initialize(position)) {
+        if (turret->CanFire()) {
+            ready_turrets_.push_back(turret.get());
+        }
+        if (flow_field_) {
+            flow_field_->AddZone(turret->GetPosition(), kExclusionRadius);
+        }
         turrets_.push_back(std::move(turret));
         std::cout << "Turret placed successfully at: " 
                   << position.x << ", " << position.y << ", " << position.z << std::endl;
@@ -99,19 +139,31 @@ bool TurretManager::PlaceTurret(const glm::vec3& position) {
 void TurretManager::RemoveTurret(int index) {
     if (index >= 0 && index < static_cast<int>(turrets_.size())) {
         std::cout << "Removing turret at index: " << index << std::endl;
+        ForgetReadyTurret(turrets_[index].get());
+        if (flow_field_) {
+            flow_field_->RemoveZone(turrets_[index]->GetPosition(), kExclusionRadius);
+        }
         turrets_.erase(turrets_.begin() + index);
     }
 }
 
 void TurretManager::ClearAllTurrets() {
     std::cout << "Clearing all turrets (" << turrets_.size() << " turrets)" << std::endl;
+    ready_turrets_.clear();
     turrets_.clear();
+    if (flow_field_) {
+        flow_field_->ClearZones();
+    }
 }
 
 void TurretManager::ResetAllFireTimers() {
+    ready_turrets_.clear();
     for (auto& turret : turrets_) {
         if (turret) {
             turret->ResetFireTimer();
+            if (turret->CanFire()) {
+                ready_turrets_.push_back(turret.get());
+            }
         }
     }
 }
@@ -126,6 +178,16 @@ int TurretManager::GetActiveTurretCount() const {
     return count;
 }
 
+float TurretManager::GetEngagementRadius() const {
+    float radius = 0.0f;
+    for (const auto& turret : turrets_) {
+        if (turret && turret->IsActive()) {
+            radius = std::max(radius, CalculateDistanceFromCenter(turret->GetPosition()) + turret->GetRange());
+        }
+    }
+    return radius;
+}
+
 bool TurretManager::IsValidPlacement(const glm::vec3& position) const {
     // Check if position is within placement bounds
     if (!IsWithinPlacementBounds(position)) {
@@ -187,9 +249,18 @@ bool TurretManager::RemoveTurretAtPosition(const glm::vec3& position, float radi
                       << (*it)->GetPosition().x << ", " 
                       << (*it)->GetPosition().y << ", " 
                       << (*it)->GetPosition().z << std::endl;
+            ForgetReadyTurret(it->get());
+            if (flow_field_) {
+                flow_field_->RemoveZone((*it)->GetPosition(), kExclusionRadius);
+            }
             turrets_.erase(it);
             return true;
         }
     }
     return false;
 }
+
+void TurretManager::ForgetReadyTurret(const Turret* turret) {
+    ready_turrets_.erase(std::remove(ready_turrets_.begin(), ready_turrets_.end(), turret),
+                         ready_turrets_.end());
+}
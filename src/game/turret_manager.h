@@ -7,8 +7,12 @@
 #include <memory>
 #include <glm/glm.hpp>
 
+class FlowField;
+
 class TurretManager {
 public:
+    static constexpr float kExclusionRadius = 3.0f; // Zone enemies path around, per turret
+
     TurretManager();
     ~TurretManager();
 
@@ -18,6 +22,10 @@ public:
     // Update all turrets
     void Update(float delta_time, const std::vector<std::unique_ptr<Enemy>>& enemies);
     void SetProjectileManager(class ProjectileManager* projectile_manager);
+    void SetSimClock(SimClock* sim_clock) { sim_clock_ = sim_clock; }
+    void SetTargetingIndex(const TargetingIndex* targeting_index) { targeting_index_ = targeting_index; }
+    // Placing or removing a turret updates its exclusion zone in the field
+    void SetFlowField(FlowField* flow_field) { flow_field_ = flow_field; }
 
     // Render all turrets
     void Render();
@@ -35,6 +43,7 @@ public:
     int GetActiveTurretCount() const;
     int GetMaxTurrets() const { return max_turrets_; }
     bool CanPlaceMoreTurrets() const { return GetTurretCount() < max_turrets_; }
+    float GetEngagementRadius() const; // Farthest distance from the core any turret can hit
 
     // Placement validation
     bool IsValidPlacement(const glm::vec3& position) const;
@@ -60,9 +69,16 @@ private:
     int max_turrets_;                    // Maximum number of turrets allowed
     
     class ProjectileManager* projectile_manager_;
+    SimClock* sim_clock_;
+    const TargetingIndex* targeting_index_;
+    FlowField* flow_field_;
+    
+    // Turrets whose reload has finished and that are waiting for a target
+    std::vector<Turret*> ready_turrets_;
     
     // Helper functions
     float CalculateDistanceFromCenter(const glm::vec3& position) const;
     bool IsTooCloseToOtherTurrets(const glm::vec3& position) const;
     bool IsWithinPlacementBounds(const glm::vec3& position) const;
+    void ForgetReadyTurret(const Turret* turret);
 };
@@ -8,17 +8,19 @@
 #include "core/input.h"
 #include "graphics/shader.h"
 #include "graphics/font.h"
+#include "graphics/render_queue.h"
 #include "graphics/camera.h"
+#include "utils/debug_draw.h"
+#include "utils/metrics.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <vector>
 #include <algorithm>
-#include <glad/glad.h>
-#include <glm/gtc/matrix_transform.hpp>
 
 UIManager::UIManager()
-    : shader_(nullptr)
+    : render_queue_(nullptr)
+    , shape_shader_(nullptr)
     , text_shader_(nullptr)
     , font_(nullptr)
     , initialized_(false) {
@@ -28,16 +30,17 @@ UIManager::~UIManager() {
     Shutdown();
 }
 
-bool UIManager::Initialize(Shader* shader) {
-    if (!shader) {
-        std::cerr << "UIManager: Shader is null!" << std::endl;
+bool UIManager::Initialize(RenderQueue* render_queue) {
+    if (!render_queue) {
+        std::cerr << "UIManager: Render queue is null!" << std::endl;
         return false;
     }
     
-    shader_ = shader;
+    render_queue_ = render_queue;
     
-    // Загружаем текстовый шейдер
+    // Загружаем шейдеры текста и плоских фигур
     text_shader_ = new Shader();
+    shape_shader_ = new Shader();
     
     // Пробуем разные пути к текстовым шейдерам
     std::vector<std::string> shader_paths = {
@@ -51,7 +54,8 @@ bool UIManager::Initialize(Shader* shader) {
     for (const auto& path : shader_paths) {
         std::string vs_path = path + "text.vs";
         std::string fs_path = path + "text.fs";
-        if (text_shader_->LoadFromFiles(vs_path, fs_path)) {
+        if (text_shader_->LoadFromFiles(vs_path, fs_path) &&
+            shape_shader_->LoadFromFiles(path + "overlay.vert", path + "overlay.frag")) {
             std::cout << "Text shader loaded successfully from: " << path << std::endl;
             text_shader_loaded = true;
             break;
@@ -62,6 +66,8 @@ bool UIManager::Initialize(Shader* shader) {
         std::cout << "UIManager::Initialize: Failed to load text shader from any path" << std::endl;
         delete text_shader_;
         text_shader_ = nullptr;
+        delete shape_shader_;
+        shape_shader_ = nullptr;
         return false;
     }
     
@@ -95,9 +101,14 @@ bool UIManager::Initialize(Shader* shader) {
         font_ = nullptr;
         delete text_shader_;
         text_shader_ = nullptr;
+        delete shape_shader_;
+        shape_shader_ = nullptr;
         return false;
     }
     
+    // UI draws are emitted as commands and submitted by the queue's 2D passes
+    render_queue_->SetOverlayShaders(shape_shader_, text_shader_);
+    
     initialized_ = true;
     
     std::cout << "UI Manager initialized successfully with font!" << std::endl;
@@ -105,27 +116,12 @@ bool UIManager::Initialize(Shader* shader) {
 }
 
 void UIManager::RenderWithTurrets(WaveManager* wave_manager, class TurretManager* turret_manager, int window_width, int window_height) {
-    if (!initialized_ || !wave_manager || !shader_) return;
+    if (!initialized_ || !wave_manager) return;
     
     // Обновляем размеры viewport
     viewport_width_ = window_width;
     viewport_height_ = window_height;
     
-    // Сохраняем текущее состояние
-    GLboolean depth_test_enabled = glIsEnabled(GL_DEPTH_TEST);
-    
-    // Отключаем depth test для UI
-    glDisable(GL_DEPTH_TEST);
-    
-    // Используем наш shader
-    shader_->Use();
-    
-    // Создаём ортографическую проекцию для 2D UI
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    shader_->SetUniform("projection", projection);
-    shader_->SetUniform("view", view);
-    
     // Получаем данные
     int current_wave = wave_manager->GetCurrentWave();
     int score = wave_manager->GetTotalScore();
@@ -189,35 +185,15 @@ void UIManager::RenderWithTurrets(WaveManager* wave_manager, class TurretManager
     } else if (!is_wave_active && time_till_wave > 0.0f) {
         RenderText("PREPARING...", window_width/2 - 80.0f, window_height/2 - 20.0f, 1.5f, yellow_color);
     }
-    
-    // Восстанавливаем состояние
-    if (depth_test_enabled) {
-        glEnable(GL_DEPTH_TEST);
-    }
 }
 
 void UIManager::Render(WaveManager* wave_manager, int window_width, int window_height) {
-    if (!initialized_ || !wave_manager || !shader_) return;
+    if (!initialized_ || !wave_manager) return;
     
     // Обновляем размеры viewport (КРИТИЧЕСКИ ВАЖНО!)
     viewport_width_ = window_width;
     viewport_height_ = window_height;
     
-    // Сохраняем текущее состояние
-    GLboolean depth_test_enabled = glIsEnabled(GL_DEPTH_TEST);
-    
-    // Отключаем depth test для UI
-    glDisable(GL_DEPTH_TEST);
-    
-    // Используем наш shader
-    shader_->Use();
-    
-    // Создаём ортографическую проекцию для 2D UI
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    shader_->SetUniform("projection", projection);
-    shader_->SetUniform("view", view);
-    
     // Получаем данные от WaveManager
     int current_wave = wave_manager->GetCurrentWave();
     int score = wave_manager->GetTotalScore();
@@ -273,51 +249,72 @@ void UIManager::Render(WaveManager* wave_manager, int window_width, int window_h
     } else if (!is_wave_active && time_till_wave > 0.0f) {
         RenderText("PREPARING...", window_width/2 - 80.0f, window_height/2 - 20.0f, 1.5f, yellow_color);
     }
+}
+
+void UIManager::RenderPausedOverlay(int window_width, int window_height) {
+    if (!font_ || !text_shader_) return;
+    viewport_width_ = window_width;
+    viewport_height_ = window_height;
+    RenderText("PAUSED", window_width/2 - 80.0f, window_height/2 - 20.0f, 1.5f, glm::vec3(1.0f));
+}
+
+void UIManager::RenderDebugOverlay(int window_width, int window_height) {
+    if (!font_ || !text_shader_) return;
+    viewport_width_ = window_width;
+    viewport_height_ = window_height;
     
-    // Восстанавливаем состояние
-    if (depth_test_enabled) {
-        glEnable(GL_DEPTH_TEST);
+    // Renderer counters, frame timing (sim, publish wait, latency) and GL trace totals;
+    // per-subsystem GL counts (gl.<subsystem>.<counter>) only go to the CSV
+    const char* prefixes[] = {"render.", "frame.", "gl."};
+    std::vector<std::string> lines;
+    for (const std::string prefix : prefixes) {
+        for (const auto& counter : Metrics::GetLastFrame()) {
+            if (counter.first.compare(0, prefix.size(), prefix) != 0) continue;
+            if (prefix == "gl." && counter.first.find('.', prefix.size()) != std::string::npos) continue;
+            std::ostringstream line;
+            line << counter.first.substr(prefix.size()) << ": " << counter.second;
+            lines.push_back(line.str());
+        }
+    }
+    if (lines.empty()) return;
+    
+    const float line_height = 20.0f;
+    float y = window_height - 20.0f - line_height * static_cast<float>(lines.size() - 1);
+    for (const std::string& line : lines) {
+        RenderText(line, 20.0f, y, 0.5f, glm::vec3(0.7f, 1.0f, 0.7f));
+        y += line_height;
     }
 }
 
-void UIManager::RenderPausedOverlay(int window_width, int window_height) {
+void UIManager::RenderDebugLabels(const glm::mat4& view_projection, int window_width, int window_height) {
     if (!font_ || !text_shader_) return;
     viewport_width_ = window_width;
     viewport_height_ = window_height;
-    GLboolean depth_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST);
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 1.0f));
-    text_shader_->SetUniform("text", 0);
-    font_->RenderText("PAUSED", window_width/2 - 80.0f, window_height/2 - 20.0f, 1.5f, glm::vec3(1.0f));
-    if (depth_enabled) glEnable(GL_DEPTH_TEST);
+    
+    for (const DebugLabel& label : DebugDraw::GetLabels()) {
+        glm::vec4 clip = view_projection * glm::vec4(label.position, 1.0f);
+        if (clip.w <= 0.0f) continue; // Behind the camera
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        if (ndc.x < -1.0f || ndc.x > 1.0f || ndc.y < -1.0f || ndc.y > 1.0f) continue;
+        float x = (ndc.x * 0.5f + 0.5f) * static_cast<float>(window_width);
+        float y = (0.5f - ndc.y * 0.5f) * static_cast<float>(window_height);
+        RenderText(label.text, x, y, 0.4f, label.color);
+    }
 }
 
 void UIManager::RenderTooltip(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
     if (!font_ || !text_shader_) return;
     
-    GLboolean depth_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST);
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text_color", color);
-    text_shader_->SetUniform("text", 0);
-    font_->RenderText(text, x, y, scale, color);
-    if (depth_enabled) glEnable(GL_DEPTH_TEST);
+    RenderText(text, x, y, scale, color);
 }
 
-void UIManager::RenderTurretMenu(class Turret* turret, class Camera* camera, class InputManager* input, class ItemManager* item_manager, int selected_inventory_index, int window_width, int window_height, bool& sell_clicked, int& slot_clicked, int& inventory_clicked) {
+void UIManager::RenderTurretMenu(class Turret* turret, class Camera* camera, class InputManager* input, class ItemManager* item_manager, int selected_inventory_index, int window_width, int window_height, bool& sell_clicked, int& slot_clicked, int& inventory_clicked, bool& policy_clicked) {
     if (!font_ || !text_shader_ || !camera || !input || !turret || !item_manager) return;
     
     sell_clicked = false;
     slot_clicked = -1;
     inventory_clicked = -1;
-    
-    GLboolean depth_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST);
+    policy_clicked = false;
     
     // Menu at bottom center of screen
     float menu_width = 600.0f;
@@ -326,42 +323,38 @@ void UIManager::RenderTurretMenu(class Turret* turret, class Camera* camera, cla
     float menu_y = window_height - menu_height - 20.0f;
     
     // Semi-transparent background instead of full black
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glColor4f(0.0f, 0.0f, 0.0f, 0.5f); // Semi-transparent black
-    glBegin(GL_QUADS);
-    glVertex2f(0.0f, 0.0f);
-    glVertex2f((float)window_width, 0.0f);
-    glVertex2f((float)window_width, (float)window_height);
-    glVertex2f(0.0f, (float)window_height);
-    glEnd();
-    glDisable(GL_BLEND);
-    
-    text_shader_->Use();
-    glm::mat4 text_projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f);
-    text_shader_->SetUniform("projection", text_projection);
-    text_shader_->SetUniform("text", 0);
+    render_queue_->SubmitRect(0.0f, 0.0f, (float)window_width, (float)window_height,
+                              glm::vec4(0.0f, 0.0f, 0.0f, 0.5f)); // Semi-transparent black
     
     glm::vec2 mouse = input->GetMousePosition();
     float y_offset = menu_y + 10.0f;
     
     // Title
-    text_shader_->SetUniform("text_color", glm::vec3(0.0f, 1.0f, 1.0f));
-    font_->RenderText("TURRET MANAGEMENT", menu_x + 10.0f, y_offset, 0.9f, glm::vec3(0.0f, 1.0f, 1.0f));
+    RenderText("TURRET MANAGEMENT", menu_x + 10.0f, y_offset, 0.9f, glm::vec3(0.0f, 1.0f, 1.0f));
     y_offset += 30.0f;
     
     // Turret stats
-    text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 1.0f));
-    font_->RenderText("DMG:" + std::to_string(static_cast<int>(turret->GetDamage())), menu_x + 10.0f, y_offset, 0.7f, glm::vec3(1.0f));
-    font_->RenderText("RATE:" + std::to_string(static_cast<int>(turret->GetFireRate())), menu_x + 100.0f, y_offset, 0.7f, glm::vec3(1.0f));
-    font_->RenderText("RNG:" + std::to_string(static_cast<int>(turret->GetRange())), menu_x + 200.0f, y_offset, 0.7f, glm::vec3(1.0f));
+    RenderText("DMG:" + std::to_string(static_cast<int>(turret->GetDamage())), menu_x + 10.0f, y_offset, 0.7f, glm::vec3(1.0f));
+    RenderText("RATE:" + std::to_string(static_cast<int>(turret->GetFireRate())), menu_x + 100.0f, y_offset, 0.7f, glm::vec3(1.0f));
+    RenderText("RNG:" + std::to_string(static_cast<int>(turret->GetRange())), menu_x + 200.0f, y_offset, 0.7f, glm::vec3(1.0f));
+    
+    // Targeting policy - click to cycle
+    float policy_x = menu_x + 300.0f;
+    float policy_w = 180.0f;
+    float policy_h = 20.0f;
+    bool mouse_over_policy = (mouse.x >= policy_x && mouse.x <= policy_x + policy_w &&
+                              mouse.y >= y_offset && mouse.y <= y_offset + policy_h);
+    glm::vec3 policy_color = mouse_over_policy ? glm::vec3(1.0f, 1.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 1.0f);
+    RenderText(std::string("TARGET:") + GetTargetingPolicyName(turret->GetTargetingPolicy()), policy_x, y_offset, 0.7f, policy_color);
+    if (mouse_over_policy && input->IsMouseButtonJustPressed(0)) {
+        policy_clicked = true;
+    }
     y_offset += 30.0f;
     
     // Item slots (3 slots) - показываем сколько установлено
-    text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 0.0f));
     int equipped_count = turret->GetEquippedItemCount();
     std::string slots_text = "SLOTS: " + std::to_string(equipped_count) + "/3";
-    font_->RenderText(slots_text, menu_x + 10.0f, y_offset, 0.8f, glm::vec3(1.0f, 1.0f, 0.0f));
+    RenderText(slots_text, menu_x + 10.0f, y_offset, 0.8f, glm::vec3(1.0f, 1.0f, 0.0f));
     y_offset += 25.0f;
     
     const auto& slots = turret->GetItemSlots();
@@ -382,10 +375,10 @@ void UIManager::RenderTurretMenu(class Turret* turret, class Camera* camera, cla
             std::string item_name = slots[i]->GetName();
             // Shorten if too long
             if (item_name.length() > 20) item_name = item_name.substr(0, 17) + "...";
-            font_->RenderText(item_name, slot_x, slot_y, 0.5f, slot_color);
+            RenderText(item_name, slot_x, slot_y, 0.5f, slot_color);
         } else {
             // Empty slot - clickable
-            font_->RenderText("[SLOT " + std::to_string(i+1) + " - EMPTY]", slot_x, slot_y, 0.5f, slot_color);
+            RenderText("[SLOT " + std::to_string(i+1) + " - EMPTY]", slot_x, slot_y, 0.5f, slot_color);
         }
         
         // Click detection
@@ -399,11 +392,7 @@ void UIManager::RenderTurretMenu(class Turret* turret, class Camera* camera, cla
     RenderInventoryGridWithClicks(item_manager, input, selected_inventory_index, window_width, window_height, inventory_clicked);
     
     // Show hint
-    text_shader_->Use();
-    text_shader_->SetUniform("projection", glm::ortho(0.0f, (float)window_width, (float)window_height, 0.0f));
-    text_shader_->SetUniform("text", 0);
-    text_shader_->SetUniform("text_color", glm::vec3(0.7f, 0.7f, 0.7f));
-    font_->RenderText("Click item from grid, then click slot. ESC to close.", menu_x + 10.0f, y_offset, 0.5f, glm::vec3(0.7f, 0.7f, 0.7f));
+    RenderText("Click item from grid, then click slot. ESC to close.", menu_x + 10.0f, y_offset, 0.5f, glm::vec3(0.7f, 0.7f, 0.7f));
     y_offset += 25.0f;
     
     // SELL button
@@ -415,14 +404,11 @@ void UIManager::RenderTurretMenu(class Turret* turret, class Camera* camera, cla
                             mouse.y >= sell_y && mouse.y <= sell_y + sell_h);
     
     glm::vec3 sell_color = mouse_over_sell ? glm::vec3(1.0f, 0.5f, 0.0f) : glm::vec3(1.0f, 0.2f, 0.2f);
-    text_shader_->SetUniform("text_color", sell_color);
-    font_->RenderText("SELL (50%)", sell_x, sell_y, 0.8f, sell_color);
+    RenderText("SELL (50%)", sell_x, sell_y, 0.8f, sell_color);
     
     if (mouse_over_sell && input->IsMouseButtonJustPressed(0)) {
         sell_clicked = true;
     }
-    
-    if (depth_enabled) glEnable(GL_DEPTH_TEST);
 }
 
 void UIManager::RenderInventoryScreen(class ItemManager* item_manager, int window_width, int window_height) {
@@ -431,30 +417,16 @@ void UIManager::RenderInventoryScreen(class ItemManager* item_manager, int windo
     viewport_width_ = window_width;
     viewport_height_ = window_height;
     
-    GLboolean depth_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST);
-    
     // No background - inventory is transparent overlay on game
     // This allows seeing the game while browsing inventory
     
     // Render inventory grid
     RenderInventoryGrid(item_manager, window_width, window_height);
-    
-    if (depth_enabled) glEnable(GL_DEPTH_TEST);
 }
 
 void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_width, int window_height) {
     if (!font_ || !text_shader_ || !item_manager || !item_manager->GetItemDatabase()) return;
     
-    // Enable text rendering
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)window_width, (float)window_height, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text", 0);
-    
     // Grid constants - centered with wider cells
     const float CELL_SIZE = 100.0f;  // Wider cells for text
     const float CELL_SPACING = 15.0f;
@@ -462,12 +434,10 @@ void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_
     const float START_Y = 250.0f;   // Lower to avoid top UI
     
     // Title
-    text_shader_->SetUniform("text_color", glm::vec3(0.0f, 1.0f, 1.0f));
-    font_->RenderText("ITEM INVENTORY", floorf(START_X), 150.0f, 1.2f, glm::vec3(0.0f, 1.0f, 1.0f));
+    RenderText("ITEM INVENTORY", floorf(START_X), 150.0f, 1.2f, glm::vec3(0.0f, 1.0f, 1.0f));
     
     // Subtitle
-    text_shader_->SetUniform("text_color", glm::vec3(0.7f, 0.7f, 0.7f));
-    font_->RenderText("(View Only)", floorf(START_X), 180.0f, 0.7f, glm::vec3(0.7f, 0.7f, 0.7f));
+    RenderText("(View Only)", floorf(START_X), 180.0f, 0.7f, glm::vec3(0.7f, 0.7f, 0.7f));
     
     // Get inventory grid from database
     auto grid = item_manager->GetItemDatabase()->GetInventoryGrid();
@@ -478,8 +448,7 @@ void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_
     };
     
     // Header row label
-    text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 1.0f));
-    font_->RenderText("Rarity", floorf(START_X - 90.0f), floorf(START_Y - 30.0f), 0.7f, glm::vec3(1.0f, 1.0f, 1.0f));
+    RenderText("Rarity", floorf(START_X - 90.0f), floorf(START_Y - 30.0f), 0.7f, glm::vec3(1.0f, 1.0f, 1.0f));
     
     for (int col = 0; col < 5; ++col) {
         float x = floorf(START_X + col * (CELL_SIZE + CELL_SPACING));
@@ -494,8 +463,7 @@ void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_
             case 4: header_color = glm::vec3(1.0f, 0.3f, 0.0f); break; // Legendary - Red/Orange
         }
         
-        text_shader_->SetUniform("text_color", header_color);
-        font_->RenderText(rarity_names[col], x, floorf(START_Y - 30.0f), 0.6f, header_color);
+        RenderText(rarity_names[col], x, floorf(START_Y - 30.0f), 0.6f, header_color);
     }
     
     // Render row headers (stat types)
@@ -505,8 +473,7 @@ void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_
     
     for (int row = 0; row < 4; ++row) {
         float y = floorf(START_Y + row * (CELL_SIZE + CELL_SPACING));
-        text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 1.0f));
-        font_->RenderText(stat_names[row], floorf(START_X - 90.0f), y, 0.7f, glm::vec3(1.0f, 1.0f, 1.0f));
+        RenderText(stat_names[row], floorf(START_X - 90.0f), y, 0.7f, glm::vec3(1.0f, 1.0f, 1.0f));
     }
     
     // Render grid cells
@@ -526,62 +493,46 @@ void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_
             }
             
             // Render cell background with rarity colors
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            
+            glm::vec4 cell_color;
             if (discovered && quantity > 0) {
                 // Color by rarity for discovered items
                 switch (col) {
                     case 0: // Common
-                        glColor4f(0.8f, 0.8f, 0.8f, 0.6f); // Light gray
+                        cell_color = glm::vec4(0.8f, 0.8f, 0.8f, 0.6f); // Light gray
                         break;
                     case 1: // Uncommon
-                        glColor4f(0.2f, 0.8f, 0.2f, 0.6f); // Green
+                        cell_color = glm::vec4(0.2f, 0.8f, 0.2f, 0.6f); // Green
                         break;
                     case 2: // Rare
-                        glColor4f(0.3f, 0.5f, 1.0f, 0.6f); // Blue
+                        cell_color = glm::vec4(0.3f, 0.5f, 1.0f, 0.6f); // Blue
                         break;
                     case 3: // Epic
-                        glColor4f(0.7f, 0.3f, 1.0f, 0.6f); // Purple
+                        cell_color = glm::vec4(0.7f, 0.3f, 1.0f, 0.6f); // Purple
                         break;
                     case 4: // Legendary
-                        glColor4f(1.0f, 0.3f, 0.0f, 0.6f); // Red/Orange
+                        cell_color = glm::vec4(1.0f, 0.3f, 0.0f, 0.6f); // Red/Orange
                         break;
                 }
             } else {
                 // Dark gray background for undiscovered items
-                glColor4f(0.2f, 0.2f, 0.2f, 0.5f);
+                cell_color = glm::vec4(0.2f, 0.2f, 0.2f, 0.5f);
             }
             
-            glBegin(GL_QUADS);
-            glVertex2f(x, y);
-            glVertex2f(x + CELL_SIZE, y);
-            glVertex2f(x + CELL_SIZE, y + CELL_SIZE);
-            glVertex2f(x, y + CELL_SIZE);
-            glEnd();
+            render_queue_->SubmitRect(x, y, CELL_SIZE, CELL_SIZE, cell_color);
             
             // Render cell border
-            glColor4f(0.5f, 0.5f, 0.5f, 1.0f);
-            glBegin(GL_LINE_LOOP);
-            glVertex2f(x, y);
-            glVertex2f(x + CELL_SIZE, y);
-            glVertex2f(x + CELL_SIZE, y + CELL_SIZE);
-            glVertex2f(x, y + CELL_SIZE);
-            glEnd();
+            render_queue_->SubmitRectOutline(x, y, CELL_SIZE, CELL_SIZE, glm::vec4(0.5f, 0.5f, 0.5f, 1.0f));
             
             // Render cell content
             if (discovered && quantity > 0) {
                 // Show quantity prominently
-                text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 1.0f));
-                font_->RenderText(std::to_string(quantity), floorf(x + 30.0f), floorf(y + 35.0f), 1.2f, glm::vec3(1.0f, 1.0f, 1.0f));
+                RenderText(std::to_string(quantity), floorf(x + 30.0f), floorf(y + 35.0f), 1.2f, glm::vec3(1.0f, 1.0f, 1.0f));
                 
                 // Show checkmark in corner
-                text_shader_->SetUniform("text_color", glm::vec3(0.0f, 1.0f, 0.0f));
-                font_->RenderText("+", floorf(x + CELL_SIZE - 20.0f), floorf(y + 15.0f), 0.8f, glm::vec3(0.0f, 1.0f, 0.0f));
+                RenderText("+", floorf(x + CELL_SIZE - 20.0f), floorf(y + 15.0f), 0.8f, glm::vec3(0.0f, 1.0f, 0.0f));
             } else {
                 // Show question mark for undiscovered
-                text_shader_->SetUniform("text_color", glm::vec3(0.5f, 0.5f, 0.5f));
-                font_->RenderText("?", floorf(x + 40.0f), floorf(y + 40.0f), 1.0f, glm::vec3(0.5f, 0.5f, 0.5f));
+                RenderText("?", floorf(x + 40.0f), floorf(y + 40.0f), 1.0f, glm::vec3(0.5f, 0.5f, 0.5f));
             }
             
             // Render item name below the cell
@@ -640,8 +591,7 @@ void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_
                 }
                 
                 // Render item name below the cell
-                text_shader_->SetUniform("text_color", name_color);
-                font_->RenderText(item_name, floorf(x), floorf(y + CELL_SIZE + 5.0f), 0.35f, name_color);
+                RenderText(item_name, floorf(x), floorf(y + CELL_SIZE + 5.0f), 0.35f, name_color);
             }
         }
     }
@@ -660,20 +610,16 @@ void UIManager::RenderInventoryGrid(class ItemManager* item_manager, int window_
     
     std::stringstream ss;
     ss << "Item types discovered: " << discovered_count << " / " << total_count;
-    text_shader_->SetUniform("text_color", glm::vec3(0.0f, 1.0f, 1.0f));
-    font_->RenderText(ss.str(), floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 30.0f), 0.8f, glm::vec3(0.0f, 1.0f, 1.0f));
+    RenderText(ss.str(), floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 30.0f), 0.8f, glm::vec3(0.0f, 1.0f, 1.0f));
     
     std::stringstream ss2;
     ss2 << "Total items: " << total_quantity;
-    text_shader_->SetUniform("text_color", glm::vec3(0.0f, 1.0f, 1.0f));
-    font_->RenderText(ss2.str(), floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 50.0f), 0.8f, glm::vec3(0.0f, 1.0f, 1.0f));
+    RenderText(ss2.str(), floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 50.0f), 0.8f, glm::vec3(0.0f, 1.0f, 1.0f));
     
     // Hints
-    text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 0.0f));
-    font_->RenderText("Press ESC or I to close", floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 70.0f), 0.7f, glm::vec3(1.0f, 1.0f, 0.0f));
+    RenderText("Press ESC or I to close", floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 70.0f), 0.7f, glm::vec3(1.0f, 1.0f, 0.0f));
     
-    text_shader_->SetUniform("text_color", glm::vec3(0.5f, 0.8f, 1.0f));
-    font_->RenderText("To equip items: Right-click a turret to open upgrade menu", floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 95.0f), 0.6f, glm::vec3(0.5f, 0.8f, 1.0f));
+    RenderText("To equip items: Right-click a turret to open upgrade menu", floorf(START_X), floorf(START_Y + 4 * (CELL_SIZE + CELL_SPACING) + 95.0f), 0.6f, glm::vec3(0.5f, 0.8f, 1.0f));
 }
 
 void UIManager::RenderItemGrid(ItemManager* item_manager, InputManager* input, int selected_index,
@@ -682,11 +628,6 @@ void UIManager::RenderItemGrid(ItemManager* item_manager, InputManager* input, i
     
     clicked_item_index = -1;
     
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)window_width, (float)window_height, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text", 0);
-    
     // Grid settings
     const float grid_x = window_width - 650.0f; // Right side, more space from edge
     const float grid_y = 100.0f; // Lower from top
@@ -695,14 +636,12 @@ void UIManager::RenderItemGrid(ItemManager* item_manager, InputManager* input, i
     const int columns = 2;
     
     // Title
-    text_shader_->SetUniform("text_color", glm::vec3(0.0f, 1.0f, 1.0f));
-    font_->RenderText("INVENTORY", grid_x, grid_y, 0.9f, glm::vec3(0.0f, 1.0f, 1.0f));
+    RenderText("INVENTORY", grid_x, grid_y, 0.9f, glm::vec3(0.0f, 1.0f, 1.0f));
     
     // Get inventory
     const auto& inventory = item_manager->GetInventory();
     if (inventory.empty()) {
-        text_shader_->SetUniform("text_color", glm::vec3(0.6f, 0.6f, 0.6f));
-        font_->RenderText("Empty", grid_x, grid_y + 35.0f, 0.6f, glm::vec3(0.6f, 0.6f, 0.6f));
+        RenderText("Empty", grid_x, grid_y + 35.0f, 0.6f, glm::vec3(0.6f, 0.6f, 0.6f));
         return;
     }
     
@@ -748,8 +687,7 @@ void UIManager::RenderItemGrid(ItemManager* item_manager, InputManager* input, i
             name = name.substr(0, 25) + "...";
         }
         
-        text_shader_->SetUniform("text_color", color);
-        font_->RenderText(name, cell_x, cell_y, 0.7f, color); // Bigger font
+        RenderText(name, cell_x, cell_y, 0.7f, color); // Bigger font
         
         // Click detection
         if (mouse_over && input->IsMouseButtonJustPressed(0)) {
@@ -772,74 +710,49 @@ void UIManager::RenderMainMenu(int window_width, int window_height, int selected
     if (!font_ || !text_shader_) return;
     viewport_width_ = window_width;
     viewport_height_ = window_height;
-    GLboolean depth_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST);
     // Dim background
     RenderDimBackground(window_width, window_height, 0.4f);
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text", 0);
     float cx = window_width / 2.0f - 100.0f;
     float cy = window_height / 2.0f - 60.0f;
     const char* items[3] = {"START GAME", "OPTIONS", "EXIT"};
     for (int i = 0; i < 3; ++i) {
         glm::vec3 c = (i == selected_index) ? glm::vec3(1.0f, 1.0f, 0.0f) : glm::vec3(1.0f);
-        text_shader_->SetUniform("text_color", c);
-        font_->RenderText(items[i], cx, cy + i * 30.0f, 1.0f, c);
+        RenderText(items[i], cx, cy + i * 30.0f, 1.0f, c);
     }
-    if (depth_enabled) glEnable(GL_DEPTH_TEST);
 }
 
 void UIManager::RenderOptionsMenu(int window_width, int window_height, int selected_index) {
     if (!font_ || !text_shader_) return;
     viewport_width_ = window_width;
     viewport_height_ = window_height;
-    GLboolean depth_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST);
     // Dim background
     RenderDimBackground(window_width, window_height, 0.4f);
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text", 0);
     float cx = window_width / 2.0f - 140.0f;
     float cy = window_height / 2.0f - 90.0f;
     const char* items[4] = {"1280x720", "1920x1080", "2560x1440", "3840x2160"};
     for (int i = 0; i < 4; ++i) {
         glm::vec3 c = (i == selected_index) ? glm::vec3(0.0f, 1.0f, 1.0f) : glm::vec3(1.0f);
-        text_shader_->SetUniform("text_color", c);
-        font_->RenderText(items[i], cx, cy + i * 30.0f, 1.0f, c);
+        RenderText(items[i], cx, cy + i * 30.0f, 1.0f, c);
     }
-    text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 0.0f));
-    font_->RenderText("ENTER: APPLY, ESC: BACK", cx, cy + 4 * 30.0f + 20.0f, 0.8f, glm::vec3(1.0f,1.0f,0.0f));
-    if (depth_enabled) glEnable(GL_DEPTH_TEST);
+    RenderText("ENTER: APPLY, ESC: BACK", cx, cy + 4 * 30.0f + 20.0f, 0.8f, glm::vec3(1.0f,1.0f,0.0f));
 }
 
 void UIManager::RenderGameOverMenu(int window_width, int window_height, int selected_index, WaveManager* wave_manager) {
     if (!font_ || !text_shader_) return;
     viewport_width_ = window_width;
     viewport_height_ = window_height;
-    GLboolean depth_enabled = glIsEnabled(GL_DEPTH_TEST);
-    glDisable(GL_DEPTH_TEST);
     // Dim background
     RenderDimBackground(window_width, window_height, 0.6f);
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text", 0);
     
     // Game Over title
-    text_shader_->SetUniform("text_color", glm::vec3(1.0f, 0.0f, 0.0f));
-    font_->RenderText("GAME OVER", window_width / 2.0f - 120.0f, window_height / 2.0f - 100.0f, 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    RenderText("GAME OVER", window_width / 2.0f - 120.0f, window_height / 2.0f - 100.0f, 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
     
     // Stats
     if (wave_manager) {
         int wave = wave_manager->GetCurrentWave();
         int score = wave_manager->GetTotalScore();
-        text_shader_->SetUniform("text_color", glm::vec3(0.0f, 1.0f, 1.0f));
-        font_->RenderText("WAVE: " + std::to_string(wave), window_width / 2.0f - 80.0f, window_height / 2.0f - 40.0f, 1.2f, glm::vec3(0.0f, 1.0f, 1.0f));
-        font_->RenderText("SCORE: " + std::to_string(score), window_width / 2.0f - 80.0f, window_height / 2.0f - 10.0f, 1.2f, glm::vec3(0.0f, 1.0f, 1.0f));
+        RenderText("WAVE: " + std::to_string(wave), window_width / 2.0f - 80.0f, window_height / 2.0f - 40.0f, 1.2f, glm::vec3(0.0f, 1.0f, 1.0f));
+        RenderText("SCORE: " + std::to_string(score), window_width / 2.0f - 80.0f, window_height / 2.0f - 10.0f, 1.2f, glm::vec3(0.0f, 1.0f, 1.0f));
     }
     
     // Menu options
@@ -848,93 +761,25 @@ void UIManager::RenderGameOverMenu(int window_width, int window_height, int sele
     const char* items[2] = {"RESTART", "MAIN MENU"};
     for (int i = 0; i < 2; ++i) {
         glm::vec3 c = (i == selected_index) ? glm::vec3(1.0f, 1.0f, 0.0f) : glm::vec3(1.0f);
-        text_shader_->SetUniform("text_color", c);
-        font_->RenderText(items[i], cx, cy + i * 30.0f, 1.0f, c);
+        RenderText(items[i], cx, cy + i * 30.0f, 1.0f, c);
     }
-    
-    if (depth_enabled) glEnable(GL_DEPTH_TEST);
 }
 
 void UIManager::RenderDimBackground(int window_width, int window_height, float alpha) {
-    // Simple full-screen quad with shader_ color
-    if (!shader_) return;
-    shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)window_width, (float)window_height, 0.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
-    glm::mat4 model = glm::mat4(1.0f);
-    shader_->SetUniform("projection", projection);
-    shader_->SetUniform("view", view);
-    shader_->SetUniform("model", model);
-    shader_->SetUniform("color", glm::vec3(0.0f, 0.0f, 0.0f));
-    float vertices[] = {
-        0.0f, 0.0f,
-        (float)window_width, 0.0f,
-        (float)window_width, (float)window_height,
-        0.0f, 0.0f,
-        (float)window_width, (float)window_height,
-        0.0f, (float)window_height
-    };
-    unsigned int VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Use alpha via OpenGL blend state already enabled globally; color alpha simulated via shader color intensity on wireframe shader
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
-    glDeleteBuffers(1, &VBO);
-    glDeleteVertexArrays(1, &VAO);
+    // Simple full-screen quad (opaque; alpha is not applied)
+    if (!render_queue_) return;
+    render_queue_->SubmitRect(0.0f, 0.0f, (float)window_width, (float)window_height, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
 }
 
 void UIManager::RenderBar(float x, float y, float width, float height, float fill_percent, const glm::vec3& color) {
-    glm::mat4 model = glm::mat4(1.0f);
-    shader_->SetUniform("model", model);
+    if (!render_queue_) return;
     
     // Рисуем рамку
-    float outline_vertices[] = {
-        x, y,
-        x + width, y,
-        x + width, y + height,
-        x, y + height
-    };
-    
-    unsigned int VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(outline_vertices), outline_vertices, GL_STATIC_DRAW);
-    
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    shader_->SetUniform("color", color * 0.3f);
-    glDrawArrays(GL_LINE_LOOP, 0, 4);
+    render_queue_->SubmitRectOutline(x, y, width, height, glm::vec4(color * 0.3f, 1.0f));
     
     // Рисуем заполнение
     float fill_width = width * fill_percent;
-    float fill_vertices[] = {
-        x + 2, y + 2,
-        x + fill_width - 2, y + 2,
-        x + fill_width - 2, y + height - 2,
-        x + 2, y + 2,
-        x + fill_width - 2, y + height - 2,
-        x + 2, y + height - 2
-    };
-    
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(fill_vertices), fill_vertices, GL_STATIC_DRAW);
-    
-    shader_->SetUniform("color", color);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    
-    glBindVertexArray(0);
-    glDeleteBuffers(1, &VBO);
-    glDeleteVertexArrays(1, &VAO);
+    render_queue_->SubmitRect(x + 2, y + 2, fill_width - 4, height - 4, glm::vec4(color, 1.0f));
 }
 
 void UIManager::RenderNumber(int number, float x, float y, float scale, const glm::vec3& color) {
@@ -950,21 +795,10 @@ void UIManager::RenderDigit(int digit, float x, float y, float scale, const glm:
 }
 
 void UIManager::RenderText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
-    if (!font_ || !text_shader_) return;
-    
-    // Используем текстовый шейдер
-    text_shader_->Use();
+    if (!font_ || !render_queue_) return;
     
-    // Настраиваем шейдер для текста (используем реальный размер viewport)
-    glm::mat4 projection = glm::ortho(0.0f, (float)viewport_width_, (float)viewport_height_, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text_color", color);
-    
-    // Устанавливаем uniform для текстуры (КРИТИЧЕСКИ ВАЖНО!)
-    text_shader_->SetUniform("text", 0);
-    
-    // Рендерим текст через Font
-    font_->RenderText(text, x, y, scale, color);
+    // Глифы уходят в очередь; текстовый проход группирует их по текстуре
+    font_->QueueText(*render_queue_, text, x, y, scale, color);
 }
 
 void UIManager::RenderInventoryGridWithClicks(class ItemManager* item_manager, class InputManager* input, int selected_index, int window_width, int window_height, int& clicked_item_index) {
@@ -972,15 +806,6 @@ void UIManager::RenderInventoryGridWithClicks(class ItemManager* item_manager, c
     
     clicked_item_index = -1;
     
-    // Enable text rendering
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    
-    text_shader_->Use();
-    glm::mat4 projection = glm::ortho(0.0f, (float)window_width, (float)window_height, 0.0f);
-    text_shader_->SetUniform("projection", projection);
-    text_shader_->SetUniform("text", 0);
-    
     // Grid constants - on the right side
     const float CELL_SIZE = 60.0f;  // Smaller for turret menu
     const float CELL_SPACING = 8.0f;
@@ -1011,8 +836,7 @@ void UIManager::RenderInventoryGridWithClicks(class ItemManager* item_manager, c
             case 4: header_color = glm::vec3(1.0f, 0.3f, 0.0f); break; // Legendary
         }
         
-        text_shader_->SetUniform("text_color", header_color);
-        font_->RenderText(rarity_names[col], x + 5.0f, floorf(START_Y - 25.0f), 0.5f, header_color);
+        RenderText(rarity_names[col], x + 5.0f, floorf(START_Y - 25.0f), 0.5f, header_color);
     }
     
     // Render row headers (stat types)
@@ -1022,8 +846,7 @@ void UIManager::RenderInventoryGridWithClicks(class ItemManager* item_manager, c
     
     for (int row = 0; row < 4; ++row) {
         float y = floorf(START_Y + row * (CELL_SIZE + CELL_SPACING));
-        text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 1.0f));
-        font_->RenderText(stat_names[row], floorf(START_X - 45.0f), y + 20.0f, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
+        RenderText(stat_names[row], floorf(START_X - 45.0f), y + 20.0f, 0.5f, glm::vec3(1.0f, 1.0f, 1.0f));
     }
     
     // Render grid cells with click detection
@@ -1053,65 +876,48 @@ void UIManager::RenderInventoryGridWithClicks(class ItemManager* item_manager, c
             bool is_selected = (grid_index == selected_index);
             
             // Render cell background with rarity colors
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            
+            glm::vec4 cell_color;
             if (discovered && quantity > 0) {
                 // Color by rarity for discovered items
                 float alpha = mouse_over ? 0.8f : (is_selected ? 0.9f : 0.6f);
                 switch (col) {
                     case 0: // Common
-                        glColor4f(0.8f, 0.8f, 0.8f, alpha);
+                        cell_color = glm::vec4(0.8f, 0.8f, 0.8f, alpha);
                         break;
                     case 1: // Uncommon
-                        glColor4f(0.2f, 0.8f, 0.2f, alpha);
+                        cell_color = glm::vec4(0.2f, 0.8f, 0.2f, alpha);
                         break;
                     case 2: // Rare
-                        glColor4f(0.3f, 0.5f, 1.0f, alpha);
+                        cell_color = glm::vec4(0.3f, 0.5f, 1.0f, alpha);
                         break;
                     case 3: // Epic
-                        glColor4f(0.7f, 0.3f, 1.0f, alpha);
+                        cell_color = glm::vec4(0.7f, 0.3f, 1.0f, alpha);
                         break;
                     case 4: // Legendary
-                        glColor4f(1.0f, 0.3f, 0.0f, alpha);
+                        cell_color = glm::vec4(1.0f, 0.3f, 0.0f, alpha);
                         break;
                 }
             } else {
                 // Dark gray background for undiscovered items
-                glColor4f(0.2f, 0.2f, 0.2f, 0.5f);
+                cell_color = glm::vec4(0.2f, 0.2f, 0.2f, 0.5f);
             }
             
-            glBegin(GL_QUADS);
-            glVertex2f(x, y);
-            glVertex2f(x + CELL_SIZE, y);
-            glVertex2f(x + CELL_SIZE, y + CELL_SIZE);
-            glVertex2f(x, y + CELL_SIZE);
-            glEnd();
+            render_queue_->SubmitRect(x, y, CELL_SIZE, CELL_SIZE, cell_color);
             
             // Render cell border
             glm::vec3 border_color = is_selected ? glm::vec3(1.0f, 1.0f, 0.0f) : 
                                     (mouse_over ? glm::vec3(1.0f, 1.0f, 1.0f) : glm::vec3(0.5f, 0.5f, 0.5f));
             float border_width = is_selected ? 3.0f : (mouse_over ? 2.0f : 1.0f);
             
-            glColor4f(border_color.r, border_color.g, border_color.b, 1.0f);
-            glLineWidth(border_width);
-            glBegin(GL_LINE_LOOP);
-            glVertex2f(x, y);
-            glVertex2f(x + CELL_SIZE, y);
-            glVertex2f(x + CELL_SIZE, y + CELL_SIZE);
-            glVertex2f(x, y + CELL_SIZE);
-            glEnd();
-            glLineWidth(1.0f);
+            render_queue_->SubmitRectOutline(x, y, CELL_SIZE, CELL_SIZE, glm::vec4(border_color, 1.0f), border_width);
             
             // Render cell content
             if (discovered && quantity > 0) {
                 // Show quantity
-                text_shader_->SetUniform("text_color", glm::vec3(1.0f, 1.0f, 1.0f));
-                font_->RenderText(std::to_string(quantity), floorf(x + 20.0f), floorf(y + 20.0f), 0.8f, glm::vec3(1.0f, 1.0f, 1.0f));
+                RenderText(std::to_string(quantity), floorf(x + 20.0f), floorf(y + 20.0f), 0.8f, glm::vec3(1.0f, 1.0f, 1.0f));
             } else {
                 // Show question mark for undiscovered
-                text_shader_->SetUniform("text_color", glm::vec3(0.5f, 0.5f, 0.5f));
-                font_->RenderText("?", floorf(x + 22.0f), floorf(y + 22.0f), 0.7f, glm::vec3(0.5f, 0.5f, 0.5f));
+                RenderText("?", floorf(x + 22.0f), floorf(y + 22.0f), 0.7f, glm::vec3(0.5f, 0.5f, 0.5f));
             }
             
             // Click detection
@@ -1129,10 +935,18 @@ void UIManager::Shutdown() {
         delete font_;
         font_ = nullptr;
     }
+    if (render_queue_) {
+        render_queue_->SetOverlayShaders(nullptr, nullptr);
+        render_queue_ = nullptr;
+    }
     if (text_shader_) {
         delete text_shader_;
         text_shader_ = nullptr;
     }
+    if (shape_shader_) {
+        delete shape_shader_;
+        shape_shader_ = nullptr;
+    }
     initialized_ = false;
 }
 
@@ -8,18 +8,24 @@
 class Shader;
 class WaveManager;
 class Font;
+class RenderQueue;
 
 class UIManager {
 public:
     UIManager();
     ~UIManager();
 
-    bool Initialize(Shader* shader);
+    // UI draws become commands on `render_queue`; the caller flushes it once per frame
+    bool Initialize(RenderQueue* render_queue);
     void Render(WaveManager* wave_manager, int window_width, int window_height);
     void RenderWithTurrets(WaveManager* wave_manager, class TurretManager* turret_manager, int window_width, int window_height);
     void RenderPausedOverlay(int window_width, int window_height);
+    // Last frame's render.* performance counters, bottom left
+    void RenderDebugOverlay(int window_width, int window_height);
+    // Debug-draw labels, projected from world space with the camera's view-projection
+    void RenderDebugLabels(const glm::mat4& view_projection, int window_width, int window_height);
     void RenderTooltip(const std::string& text, float x, float y, float scale, const glm::vec3& color);
-    void RenderTurretMenu(class Turret* turret, class Camera* camera, class InputManager* input, class ItemManager* item_manager, int selected_inventory_index, int window_width, int window_height, bool& sell_clicked, int& slot_clicked, int& inventory_clicked);
+    void RenderTurretMenu(class Turret* turret, class Camera* camera, class InputManager* input, class ItemManager* item_manager, int selected_inventory_index, int window_width, int window_height, bool& sell_clicked, int& slot_clicked, int& inventory_clicked, bool& policy_clicked);
     void RenderInventoryScreen(class ItemManager* item_manager, int window_width, int window_height);
     
     // Render item grid on right side (for turret menu)
@@ -34,7 +40,8 @@ public:
     void Shutdown();
 
 private:
-    Shader* shader_;
+    RenderQueue* render_queue_;
+    Shader* shape_shader_;      // Flat 2D shapes (overlay pass)
     Shader* text_shader_;
     Font* font_;
     bool initialized_;
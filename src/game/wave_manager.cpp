@@ -2,6 +2,7 @@
 #include "wave_manager.h"
 #include "enemy_spawner.h"
 #include "item_manager.h"
+#include "damage_system.h"
 #include <iostream>
 #include <algorithm>
 #include <random>
@@ -9,14 +10,13 @@
 WaveManager::WaveManager()
     : enemy_spawner_(nullptr)
     , item_manager_(nullptr)
+    , sim_clock_(nullptr)
     , current_wave_(0)
     , wave_active_(false)
     , game_over_(false)
     , enemies_remaining_(0)
     , enemies_spawned_this_wave_(0)
     , enemies_to_spawn_this_wave_(0)
-    , wave_delay_timer_(0.0f)
-    , spawn_timer_(0.0f)
     , wave_delay_duration_(10.0f)     // 10 секунд между волнами для подготовки
     , initial_spawn_interval_(0.5f)   // 2 врага в секунду изначально
     , spawn_interval_(0.5f)
@@ -29,6 +29,13 @@ WaveManager::WaveManager()
     , starting_currency_(6) {         // Снижено в 10 раз
 }
 
+WaveManager::~WaveManager() {
+    if (sim_clock_) {
+        sim_clock_->Cancel(wave_timer_);
+        sim_clock_->Cancel(spawn_timer_);
+    }
+}
+
 void WaveManager::SetEnemySpawner(EnemySpawner* spawner) {
     enemy_spawner_ = spawner;
 }
@@ -45,11 +52,12 @@ void WaveManager::StartGame() {
     total_score_ = 0;
     core_health_ = 10; // Снижено в 10 раз
     currency_ = starting_currency_;
-    wave_delay_timer_ = 10.0f; // Увеличили задержку перед первой волной для подготовки
+    if (sim_clock_) sim_clock_->Cancel(spawn_timer_);
+    ScheduleNextWave(10.0f); // Увеличили задержку перед первой волной для подготовки
     
     std::cout << "=== GAME STARTED ===" << std::endl;
     std::cout << "Get ready for wave 1..." << std::endl;
-    std::cout << "Wave delay: " << wave_delay_timer_ << " seconds" << std::endl;
+    std::cout << "Wave delay: " << GetTimeTillNextWave() << " seconds" << std::endl;
     std::cout.flush();
 }
 
@@ -59,10 +67,15 @@ void WaveManager::StartNextWave() {
     current_wave_++;
     wave_active_ = true;
     enemies_spawned_this_wave_ = 0;
-    spawn_timer_ = 0.0f;
     
     CalculateWaveParameters();
     
+    // Первый враг появляется через один интервал спавна
+    if (sim_clock_) {
+        sim_clock_->Cancel(spawn_timer_);
+        spawn_timer_ = sim_clock_->Schedule(SimTimer::NextSpawn, spawn_interval_, this);
+    }
+    
     enemies_remaining_ = enemies_to_spawn_this_wave_;
     
     std::cout << "\n=== WAVE " << current_wave_ << " STARTED ===" << std::endl;
@@ -99,41 +112,42 @@ void WaveManager::UpdateEconomy() {
     // This allows credits to be awarded even when game is paused for turret menu
 }
 
-void WaveManager::OnEnemyDestroyed(const glm::vec3& enemy_position) {
-    if (enemies_remaining_ > 0) {
+void WaveManager::OnEnemiesDestroyed(const std::vector<EnemyDeath>& deaths) {
+    if (enemies_remaining_ <= 0) return;
+    
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+    static std::uniform_real_distribution<float> drop_chance(0.0f, 1.0f);
+    
+    drop_positions_.clear();
+    for (const EnemyDeath& death : deaths) {
+        if (enemies_remaining_ <= 0) break;
+        
         enemies_remaining_--;
         total_score_ += 1; // очки - снижено в 10 раз
-        // Немного большая награда за быстрых врагов (цвет желтый)
-        int reward = reward_per_enemy_;
-        // Простой способ: если у врага было меньше базового HP при смерти, добавим 20%
-        // (в дальнейшем можно хранить тип врага явно)
-        reward = reward_per_enemy_;
-        currency_ += reward; // валюта
+        currency_ += reward_per_enemy_; // валюта
         
-        // Drop item chance: 10%
-        if (item_manager_) {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            static std::uniform_real_distribution<float> drop_chance(0.0f, 1.0f);
-            
-            if (drop_chance(gen) < 0.05f) { // 5% chance (было 10%)
-                // Поднять предмет немного вверх чтобы было видно
-                glm::vec3 drop_pos = enemy_position + glm::vec3(0.0f, 2.0f, 0.0f);
-                item_manager_->DropItem(drop_pos);
-            }
+        // Drop item chance
+        if (item_manager_ && drop_chance(gen) < 0.05f) { // 5% chance (было 10%)
+            // Поднять предмет немного вверх чтобы было видно
+            drop_positions_.push_back(death.position + glm::vec3(0.0f, 2.0f, 0.0f));
         }
+    }
+    
+    if (item_manager_ && !drop_positions_.empty()) {
+        item_manager_->DropItems(drop_positions_);
+    }
+    
+    std::cout << "Enemies destroyed: " << deaths.size() << " | Remaining: " << enemies_remaining_ << " | Score: " << total_score_ << std::endl;
+    
+    // Проверяем, завершена ли волна
+    if (enemies_remaining_ == 0 && enemies_spawned_this_wave_ >= enemies_to_spawn_this_wave_) {
+        wave_active_ = false;
+        ScheduleNextWave(wave_delay_duration_);
         
-        std::cout << "Enemy destroyed! Remaining: " << enemies_remaining_ << " | Score: " << total_score_ << std::endl;
-        
-        // Проверяем, завершена ли волна
-        if (enemies_remaining_ == 0 && enemies_spawned_this_wave_ >= enemies_to_spawn_this_wave_) {
-            wave_active_ = false;
-            wave_delay_timer_ = wave_delay_duration_;
-            
-            std::cout << "\n=== WAVE " << current_wave_ << " COMPLETED ===" << std::endl;
-            std::cout << "Score: " << total_score_ << std::endl;
-            std::cout << "Next wave in " << wave_delay_duration_ << " seconds..." << std::endl;
-        }
+        std::cout << "\n=== WAVE " << current_wave_ << " COMPLETED ===" << std::endl;
+        std::cout << "Score: " << total_score_ << std::endl;
+        std::cout << "Next wave in " << wave_delay_duration_ << " seconds..." << std::endl;
     }
 }
 
@@ -154,7 +168,7 @@ void WaveManager::OnEnemyReachedCore() {
         std::cout << "Waves Survived: " << current_wave_ << std::endl;
     } else if (enemies_remaining_ == 0 && enemies_spawned_this_wave_ >= enemies_to_spawn_this_wave_) {
         wave_active_ = false;
-        wave_delay_timer_ = wave_delay_duration_;
+        ScheduleNextWave(wave_delay_duration_);
         
         std::cout << "\n=== WAVE " << current_wave_ << " COMPLETED ===" << std::endl;
         std::cout << "Score: " << total_score_ << std::endl;
@@ -163,26 +177,37 @@ void WaveManager::OnEnemyReachedCore() {
     }
 }
 
-void WaveManager::Update(float delta_time) {
-    if (game_over_) return;
+void WaveManager::Update() {
+    if (game_over_ || !sim_clock_) return;
     
-    // Если волна не активна, отсчитываем время до следующей
-    if (!wave_active_) {
-        if (wave_delay_timer_ > 0.0f) {
-            wave_delay_timer_ -= delta_time;
-            
-            if (wave_delay_timer_ <= 0.0f) {
-                StartNextWave();
-            }
+    // Подготовка закончилась - стартуем следующую волну
+    for (void* owner : sim_clock_->GetDue(SimTimer::NextWave)) {
+        if (owner == this && !wave_active_) {
+            wave_timer_ = SimClock::TimerHandle();
+            StartNextWave();
         }
-    } else {
-        // Во время активной волны спавним врагов по таймеру
-        spawn_timer_ += delta_time;
+    }
+    
+    // Во время активной волны спавним врагов по таймеру
+    for (void* owner : sim_clock_->GetDue(SimTimer::NextSpawn)) {
+        if (owner != this) continue;
+        spawn_timer_ = SimClock::TimerHandle();
         
-        if (spawn_timer_ >= spawn_interval_ && enemies_spawned_this_wave_ < enemies_to_spawn_this_wave_) {
+        if (wave_active_ && enemies_spawned_this_wave_ < enemies_to_spawn_this_wave_) {
             SpawnEnemy();
-            spawn_timer_ = 0.0f;
+            if (enemies_spawned_this_wave_ < enemies_to_spawn_this_wave_) {
+                spawn_timer_ = sim_clock_->Schedule(SimTimer::NextSpawn, spawn_interval_, this);
+            }
         }
     }
 }
 
+float WaveManager::GetTimeTillNextWave() const {
+    return sim_clock_ ? sim_clock_->GetRemaining(wave_timer_) : 0.0f;
+}
+
+void WaveManager::ScheduleNextWave(float delay) {
+    if (!sim_clock_) return;
+    sim_clock_->Cancel(wave_timer_);
+    wave_timer_ = sim_clock_->Schedule(SimTimer::NextWave, delay, this);
+}
@@ -1,25 +1,29 @@
 // Manages enemy waves with increasing difficulty
 #pragma once
 
+#include "sim_clock.h"
 #include <vector>
 #include <glm/glm.hpp>
 
 class EnemySpawner;
 class ItemManager;
+struct EnemyDeath;
 
 class WaveManager {
 public:
     WaveManager();
-    ~WaveManager() = default;
+    ~WaveManager();
 
-    void Update(float delta_time);
+    // Handle wave/spawn timers that fired on the sim clock this tick
+    void Update();
     void SetEnemySpawner(EnemySpawner* spawner);
     void SetItemManager(ItemManager* item_manager);
+    void SetSimClock(SimClock* sim_clock) { sim_clock_ = sim_clock; }
     
     // Геттеры для UI
     int GetCurrentWave() const { return current_wave_; }
     int GetEnemiesRemaining() const { return enemies_remaining_; }
-    float GetTimeTillNextWave() const { return wave_delay_timer_; }
+    float GetTimeTillNextWave() const;
     bool IsWaveActive() const { return wave_active_; }
     bool IsGameOver() const { return game_over_; }
     int GetTotalScore() const { return total_score_; }
@@ -30,10 +34,10 @@ public:
     // Управление игрой
     void StartGame();
     void StartNextWave();
-    void OnEnemyDestroyed(const glm::vec3& enemy_position);
+    void OnEnemiesDestroyed(const std::vector<EnemyDeath>& deaths); // All kills of one tick
     void OnEnemyReachedCore();
     void SetPreparationDuration(float seconds) { wave_delay_duration_ = seconds; }
-    void SetInitialPreparation(float seconds) { wave_delay_timer_ = seconds; }
+    void SetInitialPreparation(float seconds) { ScheduleNextWave(seconds); }
     
     // Обновление только экономики (для паузы)
     void UpdateEconomy();
@@ -45,6 +49,7 @@ public:
 private:
     EnemySpawner* enemy_spawner_;
     ItemManager* item_manager_;
+    SimClock* sim_clock_;
     
     // Состояние волны
     int current_wave_;
@@ -56,9 +61,9 @@ private:
     int enemies_spawned_this_wave_;
     int enemies_to_spawn_this_wave_;
     
-    // Таймеры
-    float wave_delay_timer_;
-    float spawn_timer_;
+    // Таймеры (на часах симуляции)
+    SimClock::TimerHandle wave_timer_;
+    SimClock::TimerHandle spawn_timer_;
     
     // Конфигурация
     float wave_delay_duration_;      // Задержка между волнами
@@ -75,8 +80,10 @@ private:
     int currency_;
     int reward_per_enemy_;
     int starting_currency_;
+    std::vector<glm::vec3> drop_positions_; // Scratch for batched item drops
     
     void CalculateWaveParameters();
     void SpawnEnemy();
+    void ScheduleNextWave(float delay);
 };
 
@@ -0,0 +1,50 @@
+// Implementation of the dynamic resolution controller
+#include "dynamic_resolution.h"
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution()
+    : scale_(1.0f), smoothed_ms_(0.0), cooldown_(0), fixed_(false) {
+}
+
+void DynamicResolution::SetSettings(const Settings& settings) {
+    settings_ = settings;
+    if (!fixed_) {
+        scale_ = std::clamp(scale_, settings_.min_scale, settings_.max_scale);
+    }
+}
+
+void DynamicResolution::Update(double frame_ms) {
+    if (frame_ms <= 0.0) return;
+    smoothed_ms_ = smoothed_ms_ <= 0.0 ? frame_ms : smoothed_ms_ + (frame_ms - smoothed_ms_) * settings_.smoothing;
+
+    if (fixed_) return;
+    if (cooldown_ > 0) {
+        cooldown_--;
+        return;
+    }
+
+    double target = settings_.target_ms;
+    if (smoothed_ms_ <= target && smoothed_ms_ >= target * settings_.headroom) return;
+
+    // Aim for the middle of the band; cost is roughly proportional to scale squared
+    double aim = target * (1.0 + settings_.headroom) * 0.5;
+    float desired = scale_ * static_cast<float>(std::sqrt(aim / smoothed_ms_));
+    desired = std::clamp(desired, scale_ - settings_.max_step, scale_ + settings_.max_step);
+    desired = std::clamp(desired, settings_.min_scale, settings_.max_scale);
+    if (std::fabs(desired - scale_) < 0.01f) return;
+
+    scale_ = desired;
+    cooldown_ = settings_.cooldown_frames;
+}
+
+void DynamicResolution::SetFixedScale(float scale) {
+    scale_ = std::clamp(scale, 0.1f, 1.0f);
+    fixed_ = true;
+}
+
+void DynamicResolution::ClearFixedScale() {
+    fixed_ = false;
+    scale_ = std::clamp(scale_, settings_.min_scale, settings_.max_scale);
+    cooldown_ = settings_.cooldown_frames;
+}
@@ -0,0 +1,43 @@
+// Render scale controller that holds the 3D scene to a frame-time budget
+#pragma once
+
+// Fed the measured GPU frame time once per frame. The time is smoothed, and when it
+// leaves the band [headroom * target, target] the scale moves toward the value
+// that would hit the target, assuming cost grows with pixel count (scale squared).
+// Each change is followed by a cooldown so the new resolution is measured before
+// the next decision. A fixed scale overrides the controller, for benchmarking.
+class DynamicResolution {
+public:
+    struct Settings {
+        float target_ms = 15.0f;        // GPU budget per frame (60 Hz with some slack)
+        float headroom = 0.8f;          // Scale up only below this fraction of the target
+        float min_scale = 0.5f;
+        float max_scale = 1.0f;
+        float max_step = 0.1f;          // Largest scale change per decision
+        float smoothing = 0.1f;         // Weight of the newest sample
+        int cooldown_frames = 15;
+    };
+
+    DynamicResolution();
+
+    void SetSettings(const Settings& settings);
+    const Settings& GetSettings() const { return settings_; }
+
+    // Call once per frame; ignored while no time has been measured yet
+    void Update(double frame_ms);
+
+    // Scales outside (0, 1] are clamped; ClearFixedScale returns to automatic
+    void SetFixedScale(float scale);
+    void ClearFixedScale();
+    bool IsFixed() const { return fixed_; }
+
+    float GetScale() const { return scale_; }
+    double GetSmoothedFrameMs() const { return smoothed_ms_; }
+
+private:
+    Settings settings_;
+    float scale_;
+    double smoothed_ms_;
+    int cooldown_;
+    bool fixed_;
+};
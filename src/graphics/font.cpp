@@ -1,11 +1,11 @@
 // Implementation of font rendering system
 #include "font.h"
+#include "render_queue.h"
 #include <iostream>
 #include <glad/glad.h>
+#include "utils/gl_trace.h"
 
 Font::Font() : initialized_(false), font_size_(48) {
-    VAO_ = 0;
-    VBO_ = 0;
 }
 
 Font::~Font() {
@@ -79,42 +79,19 @@ bool Font::LoadFont(const std::string& font_path, unsigned int font_size) {
     FT_Done_Face(face_);
     FT_Done_FreeType(ft_);
 
-    // Настройка данных для рендеринга
-    SetupRenderData();
-
     initialized_ = true;
     std::cout << "Font loaded successfully: " << font_path << std::endl;
     return true;
 }
 
-void Font::SetupRenderData() {
-    // Настройка VAO/VBO для рендеринга текста
-    glGenVertexArrays(1, &VAO_);
-    glGenBuffers(1, &VBO_);
-    glBindVertexArray(VAO_);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-}
-
-void Font::RenderText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
+void Font::QueueText(RenderQueue& queue, const std::string& text, float x, float y, float scale, const glm::vec3& color) {
     if (!initialized_) return;
 
-    // Включение смешивания для прозрачности
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // Активация соответствующих состояний
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO_);
-
     // Итерация по всем символам
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        Character ch = characters_[*c];
+    for (char c : text) {
+        auto it = characters_.find(c);
+        if (it == characters_.end()) continue;
+        const Character& ch = it->second;
 
         float xpos = x + ch.bearing.x * scale;
         float ypos = y - (ch.size.y - ch.bearing.y) * scale;
@@ -122,37 +99,24 @@ void Font::RenderText(const std::string& text, float x, float y, float scale, co
         float w = ch.size.x * scale;
         float h = ch.size.y * scale;
 
-        // Обновление VBO для текущего символа
-        // Flip V texcoord to account for FreeType's top-left origin
-        float vertices[6][4] = {
-            { xpos,     ypos + h,   0.0f, 1.0f },
-            { xpos,     ypos,       0.0f, 0.0f },
-            { xpos + w, ypos,       1.0f, 0.0f },
-
-            { xpos,     ypos + h,   0.0f, 1.0f },
-            { xpos + w, ypos,       1.0f, 0.0f },
-            { xpos + w, ypos + h,   1.0f, 1.0f }
-        };
+        // Пробелы только сдвигают курсор
+        if (w > 0.0f && h > 0.0f) {
+            // Flip V texcoord to account for FreeType's top-left origin
+            TextVertex vertices[6] = {
+                { glm::vec4(xpos,     ypos + h,   0.0f, 1.0f), color },
+                { glm::vec4(xpos,     ypos,       0.0f, 0.0f), color },
+                { glm::vec4(xpos + w, ypos,       1.0f, 0.0f), color },
+
+                { glm::vec4(xpos,     ypos + h,   0.0f, 1.0f), color },
+                { glm::vec4(xpos + w, ypos,       1.0f, 0.0f), color },
+                { glm::vec4(xpos + w, ypos + h,   1.0f, 1.0f), color }
+            };
+            queue.SubmitGlyph(ch.texture_id, vertices);
+        }
 
-        // Рендеринг глифа текстуры на квадрате
-        glBindTexture(GL_TEXTURE_2D, ch.texture_id);
-        
-        // Обновление содержимого VBO памяти
-        glBindBuffer(GL_ARRAY_BUFFER, VBO_);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        
-        // Рендеринг квадрата
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        
         // Теперь продвигаем курсоры для следующего глифа (обратите внимание, что advance - это число 1/64 пикселя)
         x += (ch.advance >> 6) * scale; // биты сдвига на 6, чтобы получить значение в пикселях (2^6 = 64)
     }
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    // Отключение смешивания
-    glDisable(GL_BLEND);
 }
 
 float Font::GetTextWidth(const std::string& text, float scale) const {
@@ -177,13 +141,6 @@ void Font::Shutdown() {
             glDeleteTextures(1, &pair.second.texture_id);
         }
         
-        if (VAO_) {
-            glDeleteVertexArrays(1, &VAO_);
-        }
-        if (VBO_) {
-            glDeleteBuffers(1, &VBO_);
-        }
-        
         initialized_ = false;
     }
 }
@@ -7,6 +7,8 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
+class RenderQueue;
+
 struct Character {
     unsigned int texture_id;  // ID текстуры глифа
     glm::ivec2   size;        // Размер глифа
@@ -20,7 +22,8 @@ public:
     ~Font();
 
     bool LoadFont(const std::string& font_path, unsigned int font_size = 48);
-    void RenderText(const std::string& text, float x, float y, float scale, const glm::vec3& color);
+    // Queue one glyph command per visible character (the text pass batches by glyph)
+    void QueueText(RenderQueue& queue, const std::string& text, float x, float y, float scale, const glm::vec3& color);
     void Shutdown();
 
     float GetTextWidth(const std::string& text, float scale = 1.0f) const;
@@ -30,9 +33,6 @@ private:
     FT_Library ft_;
     FT_Face face_;
     std::map<char, Character> characters_;
-    unsigned int VAO_, VBO_;
     unsigned int font_size_;
     bool initialized_;
-
-    void SetupRenderData();
 };
@@ -0,0 +1,71 @@
+// Implementation of frustum plane extraction and sphere culling
+#include "frustum.h"
+
+Frustum::Frustum() {
+    // Everything visible until the first Extract
+    for (int i = 0; i < kPlaneCount; ++i) {
+        normal_x_[i] = 0.0f;
+        normal_y_[i] = 0.0f;
+        normal_z_[i] = 0.0f;
+        distance_[i] = 1.0f;
+    }
+}
+
+void Frustum::Extract(const glm::mat4& view_projection) {
+    // Gribb-Hartmann: each clip plane is the last matrix row plus or minus another row.
+    // glm is column-major, so row r is (m[0][r], m[1][r], m[2][r], m[3][r]).
+    const glm::mat4& m = view_projection;
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    const glm::vec4 planes[kPlaneCount] = {
+        row3 + row0,    // Left
+        row3 - row0,    // Right
+        row3 + row1,    // Bottom
+        row3 - row1,    // Top
+        row3 + row2,    // Near
+        row3 - row2     // Far
+    };
+
+    for (int i = 0; i < kPlaneCount; ++i) {
+        float length = glm::length(glm::vec3(planes[i]));
+        float scale = length > 0.0f ? 1.0f / length : 0.0f;
+        normal_x_[i] = planes[i].x * scale;
+        normal_y_[i] = planes[i].y * scale;
+        normal_z_[i] = planes[i].z * scale;
+        distance_[i] = planes[i].w * scale;
+    }
+}
+
+bool Frustum::IsSphereVisible(const glm::vec3& center, float radius) const {
+    for (int i = 0; i < kPlaneCount; ++i) {
+        float distance = normal_x_[i] * center.x + normal_y_[i] * center.y + normal_z_[i] * center.z + distance_[i];
+        if (distance < -radius) return false;
+    }
+    return true;
+}
+
+size_t Frustum::CullSpheres(const glm::vec3* centers, size_t count, float radius, uint8_t* visible) const {
+    for (size_t i = 0; i < count; ++i) {
+        visible[i] = 1;
+    }
+
+    for (int plane = 0; plane < kPlaneCount; ++plane) {
+        const float nx = normal_x_[plane];
+        const float ny = normal_y_[plane];
+        const float nz = normal_z_[plane];
+        const float d = distance_[plane] + radius;
+        for (size_t i = 0; i < count; ++i) {
+            float distance = nx * centers[i].x + ny * centers[i].y + nz * centers[i].z + d;
+            visible[i] &= static_cast<uint8_t>(distance >= 0.0f);
+        }
+    }
+
+    size_t visible_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        visible_count += visible[i];
+    }
+    return visible_count;
+}
@@ -0,0 +1,30 @@
+// View frustum planes with batched bounding-sphere culling
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+class Frustum {
+public:
+    static constexpr int kPlaneCount = 6;
+
+    Frustum();
+
+    // Planes of `view_projection` (projection * view), normalized, normals pointing inward
+    void Extract(const glm::mat4& view_projection);
+
+    bool IsSphereVisible(const glm::vec3& center, float radius) const;
+
+    // visible[i] = whether the sphere at centers[i] touches the frustum; returns how many
+    // do. One pass per plane over the contiguous centers, without branches, so the
+    // inner loop vectorizes.
+    size_t CullSpheres(const glm::vec3* centers, size_t count, float radius, uint8_t* visible) const;
+
+private:
+    // Plane i: normal_x_[i] * x + normal_y_[i] * y + normal_z_[i] * z + distance_[i] >= 0 inside
+    float normal_x_[kPlaneCount];
+    float normal_y_[kPlaneCount];
+    float normal_z_[kPlaneCount];
+    float distance_[kPlaneCount];
+};
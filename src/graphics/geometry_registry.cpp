@@ -0,0 +1,246 @@
+// Implementation of the shared geometry registry
+#include "geometry_registry.h"
+#include "mesh.h"
+#include "gl_state_cache.h"
+#include "utils/metrics.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include "utils/gl_trace.h"
+
+namespace {
+    // FNV-1a over the raw bytes of a mesh
+    uint64_t HashMesh(const MeshData& data) {
+        uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* bytes, size_t size) {
+            const unsigned char* p = static_cast<const unsigned char*>(bytes);
+            for (size_t i = 0; i < size; ++i) {
+                hash = (hash ^ p[i]) * 1099511628211ull;
+            }
+        };
+        mix(data.vertices.data(), data.vertices.size() * sizeof(float));
+        mix(data.indices.data(), data.indices.size() * sizeof(unsigned int));
+        mix(&data.primitive, sizeof(data.primitive));
+        return hash;
+    }
+}
+
+GeometryRegistry::GeometryRegistry()
+    : vao_(0), vbo_(0), ebo_(0), instance_vbo_(0), indirect_buffer_(0),
+      instance_capacity_(0), uploaded_(false), use_indirect_(false), instances_streamed_(false) {
+}
+
+GeometryRegistry::~GeometryRegistry() {
+    Destroy();
+}
+
+GeometryRegistry::MeshId GeometryRegistry::Register(const MeshData& data) {
+    if (uploaded_) {
+        std::cerr << "GeometryRegistry: cannot register meshes after upload" << std::endl;
+        return kInvalidMesh;
+    }
+    if (data.vertices.empty() || data.indices.empty() || data.vertices.size() % 3 != 0) {
+        std::cerr << "GeometryRegistry: invalid mesh data" << std::endl;
+        return kInvalidMesh;
+    }
+
+    uint64_t hash = HashMesh(data);
+    auto candidates = by_hash_.equal_range(hash);
+    for (auto it = candidates.first; it != candidates.second; ++it) {
+        if (Matches(ranges_[it->second], data)) {
+            return it->second;
+        }
+    }
+
+    MeshRange range;
+    range.first_index = static_cast<GLuint>(indices_.size());
+    range.index_count = static_cast<GLsizei>(data.indices.size());
+    range.base_vertex = static_cast<GLint>(vertices_.size() / 3);
+    range.vertex_count = static_cast<GLsizei>(data.vertices.size() / 3);
+    range.primitive = data.primitive;
+    vertices_.insert(vertices_.end(), data.vertices.begin(), data.vertices.end());
+    indices_.insert(indices_.end(), data.indices.begin(), data.indices.end());
+
+    MeshId id = static_cast<MeshId>(ranges_.size());
+    ranges_.push_back(range);
+    instances_.emplace_back();
+    by_hash_.emplace(hash, id);
+    return id;
+}
+
+bool GeometryRegistry::Matches(const MeshRange& range, const MeshData& data) const {
+    if (range.primitive != data.primitive ||
+        static_cast<size_t>(range.index_count) != data.indices.size() ||
+        static_cast<size_t>(range.vertex_count) * 3 != data.vertices.size()) {
+        return false;
+    }
+    return std::memcmp(&vertices_[range.base_vertex * 3], data.vertices.data(), data.vertices.size() * sizeof(float)) == 0 &&
+           std::memcmp(&indices_[range.first_index], data.indices.data(), data.indices.size() * sizeof(unsigned int)) == 0;
+}
+
+bool GeometryRegistry::Upload() {
+    if (uploaded_) return true;
+    if (ranges_.empty()) {
+        std::cerr << "GeometryRegistry: nothing to upload" << std::endl;
+        return false;
+    }
+
+    glGenVertexArrays(1, &vao_);
+    glGenBuffers(1, &vbo_);
+    glGenBuffers(1, &ebo_);
+    glGenBuffers(1, &instance_vbo_);
+
+    glBindVertexArray(vao_);
+
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    glBufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(float), vertices_.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(unsigned int), indices_.data(), GL_STATIC_DRAW);
+
+    // Instance attributes advance once per instance
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo_);
+    for (GLuint location = 1; location <= 6; ++location) {
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    SetInstanceAttributes(0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Indirect multi-draw (with base instance) is core in GL 4.3
+    use_indirect_ = GLAD_GL_VERSION_4_3 != 0;
+    if (use_indirect_) {
+        glGenBuffers(1, &indirect_buffer_);
+    }
+
+    uploaded_ = true;
+    std::cout << "Geometry registry: " << GetMeshCount() << " meshes, " << GetVertexCount() << " vertices, "
+              << GetIndexCount() << " indices (" << (use_indirect_ ? "indirect multi-draw" : "instanced draw per mesh")
+              << ")" << std::endl;
+    return true;
+}
+
+void GeometryRegistry::Destroy() {
+    if (!uploaded_) return;
+    glDeleteVertexArrays(1, &vao_);
+    glDeleteBuffers(1, &vbo_);
+    glDeleteBuffers(1, &ebo_);
+    glDeleteBuffers(1, &instance_vbo_);
+    if (indirect_buffer_) glDeleteBuffers(1, &indirect_buffer_);
+    vao_ = vbo_ = ebo_ = instance_vbo_ = indirect_buffer_ = 0;
+    instance_capacity_ = 0;
+    uploaded_ = false;
+}
+
+void GeometryRegistry::BeginFrame() {
+    for (auto& list : instances_) {
+        list.clear();
+    }
+}
+
+void GeometryRegistry::TakeInstances(InstanceLists& lists) {
+    instances_.swap(lists);
+    instances_.resize(ranges_.size());
+    BeginFrame();
+}
+
+void GeometryRegistry::SetInstanceAttributes(size_t first_instance) {
+    const size_t stride = sizeof(MeshInstance);
+    const size_t base = first_instance * stride;
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(1 + column, 4, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(MeshInstance, model) + column * sizeof(glm::vec4)));
+    }
+    glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(MeshInstance, color)));
+    glVertexAttribPointer(6, 1, GL_FLOAT, GL_FALSE, stride, (void*)(base + offsetof(MeshInstance, value)));
+}
+
+bool GeometryRegistry::StreamInstances(GLStateCache& state, const InstanceLists& instances) {
+    state.BindVertexArray(vao_);
+    state.BindArrayBuffer(instance_vbo_);
+    if (instances_streamed_) return !instance_data_.empty();
+
+    // Pack the instance lists back to back, in mesh order
+    instance_data_.clear();
+    instance_offsets_.assign(ranges_.size(), 0);
+    for (size_t mesh = 0; mesh < ranges_.size() && mesh < instances.size(); ++mesh) {
+        instance_offsets_[mesh] = instance_data_.size();
+        instance_data_.insert(instance_data_.end(), instances[mesh].begin(), instances[mesh].end());
+    }
+    instances_streamed_ = true;
+    if (instance_data_.empty()) return false;
+
+    // Orphan and refill the instance buffer; grow it geometrically
+    if (instance_data_.size() > instance_capacity_) {
+        instance_capacity_ = std::max(instance_data_.size(), instance_capacity_ * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, instance_capacity_ * sizeof(MeshInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instance_data_.size() * sizeof(MeshInstance), instance_data_.data());
+    Metrics::Add("render.instances", static_cast<double>(instance_data_.size()));
+    return true;
+}
+
+void GeometryRegistry::Draw(GLStateCache& state, const InstanceLists& instances) {
+    if (!uploaded_) return;
+    if (!StreamInstances(state, instances)) return;
+
+    // One draw command per non-empty line mesh
+    commands_.clear();
+    for (size_t mesh = 0; mesh < ranges_.size(); ++mesh) {
+        const MeshRange& range = ranges_[mesh];
+        size_t count = mesh < instances.size() ? instances[mesh].size() : 0;
+        if (count == 0 || range.primitive != GL_LINES) continue;
+        commands_.push_back({static_cast<GLuint>(range.index_count), static_cast<GLuint>(count),
+                             range.first_index, range.base_vertex, static_cast<GLuint>(instance_offsets_[mesh])});
+    }
+    if (commands_.empty()) return;
+
+    size_t draw_calls = 0;
+    if (use_indirect_) {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_buffer_);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, commands_.size() * sizeof(DrawElementsIndirectCommand),
+                     commands_.data(), GL_STREAM_DRAW);
+        GL_TRACE_MULTI_DRAW_ELEMENTS_INDIRECT(commands_.data(), GL_LINES, GL_UNSIGNED_INT, nullptr,
+                                              static_cast<GLsizei>(commands_.size()), 0);
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+        draw_calls = 1;
+    } else {
+        // No base instance before 4.2: re-point the instance attributes per mesh instead
+        for (const DrawElementsIndirectCommand& command : commands_) {
+            SetInstanceAttributes(command.base_instance);
+            glDrawElementsInstancedBaseVertex(GL_LINES, command.count, GL_UNSIGNED_INT,
+                                              (void*)(command.first_index * sizeof(unsigned int)),
+                                              command.instance_count, command.base_vertex);
+        }
+        SetInstanceAttributes(0);
+        draw_calls = commands_.size();
+    }
+
+    Metrics::Add("render.draw_calls", static_cast<double>(draw_calls));
+}
+
+void GeometryRegistry::DrawMesh(GLStateCache& state, const InstanceLists& instances, MeshId mesh) {
+    if (!uploaded_ || mesh >= ranges_.size() || mesh >= instances.size()) return;
+    if (!StreamInstances(state, instances)) return;
+    const MeshRange& range = ranges_[mesh];
+    GLsizei count = static_cast<GLsizei>(instances[mesh].size());
+    if (count == 0) return;
+
+    const void* first_index = (void*)(range.first_index * sizeof(unsigned int));
+    if (use_indirect_) {
+        glDrawElementsInstancedBaseVertexBaseInstance(range.primitive, range.index_count, GL_UNSIGNED_INT, first_index,
+                                                      count, range.base_vertex,
+                                                      static_cast<GLuint>(instance_offsets_[mesh]));
+    } else {
+        SetInstanceAttributes(instance_offsets_[mesh]);
+        glDrawElementsInstancedBaseVertex(range.primitive, range.index_count, GL_UNSIGNED_INT, first_index,
+                                          count, range.base_vertex);
+        SetInstanceAttributes(0);
+    }
+    Metrics::Add("render.draw_calls", 1.0);
+}
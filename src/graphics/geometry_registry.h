@@ -0,0 +1,111 @@
+// Shared static geometry: all world meshes in one vertex/index buffer behind one VAO
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct MeshData;
+class GLStateCache;
+
+// Per-instance attributes, streamed once per frame
+struct MeshInstance {
+    glm::mat4 model;
+    glm::vec3 color;
+    float value;        // Per-mesh meaning (health ratio for bars); unused by the line shader
+};
+
+// Meshes are registered up front and packed into one static VBO/EBO; each keeps its
+// range as (first index, index count, base vertex), so indices stay mesh-local.
+// Identical geometry registered twice shares one range. Every frame the game queues
+// instances per mesh, and the render queue takes the lists with its frame snapshot
+// (TakeInstances), so recording the next frame never touches the lists being drawn.
+// The first draw of a frame streams all of them into one instance buffer. Draw
+// submits every line mesh with a single glMultiDrawElementsIndirect when GL 4.3 is
+// available, or one
+// glDrawElementsInstancedBaseVertex per mesh on a 3.3 context. Meshes with another
+// primitive (billboards) need their own shader and are drawn one at a time with
+// DrawMesh, reading the same instance buffer.
+//
+// Vertex layout: position at location 0, instance model matrix at 1-4, color at 5
+// and the instance value at 6.
+class GeometryRegistry {
+public:
+    using MeshId = uint32_t;
+    using InstanceLists = std::vector<std::vector<MeshInstance>>;  // One list per mesh
+    static constexpr MeshId kInvalidMesh = ~0u;
+
+    GeometryRegistry();
+    ~GeometryRegistry();
+
+    // Add a line-list mesh; returns the existing id for geometry already registered.
+    // Meshes cannot be added after Upload.
+    MeshId Register(const MeshData& data);
+
+    // Create the shared buffers and VAO
+    bool Upload();
+    void Destroy();
+
+    // Recording side: queue this frame's instances, then hand them over. `lists`
+    // receives them and its old contents are recycled as the new (empty) lists.
+    void BeginFrame();
+    void AddInstance(MeshId mesh, const glm::mat4& model, const glm::vec3& color, float value = 0.0f) {
+        instances_[mesh].push_back({model, color, value});
+    }
+    void TakeInstances(InstanceLists& lists);
+
+    // GL side: draw a taken frame (shader already bound; the render queue calls these
+    // from its world pass). BeginSubmit marks the instance buffer stale.
+    void BeginSubmit() { instances_streamed_ = false; }
+    void Draw(GLStateCache& state, const InstanceLists& instances);
+    void DrawMesh(GLStateCache& state, const InstanceLists& instances, MeshId mesh);
+
+    size_t GetMeshCount() const { return ranges_.size(); }
+    size_t GetVertexCount() const { return vertices_.size() / 3; }
+    size_t GetIndexCount() const { return indices_.size(); }
+    bool UsesIndirectDraw() const { return use_indirect_; }
+    GLuint GetVertexArray() const { return vao_; }
+
+private:
+    struct MeshRange {
+        GLuint first_index;
+        GLsizei index_count;
+        GLint base_vertex;
+        GLsizei vertex_count;
+        GLenum primitive;
+    };
+
+    // Matches the GL layout of an indirect indexed draw
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    // Static geometry (kept on the CPU for deduplication)
+    std::vector<float> vertices_;
+    std::vector<unsigned int> indices_;
+    std::vector<MeshRange> ranges_;
+    std::unordered_multimap<uint64_t, MeshId> by_hash_;
+
+    // Instances being recorded, one list per mesh, and the packed upload
+    InstanceLists instances_;
+    std::vector<MeshInstance> instance_data_;
+    std::vector<size_t> instance_offsets_;     // First packed instance of each mesh
+    std::vector<DrawElementsIndirectCommand> commands_;
+
+    GLuint vao_, vbo_, ebo_, instance_vbo_, indirect_buffer_;
+    size_t instance_capacity_;   // Instances the instance buffer holds
+    bool uploaded_;
+    bool use_indirect_;
+    bool instances_streamed_;   // This frame's instances are in the instance buffer
+
+    bool Matches(const MeshRange& range, const MeshData& data) const;
+    void SetInstanceAttributes(size_t first_instance); // Point locations 1-6 at an instance
+    bool StreamInstances(GLStateCache& state, const InstanceLists& instances); // Pack and upload; false if none
+};
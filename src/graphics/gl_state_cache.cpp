@@ -0,0 +1,79 @@
+// Implementation of the GL state cache
+#include "gl_state_cache.h"
+#include "utils/gl_trace.h"
+
+GLStateCache::GLStateCache()
+    : program_(0), vao_(0), array_buffer_(0), texture_(0),
+      depth_test_(Toggle::Unknown), blend_(Toggle::Unknown),
+      blend_source_(GL_ONE), blend_destination_(GL_ZERO),
+      known_program_(false), known_vao_(false), known_array_buffer_(false),
+      known_texture_(false), known_blend_func_(false), enabled_(true),
+      state_changes_(0), skipped_changes_(0) {
+}
+
+void GLStateCache::Invalidate() {
+    known_program_ = known_vao_ = known_array_buffer_ = known_texture_ = known_blend_func_ = false;
+    depth_test_ = blend_ = Toggle::Unknown;
+}
+
+bool GLStateCache::Changed(bool known, bool same) {
+    if (enabled_ && known && same) {
+        skipped_changes_++;
+        return false;
+    }
+    state_changes_++;
+    return true;
+}
+
+void GLStateCache::UseProgram(GLuint program) {
+    if (!Changed(known_program_, program_ == program)) return;
+    glUseProgram(program);
+    program_ = program;
+    known_program_ = true;
+}
+
+void GLStateCache::BindVertexArray(GLuint vao) {
+    if (!Changed(known_vao_, vao_ == vao)) return;
+    glBindVertexArray(vao);
+    vao_ = vao;
+    known_vao_ = true;
+}
+
+void GLStateCache::BindArrayBuffer(GLuint buffer) {
+    if (!Changed(known_array_buffer_, array_buffer_ == buffer)) return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    array_buffer_ = buffer;
+    known_array_buffer_ = true;
+}
+
+void GLStateCache::BindTexture2D(GLuint texture) {
+    if (!Changed(known_texture_, texture_ == texture)) return;
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    texture_ = texture;
+    known_texture_ = true;
+}
+
+void GLStateCache::SetDepthTest(bool enabled) {
+    Toggle value = enabled ? Toggle::On : Toggle::Off;
+    if (!Changed(depth_test_ != Toggle::Unknown, depth_test_ == value)) return;
+    if (enabled) glEnable(GL_DEPTH_TEST);
+    else glDisable(GL_DEPTH_TEST);
+    depth_test_ = value;
+}
+
+void GLStateCache::SetBlend(bool enabled) {
+    Toggle value = enabled ? Toggle::On : Toggle::Off;
+    if (!Changed(blend_ != Toggle::Unknown, blend_ == value)) return;
+    if (enabled) glEnable(GL_BLEND);
+    else glDisable(GL_BLEND);
+    blend_ = value;
+}
+
+void GLStateCache::SetBlendFunc(GLenum source, GLenum destination) {
+    if (!Changed(known_blend_func_, blend_source_ == source && blend_destination_ == destination)) return;
+    glBlendFunc(source, destination);
+    blend_source_ = source;
+    blend_destination_ = destination;
+    known_blend_func_ = true;
+}
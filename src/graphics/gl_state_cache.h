@@ -0,0 +1,52 @@
+// Shadow copy of the GL state the renderer changes, to skip redundant GL calls
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+
+// Every setter compares against the shadowed value and only reaches GL on a change.
+// State nobody has set through the cache yet (or after Invalidate) is unknown and
+// always applied. Disabling the cache forwards every call, for before/after timing.
+class GLStateCache {
+public:
+    GLStateCache();
+
+    // Forget the shadowed values, e.g. after code outside the cache touched GL
+    void Invalidate();
+
+    void SetEnabled(bool enabled) { enabled_ = enabled; }
+    bool IsEnabled() const { return enabled_; }
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vao);
+    void BindArrayBuffer(GLuint buffer);
+    void BindTexture2D(GLuint texture);         // Texture unit 0
+    void SetDepthTest(bool enabled);
+    void SetBlend(bool enabled);
+    void SetBlendFunc(GLenum source, GLenum destination);
+
+    // Calls that reached GL and calls skipped since the last ResetCounters
+    size_t GetStateChanges() const { return state_changes_; }
+    size_t GetSkippedChanges() const { return skipped_changes_; }
+    void ResetCounters() { state_changes_ = skipped_changes_ = 0; }
+
+private:
+    enum class Toggle { Unknown, Off, On };
+
+    GLuint program_;
+    GLuint vao_;
+    GLuint array_buffer_;
+    GLuint texture_;
+    Toggle depth_test_;
+    Toggle blend_;
+    GLenum blend_source_;
+    GLenum blend_destination_;
+    bool known_program_, known_vao_, known_array_buffer_, known_texture_, known_blend_func_;
+    bool enabled_;
+
+    size_t state_changes_;
+    size_t skipped_changes_;
+
+    // True if the call must reach GL; counts it either way
+    bool Changed(bool known, bool same);
+};
@@ -3,6 +3,7 @@
 #include <GLFW/glfw3.h>
 #include <cmath>
 #include "mesh.h"
+#include "utils/gl_trace.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -101,8 +102,16 @@ void Mesh::CreateCube() {
 }
 
 void Mesh::CreateCubeWireframe() {
+    MeshData data = BuildCubeWireframe();
+    SetVertices(data.vertices);
+    SetIndices(data.indices);
+}
+
+MeshData Mesh::BuildCubeWireframe() {
+    MeshData data;
+    
     // Cube vertices (8 vertices, 3 coordinates each)
-    std::vector<float> vertices = {
+    data.vertices = {
         // Front face
         -0.5f, -0.5f,  0.5f,  // 0
          0.5f, -0.5f,  0.5f,  // 1
@@ -117,7 +126,7 @@ void Mesh::CreateCubeWireframe() {
     };
     
     // Wireframe indices (12 edges, 24 indices)
-    std::vector<unsigned int> indices = {
+    data.indices = {
         // Front face edges
         0, 1,  1, 2,  2, 3,  3, 0,
         // Back face edges
@@ -126,8 +135,7 @@ void Mesh::CreateCubeWireframe() {
         0, 4,  1, 5,  2, 6,  3, 7
     };
     
-    SetVertices(vertices);
-    SetIndices(indices);
+    return data;
 }
 
 void Mesh::SetIndices(const std::vector<unsigned int>& indices) {
@@ -142,8 +150,16 @@ void Mesh::SetIndices(const std::vector<unsigned int>& indices) {
 }
 
 void Mesh::CreateDisc(float radius, int segments) {
-    std::vector<float> vertices;
-    std::vector<unsigned int> indices;
+    MeshData data = BuildDisc(radius, segments);
+    SetVertices(data.vertices);
+    SetIndices(data.indices);
+    Create();
+}
+
+MeshData Mesh::BuildDisc(float radius, int segments) {
+    MeshData data;
+    std::vector<float>& vertices = data.vertices;
+    std::vector<unsigned int>& indices = data.indices;
     
     float inner_radius = radius * 0.6f; // Inner radius for hollow disc
     
@@ -184,7 +200,18 @@ void Mesh::CreateDisc(float radius, int segments) {
         // No connecting lines - just thick ring outline
     }
     
-    SetVertices(vertices);
-    SetIndices(indices);
-    Create();
+    return data;
+}
+
+MeshData Mesh::BuildQuad() {
+    MeshData data;
+    data.vertices = {
+        -0.5f, -0.5f, 0.0f,
+         0.5f, -0.5f, 0.0f,
+         0.5f,  0.5f, 0.0f,
+        -0.5f,  0.5f, 0.0f
+    };
+    data.indices = {0, 1, 2, 2, 3, 0};
+    data.primitive = GL_TRIANGLES;
+    return data;
 }
@@ -5,6 +5,13 @@
 #include <glm/glm.hpp>
 #include <vector>
 
+// CPU-side geometry: xyz positions and indices
+struct MeshData {
+    std::vector<float> vertices;
+    std::vector<unsigned int> indices;
+    GLenum primitive = GL_LINES;
+};
+
 class Mesh {
 public:
     Mesh();
@@ -21,6 +28,12 @@ public:
     void CreateCubeWireframe();
     void CreateDisc(float radius = 0.2f, int segments = 16);
     
+    // Line-list geometry, also used to fill the shared GeometryRegistry buffers
+    static MeshData BuildCubeWireframe();
+    static MeshData BuildDisc(float radius = 0.2f, int segments = 16);
+    // Unit quad in the XY plane centred on the origin, as triangles (billboards)
+    static MeshData BuildQuad();
+    
 private:
     GLuint VAO_, VBO_, EBO_;
     size_t index_count_;
@@ -0,0 +1,560 @@
+// Implementation of the sorted render command queue
+#include "render_queue.h"
+#include "geometry_registry.h"
+#include "scene_framebuffer.h"
+#include "shader.h"
+#include "utils/debug_draw.h"
+#include "utils/metrics.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include "utils/gl_trace.h"
+
+namespace {
+    void AppendRect(std::vector<OverlayVertex>& vertices, float x, float y, float width, float height, const glm::vec4& color) {
+        OverlayVertex top_left = {glm::vec2(x, y), color};
+        OverlayVertex top_right = {glm::vec2(x + width, y), color};
+        OverlayVertex bottom_right = {glm::vec2(x + width, y + height), color};
+        OverlayVertex bottom_left = {glm::vec2(x, y + height), color};
+        vertices.push_back(top_left);
+        vertices.push_back(top_right);
+        vertices.push_back(bottom_right);
+        vertices.push_back(top_left);
+        vertices.push_back(bottom_right);
+        vertices.push_back(bottom_left);
+    }
+
+    // Orphan `buffer` and refill it; capacity grows geometrically
+    template<typename Vertex>
+    void StreamVertices(GLStateCache& state, GLuint buffer, const std::vector<Vertex>& vertices, size_t& capacity) {
+        if (vertices.empty()) return;
+        state.BindArrayBuffer(buffer);
+        if (vertices.size() > capacity) {
+            capacity = std::max(vertices.size(), capacity * 2);
+        }
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+    }
+}
+
+RenderQueue::RenderQueue()
+    : recording_(0), ready_(-1), submitting_(-1), stopping_(false),
+      shape_shader_(nullptr), text_shader_(nullptr),
+      overlay_vao_(0), overlay_vbo_(0), text_vao_(0), text_vbo_(0), line_vao_(0), line_vbo_(0),
+      overlay_capacity_(0), text_capacity_(0), line_capacity_(0),
+      scene_target_(nullptr), output_framebuffer_(0), gpu_queries_{}, gpu_query_pending_{}, gpu_query_index_(0), gpu_frame_ms_(0.0),
+      batching_enabled_(true), initialized_(false) {
+}
+
+void RenderQueue::RenderFrame::Clear() {
+    commands.clear();
+    overlay_vertices.clear();
+    text_vertices.clear();
+    line_vertices.clear();
+    registry = nullptr;
+    world_view = glm::mat4(1.0f);
+    world_projection = glm::mat4(1.0f);
+    captured = std::chrono::steady_clock::now();
+    layer = 0;
+    layer_text_bounds.clear();
+}
+
+RenderQueue::~RenderQueue() {
+    Shutdown();
+}
+
+bool RenderQueue::Initialize() {
+    if (initialized_) return true;
+
+    // Overlay shapes: position (location 0), RGBA color (location 1)
+    glGenVertexArrays(1, &overlay_vao_);
+    glGenBuffers(1, &overlay_vbo_);
+    glBindVertexArray(overlay_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, overlay_vbo_);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(OverlayVertex), (void*)offsetof(OverlayVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(OverlayVertex), (void*)offsetof(OverlayVertex, color));
+    glEnableVertexAttribArray(1);
+
+    // Glyphs: position and texture coordinate (location 0), RGB color (location 1)
+    glGenVertexArrays(1, &text_vao_);
+    glGenBuffers(1, &text_vbo_);
+    glBindVertexArray(text_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, text_vbo_);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, position_uv));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)offsetof(TextVertex, color));
+    glEnableVertexAttribArray(1);
+
+    // Lines: world position (location 0), RGB color (location 1)
+    glGenVertexArrays(1, &line_vao_);
+    glGenBuffers(1, &line_vbo_);
+    glBindVertexArray(line_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, line_vbo_);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(LineVertex), (void*)offsetof(LineVertex, color));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glGenQueries(static_cast<GLsizei>(kGpuQueryCount), gpu_queries_);
+
+    initialized_ = true;
+    return true;
+}
+
+void RenderQueue::Shutdown() {
+    if (!initialized_) return;
+    glDeleteVertexArrays(1, &overlay_vao_);
+    glDeleteBuffers(1, &overlay_vbo_);
+    glDeleteVertexArrays(1, &text_vao_);
+    glDeleteBuffers(1, &text_vbo_);
+    glDeleteVertexArrays(1, &line_vao_);
+    glDeleteBuffers(1, &line_vbo_);
+    overlay_vao_ = overlay_vbo_ = text_vao_ = text_vbo_ = line_vao_ = line_vbo_ = 0;
+    overlay_capacity_ = text_capacity_ = line_capacity_ = 0;
+    glDeleteQueries(static_cast<GLsizei>(kGpuQueryCount), gpu_queries_);
+    for (size_t i = 0; i < kGpuQueryCount; ++i) {
+        gpu_queries_[i] = 0;
+        gpu_query_pending_[i] = false;
+    }
+    for (RenderFrame& frame : frames_) {
+        frame.Clear();
+    }
+    recording_ = 0;
+    ready_ = submitting_ = -1;
+    initialized_ = false;
+}
+
+void RenderQueue::SetOverlayShaders(Shader* shape_shader, Shader* text_shader) {
+    shape_shader_ = shape_shader;
+    text_shader_ = text_shader;
+}
+
+void RenderQueue::SetScreenSize(int width, int height) {
+    frames_[recording_].screen_width = width;
+    frames_[recording_].screen_height = height;
+}
+
+void RenderQueue::SetSceneSize(int framebuffer_width, int framebuffer_height, float scale) {
+    RenderFrame& frame = frames_[recording_];
+    frame.framebuffer_width = framebuffer_width;
+    frame.framebuffer_height = framebuffer_height;
+    frame.scene_scale = scale;
+}
+
+void RenderQueue::SetBatchingEnabled(bool enabled) {
+    batching_enabled_ = enabled;
+}
+
+void RenderQueue::BeginFrame() {
+    frames_[recording_].captured = std::chrono::steady_clock::now();
+}
+
+void RenderQueue::EndFrame() {
+    RenderFrame& frame = frames_[recording_];
+    frame.batching = batching_enabled_;
+    if (frame.registry) {
+        frame.registry->TakeInstances(frame.instances);
+    }
+
+    // Hand the frame over; with a render thread this waits while it is still a frame behind
+    auto wait_start = std::chrono::steady_clock::now();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        frame_taken_.wait(lock, [this] { return ready_ < 0 || stopping_; });
+        if (stopping_) {
+            frame.Clear();
+            return;
+        }
+        ready_ = recording_;
+        for (int i = 0; i < kFrameCount; ++i) {
+            if (i != ready_ && i != submitting_) {
+                recording_ = i;
+                break;
+            }
+        }
+    }
+    frame_ready_.notify_one();
+    frames_[recording_].Clear();
+
+    double wait_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wait_start).count();
+    Metrics::Add("frame.publish_wait_ms", wait_ms);
+}
+
+bool RenderQueue::WaitForFrame() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        frame_ready_.wait(lock, [this] { return ready_ >= 0 || stopping_; });
+        if (ready_ < 0) return false;
+        submitting_ = ready_;
+        ready_ = -1;
+    }
+    frame_taken_.notify_one();
+    return true;
+}
+
+void RenderQueue::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    frame_ready_.notify_all();
+    frame_taken_.notify_all();
+}
+
+void RenderQueue::FramePresented() {
+    if (submitting_ < 0) return;
+    const RenderFrame& frame = frames_[submitting_];
+    double latency_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame.captured).count();
+    Metrics::Add("frame.latency_ms", latency_ms);
+}
+
+uint64_t RenderQueue::MakeKey(uint32_t layer, RenderPass pass, uint32_t program, uint32_t texture, uint32_t mesh, uint32_t depth) {
+    return (static_cast<uint64_t>(layer) & 0xFF) << 56 |
+           (static_cast<uint64_t>(pass) & 0xF) << 52 |
+           (static_cast<uint64_t>(program) & 0xFF) << 44 |
+           (static_cast<uint64_t>(texture) & 0xFFF) << 32 |
+           (static_cast<uint64_t>(mesh) & 0xFF) << 24 |
+           (static_cast<uint64_t>(depth) & 0xFFFFFF);
+}
+
+uint32_t RenderQueue::ShapeLayer(RenderFrame& frame, const glm::vec2& min_corner, const glm::vec2& max_corner) {
+    // The last layer is kept once reached, at the price of its ordering
+    if (frame.layer == 0xFF) return frame.layer;
+    for (const glm::vec4& bounds : frame.layer_text_bounds) {
+        if (min_corner.x < bounds.z && bounds.x < max_corner.x && min_corner.y < bounds.w && bounds.y < max_corner.y) {
+            frame.layer++;
+            frame.layer_text_bounds.clear();
+            break;
+        }
+    }
+    return frame.layer;
+}
+
+void RenderQueue::AddTextBounds(RenderFrame& frame, const TextVertex* vertices) {
+    glm::vec4 glyph(vertices[0].position_uv.x, vertices[0].position_uv.y, vertices[0].position_uv.x, vertices[0].position_uv.y);
+    for (int i = 1; i < 6; ++i) {
+        glyph.x = std::min(glyph.x, vertices[i].position_uv.x);
+        glyph.y = std::min(glyph.y, vertices[i].position_uv.y);
+        glyph.z = std::max(glyph.z, vertices[i].position_uv.x);
+        glyph.w = std::max(glyph.w, vertices[i].position_uv.y);
+    }
+
+    // Glyphs of one line extend its box, so the list holds about one box per string
+    if (!frame.layer_text_bounds.empty()) {
+        glm::vec4& last = frame.layer_text_bounds.back();
+        float height = glyph.w - glyph.y;
+        if (glyph.y < last.w && last.y < glyph.w && glyph.x <= last.z + height && last.x <= glyph.x) {
+            last = glm::vec4(last.x, std::min(last.y, glyph.y), std::max(last.z, glyph.z), std::max(last.w, glyph.w));
+            return;
+        }
+    }
+    frame.layer_text_bounds.push_back(glyph);
+}
+
+void RenderQueue::SubmitGeometry(GeometryRegistry* registry, Shader* shader, const glm::mat4& view, const glm::mat4& projection) {
+    SubmitMesh(registry, GeometryRegistry::kInvalidMesh, shader, view, projection);
+}
+
+void RenderQueue::SubmitMesh(GeometryRegistry* registry, uint32_t mesh, Shader* shader,
+                             const glm::mat4& view, const glm::mat4& projection) {
+    if (!registry || !shader) return;
+    RenderFrame& frame = frames_[recording_];
+    frame.world_view = view;
+    frame.world_projection = projection;
+    frame.registry = registry;
+
+    RenderCommand command;
+    command.key = MakeKey(0, RenderPass::World, shader->GetProgramId(), 0, mesh, NextDepth());
+    command.type = CommandType::Geometry;
+    command.first = 0;
+    command.count = 0;
+    command.texture = 0;
+    command.shader = shader;
+    command.registry = registry;
+    command.mesh = mesh;
+    frame.commands.push_back(command);
+}
+
+void RenderQueue::SubmitLines(const LineVertex* vertices, size_t count, Shader* shader,
+                              const glm::mat4& view, const glm::mat4& projection) {
+    if (!vertices || count < 2 || !shader) return;
+    RenderFrame& frame = frames_[recording_];
+    frame.world_view = view;
+    frame.world_projection = projection;
+
+    RenderCommand command;
+    command.key = MakeKey(0, RenderPass::Debug, shader->GetProgramId(), 0, line_vao_, NextDepth());
+    command.type = CommandType::Lines;
+    command.first = static_cast<uint32_t>(frame.line_vertices.size());
+    command.count = static_cast<uint32_t>(count - count % 2);
+    command.texture = 0;
+    command.shader = shader;
+    command.registry = nullptr;
+    command.mesh = 0;
+    frame.line_vertices.insert(frame.line_vertices.end(), vertices, vertices + command.count);
+    frame.commands.push_back(command);
+}
+
+void RenderQueue::SubmitRect(float x, float y, float width, float height, const glm::vec4& color) {
+    if (!shape_shader_) return;
+    RenderFrame& frame = frames_[recording_];
+
+    RenderCommand command;
+    uint32_t layer = ShapeLayer(frame, glm::vec2(x, y), glm::vec2(x + width, y + height));
+    command.key = MakeKey(layer, RenderPass::Overlay, shape_shader_->GetProgramId(), 0, overlay_vao_, NextDepth());
+    command.type = CommandType::Shapes;
+    command.first = static_cast<uint32_t>(frame.overlay_vertices.size());
+    command.count = 6;
+    command.texture = 0;
+    command.shader = shape_shader_;
+    command.registry = nullptr;
+    command.mesh = 0;
+    AppendRect(frame.overlay_vertices, x, y, width, height, color);
+    frame.commands.push_back(command);
+}
+
+void RenderQueue::SubmitRectOutline(float x, float y, float width, float height, const glm::vec4& color, float thickness) {
+    if (!shape_shader_) return;
+    RenderFrame& frame = frames_[recording_];
+
+    // Four thin rectangles, so outlines share the triangle batch with fills
+    RenderCommand command;
+    uint32_t layer = ShapeLayer(frame, glm::vec2(x, y), glm::vec2(x + width, y + height));
+    command.key = MakeKey(layer, RenderPass::Overlay, shape_shader_->GetProgramId(), 0, overlay_vao_, NextDepth());
+    command.type = CommandType::Shapes;
+    command.first = static_cast<uint32_t>(frame.overlay_vertices.size());
+    command.count = 24;
+    command.texture = 0;
+    command.shader = shape_shader_;
+    command.registry = nullptr;
+    command.mesh = 0;
+    float side_height = std::max(0.0f, height - 2.0f * thickness);
+    AppendRect(frame.overlay_vertices, x, y, width, thickness, color);
+    AppendRect(frame.overlay_vertices, x, y + height - thickness, width, thickness, color);
+    AppendRect(frame.overlay_vertices, x, y + thickness, thickness, side_height, color);
+    AppendRect(frame.overlay_vertices, x + width - thickness, y + thickness, thickness, side_height, color);
+    frame.commands.push_back(command);
+}
+
+void RenderQueue::SubmitGlyph(uint32_t texture, const TextVertex* vertices) {
+    if (!text_shader_) return;
+    RenderFrame& frame = frames_[recording_];
+
+    RenderCommand command;
+    command.key = MakeKey(frame.layer, RenderPass::Text, text_shader_->GetProgramId(), texture, text_vao_, NextDepth());
+    command.type = CommandType::Glyphs;
+    command.first = static_cast<uint32_t>(frame.text_vertices.size());
+    command.count = 6;
+    command.texture = texture;
+    command.shader = text_shader_;
+    command.registry = nullptr;
+    command.mesh = 0;
+    frame.text_vertices.insert(frame.text_vertices.end(), vertices, vertices + 6);
+    frame.commands.push_back(command);
+    AddTextBounds(frame, vertices);
+}
+
+void RenderQueue::BuildRuns(const RenderFrame& frame) {
+    runs_.clear();
+    overlay_upload_.clear();
+    text_upload_.clear();
+    line_upload_.clear();
+
+    for (const RenderCommand& command : frame.commands) {
+        uint32_t first = 0;
+        if (command.type == CommandType::Shapes) {
+            first = static_cast<uint32_t>(overlay_upload_.size());
+            auto begin = frame.overlay_vertices.begin() + command.first;
+            overlay_upload_.insert(overlay_upload_.end(), begin, begin + command.count);
+        } else if (command.type == CommandType::Glyphs) {
+            first = static_cast<uint32_t>(text_upload_.size());
+            auto begin = frame.text_vertices.begin() + command.first;
+            text_upload_.insert(text_upload_.end(), begin, begin + command.count);
+        } else if (command.type == CommandType::Lines) {
+            first = static_cast<uint32_t>(line_upload_.size());
+            auto begin = frame.line_vertices.begin() + command.first;
+            line_upload_.insert(line_upload_.end(), begin, begin + command.count);
+        }
+
+        // The previous run's vertices end right where these start, so a match just grows it
+        if (frame.batching && !runs_.empty() && command.type != CommandType::Geometry) {
+            DrawRun& last = runs_.back();
+            if (last.type == command.type && last.shader == command.shader && last.texture == command.texture) {
+                last.count += command.count;
+                continue;
+            }
+        }
+
+        DrawRun run;
+        run.type = command.type;
+        run.pass = static_cast<RenderPass>((command.key >> 52) & 0xF);
+        run.first = first;
+        run.count = command.count;
+        run.texture = command.texture;
+        run.shader = command.shader;
+        run.registry = command.registry;
+        run.mesh = command.mesh;
+        runs_.push_back(run);
+    }
+}
+
+void RenderQueue::CollectGpuTime() {
+    // Results complete in submission order, so stop at the first one still in flight
+    for (size_t n = 0; n < kGpuQueryCount; ++n) {
+        size_t i = (gpu_query_index_ + n) % kGpuQueryCount;
+        if (!gpu_query_pending_[i]) continue;
+        GLint available = 0;
+        glGetQueryObjectiv(gpu_queries_[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(gpu_queries_[i], GL_QUERY_RESULT, &nanoseconds);
+        gpu_frame_ms_ = static_cast<double>(nanoseconds) / 1.0e6;
+        gpu_query_pending_[i] = false;
+    }
+}
+
+void RenderQueue::ApplyPassState(RenderPass pass) {
+    state_.SetDepthTest(pass == RenderPass::World);
+    state_.SetBlend(true);
+    state_.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+void RenderQueue::PrepareShader(const RenderFrame& frame, Shader* shader, RenderPass pass) {
+    state_.UseProgram(shader->GetProgramId());
+
+    // Uniforms stay with the program, so with batching they are set once per flush
+    if (frame.batching &&
+        std::find(prepared_shaders_.begin(), prepared_shaders_.end(), shader) != prepared_shaders_.end()) {
+        return;
+    }
+    prepared_shaders_.push_back(shader);
+
+    if (pass == RenderPass::World || pass == RenderPass::Debug) {
+        shader->SetUniform("view", frame.world_view);
+        shader->SetUniform("projection", frame.world_projection);
+    } else {
+        glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(frame.screen_width), static_cast<float>(frame.screen_height), 0.0f);
+        shader->SetUniform("projection", projection);
+        if (pass == RenderPass::Text) {
+            shader->SetUniform("text", 0);
+        }
+    }
+}
+
+void RenderQueue::Flush() {
+    if (!initialized_ || submitting_ < 0) return;
+    RenderFrame& frame = frames_[submitting_];
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Reuse the oldest query once its result has been read
+    CollectGpuTime();
+    bool gpu_timed = !gpu_query_pending_[gpu_query_index_];
+    if (gpu_timed) {
+        glBeginQuery(GL_TIME_ELAPSED, gpu_queries_[gpu_query_index_]);
+    }
+
+    // Code outside the queue may have changed GL state since the last flush
+    state_.SetEnabled(frame.batching);
+    state_.Invalidate();
+    state_.ResetCounters();
+    prepared_shaders_.clear();
+    if (frame.registry) {
+        frame.registry->BeginSubmit();
+    }
+
+    if (frame.batching) {
+        std::sort(frame.commands.begin(), frame.commands.end(),
+                  [](const RenderCommand& a, const RenderCommand& b) { return a.key < b.key; });
+    }
+    BuildRuns(frame);
+
+    // GL tracing charges each pass's calls to the subsystem that recorded it
+    {
+        GL_TRACE_SCOPE("ui");
+        StreamVertices(state_, overlay_vbo_, overlay_upload_, overlay_capacity_);
+        StreamVertices(state_, text_vbo_, text_upload_, text_capacity_);
+    }
+    {
+        GL_TRACE_SCOPE("debug_draw");
+        StreamVertices(state_, line_vbo_, line_upload_, line_capacity_);
+    }
+
+    // The 3D passes sort first; the scene target is upscaled before the first 2D run.
+    // The viewport is set here every frame, so window resizes need no GL call elsewhere.
+    glBindFramebuffer(GL_FRAMEBUFFER, output_framebuffer_);
+    glViewport(0, 0, frame.framebuffer_width, frame.framebuffer_height);
+    bool scene_resolved = scene_target_ == nullptr;
+    if (scene_target_) {
+        scene_target_->SetSize(frame.framebuffer_width, frame.framebuffer_height, frame.scene_scale);
+        scene_target_->Begin();
+    }
+
+    size_t draw_calls = 0;
+    bool first_run = true;
+    RenderPass current_pass = RenderPass::World;
+    for (const DrawRun& run : runs_) {
+        GL_TRACE_SCOPE(run.pass == RenderPass::World ? "world" : run.pass == RenderPass::Debug ? "debug_draw" : "ui");
+        if (!scene_resolved && run.pass >= RenderPass::Overlay) {
+            scene_target_->Resolve(output_framebuffer_);
+            scene_resolved = true;
+        }
+        if (first_run || run.pass != current_pass || !frame.batching) {
+            ApplyPassState(run.pass);
+            current_pass = run.pass;
+            first_run = false;
+        }
+        PrepareShader(frame, run.shader, run.pass);
+
+        switch (run.type) {
+            case CommandType::Geometry:
+                // The registry publishes its own draw calls
+                if (run.mesh == GeometryRegistry::kInvalidMesh) {
+                    run.registry->Draw(state_, frame.instances);
+                } else {
+                    run.registry->DrawMesh(state_, frame.instances, run.mesh);
+                }
+                break;
+            case CommandType::Lines:
+                state_.BindVertexArray(line_vao_);
+                glDrawArrays(GL_LINES, static_cast<GLint>(run.first), static_cast<GLsizei>(run.count));
+                draw_calls++;
+                break;
+            case CommandType::Shapes:
+                state_.BindVertexArray(overlay_vao_);
+                glDrawArrays(GL_TRIANGLES, static_cast<GLint>(run.first), static_cast<GLsizei>(run.count));
+                draw_calls++;
+                break;
+            case CommandType::Glyphs:
+                state_.BindVertexArray(text_vao_);
+                state_.BindTexture2D(run.texture);
+                glDrawArrays(GL_TRIANGLES, static_cast<GLint>(run.first), static_cast<GLsizei>(run.count));
+                draw_calls++;
+                break;
+        }
+    }
+
+    if (!scene_resolved) {
+        scene_target_->Resolve(output_framebuffer_);
+    }
+
+    if (gpu_timed) {
+        glEndQuery(GL_TIME_ELAPSED);
+        gpu_query_pending_[gpu_query_index_] = true;
+        gpu_query_index_ = (gpu_query_index_ + 1) % kGpuQueryCount;
+    }
+
+    double submit_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Metrics::Add("render.commands", static_cast<double>(frame.commands.size()));
+    Metrics::Add("render.draw_calls", static_cast<double>(draw_calls));
+    Metrics::Add("render.state_changes", static_cast<double>(state_.GetStateChanges()));
+    Metrics::Add("render.state_skipped", static_cast<double>(state_.GetSkippedChanges()));
+    Metrics::Add("render.submit_ms", submit_ms);
+    Metrics::Set("render.gpu_ms", gpu_frame_ms_);
+    Metrics::Set("render.batching", frame.batching ? 1.0 : 0.0);
+}
@@ -0,0 +1,223 @@
+// Sorted render command queue: game and UI emit commands, Flush submits them in key order
+#pragma once
+
+#include "gl_state_cache.h"
+#include "geometry_registry.h"
+#include <glm/glm.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class Shader;
+class SceneFramebuffer;
+struct LineVertex;
+
+// Passes draw in this order
+enum class RenderPass : uint8_t {
+    World,      // 3D geometry, depth tested
+    Debug,      // 3D debug lines, drawn over the world
+    Overlay,    // Screen-space shapes (panels, bars, cells)
+    Text        // Screen-space glyphs, on top of the overlay
+};
+
+// Screen-space vertices, in pixels with the origin at the top left
+struct OverlayVertex {
+    glm::vec2 position;
+    glm::vec4 color;
+};
+
+struct TextVertex {
+    glm::vec4 position_uv;  // Position xy, texture coordinate zw
+    glm::vec3 color;
+};
+
+// Commands carry a 64-bit sort key, most significant field first:
+//
+//   layer (8 bits) | pass (4) | program (8) | texture (12) | mesh (8) | depth (24)
+//
+// Program, texture and mesh are truncated to their field, so a collision only costs a
+// merge. Depth is the submission order within a pass, which keeps painter's order for
+// overlapping 2D shapes. Within a layer all shapes draw before all text, which lets
+// each batch into few draws; a shape that overlaps text already in the layer opens
+// the next layer, so it still covers that text as submitted (3D commands stay in
+// layer 0). Flush sorts the commands, copies their vertices
+// into one streamed buffer per vertex type in sorted order, merges neighbours that share
+// a program and texture into one draw, and submits through a GLStateCache.
+//
+// Recording and submission work on separate frames, so they can run on different
+// threads. Submit* calls (CPU only) fill the recording frame; EndFrame publishes it
+// as an immutable snapshot, taking the registry's instance lists with it. The GL
+// side picks it up with WaitForFrame and draws it with Flush. Three frames rotate
+// (recording, ready, submitting), so the recorder runs at most one frame ahead and
+// EndFrame blocks until the previous snapshot has been taken. Run in sequence on
+// one thread, WaitForFrame returns the frame just published without waiting.
+class RenderQueue {
+public:
+    RenderQueue();
+    ~RenderQueue();
+
+    bool Initialize();
+    void Shutdown();
+
+    // Programs for the 2D passes (owned by the caller)
+    void SetOverlayShaders(Shader* shape_shader, Shader* text_shader);
+
+    // Recording side: frame parameters, UI size in window units and the scene's
+    // framebuffer size and render scale
+    void SetScreenSize(int width, int height);
+    void SetSceneSize(int framebuffer_width, int framebuffer_height, float scale);
+
+    // World and debug passes render into `target` (if set), which is upscaled to the
+    // window before the 2D passes, so UI and text stay at native resolution
+    void SetSceneTarget(SceneFramebuffer* target) { scene_target_ = target; }
+
+    // Where finished frames go: the window (0) or an offscreen framebuffer of the
+    // window's size (headless benchmark)
+    void SetOutputFramebuffer(GLuint framebuffer) { output_framebuffer_ = framebuffer; }
+
+    static uint64_t MakeKey(uint32_t layer, RenderPass pass, uint32_t program, uint32_t texture, uint32_t mesh, uint32_t depth);
+
+    // World geometry queued in `registry`, drawn with `shader` from this camera: every
+    // line mesh in one submission, or a single mesh (billboards) with its own shader
+    void SubmitGeometry(GeometryRegistry* registry, Shader* shader, const glm::mat4& view, const glm::mat4& projection);
+    void SubmitMesh(GeometryRegistry* registry, uint32_t mesh, Shader* shader,
+                    const glm::mat4& view, const glm::mat4& projection);
+
+    // World-space line segments (two vertices each), copied into one streamed buffer
+    void SubmitLines(const LineVertex* vertices, size_t count, Shader* shader,
+                     const glm::mat4& view, const glm::mat4& projection);
+
+    // Overlay shapes
+    void SubmitRect(float x, float y, float width, float height, const glm::vec4& color);
+    void SubmitRectOutline(float x, float y, float width, float height, const glm::vec4& color, float thickness = 1.0f);
+
+    // One glyph: two triangles (6 vertices) sampling `texture`
+    void SubmitGlyph(uint32_t texture, const TextVertex* vertices);
+
+    // Recording side: stamp the time the snapshot's state was captured, then publish it
+    void BeginFrame();
+    void EndFrame();
+
+    // GL side: take the latest published frame (false once stopped), sort and submit
+    // it, and report its capture-to-present latency after the buffer swap
+    bool WaitForFrame();
+    void Flush();
+    void FramePresented();
+
+    // Release both sides' waits, for shutting a render thread down
+    void Stop();
+
+    // Applies from the next recorded frame. Off: commands run in submission order, unmerged, with the state cache forwarding
+    // every call, as a baseline for the submit time and state change counters
+    void SetBatchingEnabled(bool enabled);
+    bool IsBatchingEnabled() const { return batching_enabled_; }
+
+    GLStateCache& GetStateCache() { return state_; }
+
+    // GPU time of the most recent flush whose timer query has completed (a frame or
+    // two behind); 0 until the first result arrives. Safe to read while recording.
+    double GetGpuFrameMs() const { return gpu_frame_ms_; }
+
+private:
+    enum class CommandType : uint8_t { Geometry, Lines, Shapes, Glyphs };
+
+    struct RenderCommand {
+        uint64_t key;
+        CommandType type;
+        uint32_t first;         // First vertex in the pass's frame stream
+        uint32_t count;         // Vertex count
+        uint32_t texture;
+        Shader* shader;
+        GeometryRegistry* registry;
+        uint32_t mesh;          // Registry mesh, or kInvalidMesh for all line meshes
+    };
+
+    // Consecutive sorted commands that go out as one draw
+    struct DrawRun {
+        CommandType type;
+        RenderPass pass;
+        uint32_t first;         // First vertex in the upload buffer
+        uint32_t count;
+        uint32_t texture;
+        Shader* shader;
+        GeometryRegistry* registry;
+        uint32_t mesh;
+    };
+
+    // Everything one frame draws, recorded on one side and read on the other
+    struct RenderFrame {
+        std::vector<RenderCommand> commands;
+        // Vertices in submission order
+        std::vector<OverlayVertex> overlay_vertices;
+        std::vector<TextVertex> text_vertices;
+        std::vector<LineVertex> line_vertices;
+        // Instance lists taken from the frame's registry (one registry per frame)
+        GeometryRegistry* registry = nullptr;
+        GeometryRegistry::InstanceLists instances;
+        glm::mat4 world_view = glm::mat4(1.0f);
+        glm::mat4 world_projection = glm::mat4(1.0f);
+        int screen_width = 1280, screen_height = 720;
+        int framebuffer_width = 1280, framebuffer_height = 720;
+        float scene_scale = 1.0f;
+        bool batching = true;
+        std::chrono::steady_clock::time_point captured;
+        // 2D layer being recorded and the boxes (min xy, max xy) of the text in it
+        uint32_t layer = 0;
+        std::vector<glm::vec4> layer_text_bounds;
+
+        void Clear();
+    };
+
+    static constexpr int kFrameCount = 3;
+    RenderFrame frames_[kFrameCount];
+    int recording_;         // Written by Submit* calls
+    int ready_;             // Published, not yet taken (-1: none)
+    int submitting_;        // Taken by the GL side (-1: none yet)
+    bool stopping_;
+    std::mutex mutex_;
+    std::condition_variable frame_ready_;
+    std::condition_variable frame_taken_;
+
+    // GL side scratch
+    std::vector<DrawRun> runs_;
+    std::vector<Shader*> prepared_shaders_;     // Programs whose uniforms are set this flush
+    // Vertices re-packed in sorted order for upload
+    std::vector<OverlayVertex> overlay_upload_;
+    std::vector<TextVertex> text_upload_;
+    std::vector<LineVertex> line_upload_;
+
+    Shader* shape_shader_;
+    Shader* text_shader_;
+
+    GLuint overlay_vao_, overlay_vbo_;
+    GLuint text_vao_, text_vbo_;
+    GLuint line_vao_, line_vbo_;
+    size_t overlay_capacity_, text_capacity_, line_capacity_;   // Vertices each buffer holds
+
+    SceneFramebuffer* scene_target_;
+    GLuint output_framebuffer_;
+
+    // GL_TIME_ELAPSED queries around each flush, in a ring so results are read late
+    static constexpr size_t kGpuQueryCount = 3;
+    GLuint gpu_queries_[kGpuQueryCount];
+    bool gpu_query_pending_[kGpuQueryCount];
+    size_t gpu_query_index_;
+    std::atomic<double> gpu_frame_ms_;
+
+    GLStateCache state_;
+    bool batching_enabled_;
+    bool initialized_;
+
+    uint32_t NextDepth() const { return static_cast<uint32_t>(frames_[recording_].commands.size()); }
+    // Layer for a shape covering the box, and tracking of the text placed in a layer
+    uint32_t ShapeLayer(RenderFrame& frame, const glm::vec2& min_corner, const glm::vec2& max_corner);
+    void AddTextBounds(RenderFrame& frame, const TextVertex* vertices);
+    void BuildRuns(const RenderFrame& frame);
+    void PrepareShader(const RenderFrame& frame, Shader* shader, RenderPass pass);
+    void ApplyPassState(RenderPass pass);
+    void CollectGpuTime();
+};
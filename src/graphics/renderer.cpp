@@ -4,6 +4,7 @@
 #include "renderer.h"
 #include "core/window.h"
 #include <iostream>
+#include "utils/gl_trace.h"
 
 Renderer::Renderer() : window_(nullptr) {
     clear_color_[0] = 0.0f; // Black background
@@ -89,11 +90,25 @@ int Renderer::GetViewportHeight() const {
     return height;
 }
 
+int Renderer::GetFramebufferWidth() const {
+    if (!window_ || !window_->GetGLFWWindow()) return 1280;
+    int width, height;
+    glfwGetFramebufferSize(window_->GetGLFWWindow(), &width, &height);
+    return width;
+}
+
+int Renderer::GetFramebufferHeight() const {
+    if (!window_ || !window_->GetGLFWWindow()) return 720;
+    int width, height;
+    glfwGetFramebufferSize(window_->GetGLFWWindow(), &width, &height);
+    return height;
+}
+
 void Renderer::SetWindowSize(int width, int height) {
     if (!window_) return;
     GLFWwindow* w = window_->GetGLFWWindow();
     if (!w) return;
     glfwSetWindowSize(w, width, height);
-    glViewport(0, 0, width, height);
+    // The viewport follows on the next flush, from the framebuffer size
     if (camera_) camera_->SetAspect(static_cast<float>(width) / static_cast<float>(height));
 }
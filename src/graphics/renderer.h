@@ -24,6 +24,9 @@ public:
     void SetCamera(std::shared_ptr<Camera> camera);
     int GetViewportWidth() const;
     int GetViewportHeight() const;
+    // Size in pixels, which differs from the window size on high-DPI displays
+    int GetFramebufferWidth() const;
+    int GetFramebufferHeight() const;
     void SetWindowSize(int width, int height);
     
 private:
@@ -0,0 +1,85 @@
+// Implementation of the offscreen scene target
+#include "scene_framebuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "utils/gl_trace.h"
+
+SceneFramebuffer::SceneFramebuffer()
+    : fbo_(0), color_buffer_(0), depth_buffer_(0),
+      width_(0), height_(0), render_width_(0), render_height_(0),
+      allocated_width_(0), allocated_height_(0),
+      complete_(false), initialized_(false) {
+}
+
+SceneFramebuffer::~SceneFramebuffer() {
+    Shutdown();
+}
+
+bool SceneFramebuffer::Initialize() {
+    if (initialized_) return true;
+    glGenFramebuffers(1, &fbo_);
+    glGenRenderbuffers(1, &color_buffer_);
+    glGenRenderbuffers(1, &depth_buffer_);
+    initialized_ = true;
+    return true;
+}
+
+void SceneFramebuffer::Shutdown() {
+    if (!initialized_) return;
+    glDeleteFramebuffers(1, &fbo_);
+    glDeleteRenderbuffers(1, &color_buffer_);
+    glDeleteRenderbuffers(1, &depth_buffer_);
+    fbo_ = color_buffer_ = depth_buffer_ = 0;
+    allocated_width_ = allocated_height_ = 0;
+    complete_ = false;
+    initialized_ = false;
+}
+
+void SceneFramebuffer::SetSize(int width, int height, float scale) {
+    width_ = std::max(width, 1);
+    height_ = std::max(height, 1);
+    render_width_ = std::clamp(static_cast<int>(std::lround(width_ * scale)), 1, width_);
+    render_height_ = std::clamp(static_cast<int>(std::lround(height_ * scale)), 1, height_);
+    if (initialized_ && (width_ != allocated_width_ || height_ != allocated_height_)) {
+        Allocate();
+    }
+}
+
+void SceneFramebuffer::Allocate() {
+    glBindRenderbuffer(GL_RENDERBUFFER, color_buffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width_, height_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width_, height_);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_buffer_);
+    complete_ = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    allocated_width_ = width_;
+    allocated_height_ = height_;
+    if (!complete_) {
+        // The scene then renders straight into the window at full resolution
+        std::cerr << "SceneFramebuffer: incomplete at " << width_ << "x" << height_ << std::endl;
+    }
+}
+
+void SceneFramebuffer::Begin() {
+    if (!complete_) return;
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo_);
+    glViewport(0, 0, render_width_, render_height_);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void SceneFramebuffer::Resolve(GLuint destination) {
+    if (!complete_) return;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, destination);
+    glBlitFramebuffer(0, 0, render_width_, render_height_, 0, 0, width_, height_, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, destination);
+    glViewport(0, 0, width_, height_);
+}
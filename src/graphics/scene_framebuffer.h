@@ -0,0 +1,39 @@
+// Offscreen target for the 3D scene, rendered at a fraction of the window size
+#pragma once
+
+#include <glad/glad.h>
+
+// Color and depth renderbuffers sized to the window's framebuffer. A frame renders
+// into the lower-left (scale * size) rectangle, so changing the scale never
+// reallocates; Resolve stretches that rectangle over the whole window with a linear
+// blit. Storage is reallocated only when the window size changes.
+class SceneFramebuffer {
+public:
+    SceneFramebuffer();
+    ~SceneFramebuffer();
+
+    bool Initialize();
+    void Shutdown();
+
+    // Window framebuffer size and scene scale for the coming frame
+    void SetSize(int width, int height, float scale);
+
+    // Bind the target, set the viewport to the scaled rectangle and clear it
+    void Begin();
+    // Upscale into `destination` (the window by default), leave it bound and restore
+    // the full viewport
+    void Resolve(GLuint destination = 0);
+
+    int GetRenderWidth() const { return render_width_; }
+    int GetRenderHeight() const { return render_height_; }
+
+private:
+    GLuint fbo_, color_buffer_, depth_buffer_;
+    int width_, height_;                    // Window framebuffer size
+    int render_width_, render_height_;      // Scaled scene size
+    int allocated_width_, allocated_height_;
+    bool complete_;
+    bool initialized_;
+
+    void Allocate();
+};
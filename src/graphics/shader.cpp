@@ -5,6 +5,7 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include "utils/gl_trace.h"
 
 Shader::Shader() : program_id_(0) {
 }
@@ -14,6 +14,7 @@ public:
     
     void Use();
     void Delete();
+    unsigned int GetProgramId() const { return program_id_; }
     
     void SetUniform(const std::string& name, bool value);
     void SetUniform(const std::string& name, int value);
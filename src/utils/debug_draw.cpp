@@ -0,0 +1,89 @@
+// Implementation of the debug-draw buffers
+#include "debug_draw.h"
+#include <glm/gtc/constants.hpp>
+
+namespace DebugDraw {
+    namespace {
+        constexpr size_t kCategoryCount = static_cast<size_t>(DebugCategory::Count);
+
+        const char* const kCategoryNames[kCategoryCount] = {
+            "turrets", "targets", "projectiles", "spatial grid", "placement"
+        };
+
+        bool enabled_categories[kCategoryCount] = {};
+        std::vector<LineVertex> line_vertices;
+        std::vector<DebugLabel> labels;
+
+        void PushLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color) {
+            line_vertices.push_back({from, color});
+            line_vertices.push_back({to, color});
+        }
+    }
+
+    void Line(DebugCategory category, const glm::vec3& from, const glm::vec3& to, const glm::vec3& color) {
+        if (!IsEnabled(category)) return;
+        PushLine(from, to, color);
+    }
+
+    void Circle(DebugCategory category, const glm::vec3& center, float radius, const glm::vec3& color, int segments) {
+        if (!IsEnabled(category) || segments < 3) return;
+        float step = glm::two_pi<float>() / static_cast<float>(segments);
+        glm::vec3 previous = center + glm::vec3(radius, 0.0f, 0.0f);
+        for (int i = 1; i <= segments; ++i) {
+            float angle = step * static_cast<float>(i);
+            glm::vec3 next = center + glm::vec3(radius * glm::cos(angle), radius * glm::sin(angle), 0.0f);
+            PushLine(previous, next, color);
+            previous = next;
+        }
+    }
+
+    void Box(DebugCategory category, const glm::vec3& min_corner, const glm::vec3& max_corner, const glm::vec3& color) {
+        if (!IsEnabled(category)) return;
+        const glm::vec3& a = min_corner;
+        const glm::vec3& b = max_corner;
+        // Bottom and top rectangles (Z is up), then the four verticals
+        for (float z : {a.z, b.z}) {
+            PushLine({a.x, a.y, z}, {b.x, a.y, z}, color);
+            PushLine({b.x, a.y, z}, {b.x, b.y, z}, color);
+            PushLine({b.x, b.y, z}, {a.x, b.y, z}, color);
+            PushLine({a.x, b.y, z}, {a.x, a.y, z}, color);
+        }
+        PushLine({a.x, a.y, a.z}, {a.x, a.y, b.z}, color);
+        PushLine({b.x, a.y, a.z}, {b.x, a.y, b.z}, color);
+        PushLine({b.x, b.y, a.z}, {b.x, b.y, b.z}, color);
+        PushLine({a.x, b.y, a.z}, {a.x, b.y, b.z}, color);
+    }
+
+    void Label(DebugCategory category, const glm::vec3& position, const std::string& text, const glm::vec3& color) {
+        if (!IsEnabled(category)) return;
+        labels.push_back({position, text, color});
+    }
+
+    void Clear() {
+        line_vertices.clear();
+        labels.clear();
+    }
+
+    void SetEnabled(DebugCategory category, bool enabled) {
+        size_t index = static_cast<size_t>(category);
+        if (index < kCategoryCount) enabled_categories[index] = enabled;
+    }
+
+    bool IsEnabled(DebugCategory category) {
+        size_t index = static_cast<size_t>(category);
+        return index < kCategoryCount && enabled_categories[index];
+    }
+
+    const char* GetCategoryName(DebugCategory category) {
+        size_t index = static_cast<size_t>(category);
+        return index < kCategoryCount ? kCategoryNames[index] : "unknown";
+    }
+
+    const std::vector<LineVertex>& GetLineVertices() {
+        return line_vertices;
+    }
+
+    const std::vector<DebugLabel>& GetLabels() {
+        return labels;
+    }
+}
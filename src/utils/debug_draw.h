@@ -0,0 +1,67 @@
+// Immediate-mode debug shapes and labels, batched into one line buffer per frame
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Every shape belongs to a category that can be toggled at runtime
+enum class DebugCategory : uint8_t {
+    Turrets,        // Turret ranges
+    Targets,        // Turret to current target
+    Projectiles,    // Projectile paths
+    SpatialGrid,    // Occupied enemy grid cells
+    Placement,      // Turret placement ring
+    Count
+};
+
+struct LineVertex {
+    glm::vec3 position;
+    glm::vec3 color;
+};
+
+struct DebugLabel {
+    glm::vec3 position;     // World space; projected to the screen when drawn
+    std::string text;
+    glm::vec3 color;
+};
+
+// Systems add shapes while they update; the game clears the buffers at the start of
+// each simulation step and the renderer submits all lines in one draw, so the last
+// step's shapes stay visible while paused. Calls for a disabled category return
+// immediately. Single calls go through the DEBUG_DRAW_* macros below, which compile to
+// nothing (arguments included) without CORE_DEBUG_DRAW; loops that only exist to draw
+// belong in an #ifdef CORE_DEBUG_DRAW block.
+namespace DebugDraw {
+    void Line(DebugCategory category, const glm::vec3& from, const glm::vec3& to, const glm::vec3& color);
+    // Circle in the ground (XY) plane at the center's height; Z is up
+    void Circle(DebugCategory category, const glm::vec3& center, float radius, const glm::vec3& color, int segments = 32);
+    // Axis-aligned box outline
+    void Box(DebugCategory category, const glm::vec3& min_corner, const glm::vec3& max_corner, const glm::vec3& color);
+    void Label(DebugCategory category, const glm::vec3& position, const std::string& text, const glm::vec3& color);
+
+    // Drop everything queued so far
+    void Clear();
+
+    void SetEnabled(DebugCategory category, bool enabled);
+    bool IsEnabled(DebugCategory category);
+    const char* GetCategoryName(DebugCategory category);
+
+    // Two vertices per line segment
+    const std::vector<LineVertex>& GetLineVertices();
+    const std::vector<DebugLabel>& GetLabels();
+}
+
+#ifdef CORE_DEBUG_DRAW
+#define DEBUG_DRAW_LINE(category, from, to, color) DebugDraw::Line(category, from, to, color)
+#define DEBUG_DRAW_CIRCLE(category, center, radius, color) DebugDraw::Circle(category, center, radius, color)
+#define DEBUG_DRAW_BOX(category, min_corner, max_corner, color) DebugDraw::Box(category, min_corner, max_corner, color)
+#define DEBUG_DRAW_LABEL(category, position, text, color) DebugDraw::Label(category, position, text, color)
+#else
+#define DEBUG_DRAW_LINE(category, from, to, color) ((void)0)
+#define DEBUG_DRAW_CIRCLE(category, center, radius, color) ((void)0)
+#define DEBUG_DRAW_BOX(category, min_corner, max_corner, color) ((void)0)
+#define DEBUG_DRAW_LABEL(category, position, text, color) ((void)0)
+#endif
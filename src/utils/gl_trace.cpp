@@ -0,0 +1,227 @@
+// Implementation of GL call tracing
+#define CORE_GL_TRACE_IMPLEMENTATION
+#include "gl_trace.h"
+#include "metrics.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace GLTrace {
+    namespace {
+        enum Counter {
+            DrawCalls,
+            Vertices,
+            BuffersCreated,
+            BuffersDeleted,
+            VertexArraysCreated,
+            VertexArraysDeleted,
+            BytesUploaded,
+            ProgramBinds,
+            TextureBinds,
+            VertexArrayBinds,
+            UniformUpdates,
+            UniformLookups,
+            CounterCount
+        };
+
+        const char* const kCounterNames[CounterCount] = {
+            "draw_calls", "vertices", "buffers_created", "buffers_deleted",
+            "vertex_arrays_created", "vertex_arrays_deleted", "bytes_uploaded",
+            "program_binds", "texture_binds", "vertex_array_binds",
+            "uniform_updates", "uniform_lookups"
+        };
+
+        struct Subsystem {
+            std::string name;
+            double counts[CounterCount] = {};
+            bool touched = false;
+        };
+
+        // Call sites and scope names are string literals, so most lookups match a
+        // pointer seen before; names are compared only for a new pointer
+        struct Alias {
+            const char* key;
+            size_t subsystem;
+        };
+
+        std::vector<Subsystem> subsystems;
+        std::vector<Alias> aliases;
+        const char* current_scope = nullptr;
+
+        // "src/graphics/render_queue.cpp" -> "render_queue"
+        std::string SiteName(const char* site) {
+            const char* start = site;
+            for (const char* p = site; *p; ++p) {
+                if (*p == '/' || *p == '\\') start = p + 1;
+            }
+            const char* end = std::strrchr(start, '.');
+            return end ? std::string(start, end) : std::string(start);
+        }
+
+        Subsystem& Resolve(const char* site) {
+            const char* key = current_scope ? current_scope : site;
+            for (const Alias& alias : aliases) {
+                if (alias.key == key) return subsystems[alias.subsystem];
+            }
+            std::string name = current_scope ? std::string(current_scope) : SiteName(site);
+            size_t index = 0;
+            while (index < subsystems.size() && subsystems[index].name != name) {
+                index++;
+            }
+            if (index == subsystems.size()) {
+                subsystems.push_back(Subsystem());
+                subsystems.back().name = name;
+            }
+            aliases.push_back({key, index});
+            return subsystems[index];
+        }
+
+        void Count(const char* site, Counter counter, double amount = 1.0) {
+            Subsystem& subsystem = Resolve(site);
+            subsystem.counts[counter] += amount;
+            subsystem.touched = true;
+        }
+
+        void CountDraw(const char* site, double vertices) {
+            Subsystem& subsystem = Resolve(site);
+            subsystem.counts[DrawCalls] += 1.0;
+            subsystem.counts[Vertices] += vertices;
+            subsystem.touched = true;
+        }
+    }
+
+    Scope::Scope(const char* subsystem) : previous_(current_scope) {
+        current_scope = subsystem;
+    }
+
+    Scope::~Scope() {
+        current_scope = previous_;
+    }
+
+    void PublishFrame() {
+        for (Subsystem& subsystem : subsystems) {
+            if (!subsystem.touched) continue;
+            std::string prefix = "gl." + subsystem.name + ".";
+            for (int counter = 0; counter < CounterCount; ++counter) {
+                if (subsystem.counts[counter] == 0.0) continue;
+                Metrics::Add(prefix + kCounterNames[counter], subsystem.counts[counter]);
+                Metrics::Add(std::string("gl.") + kCounterNames[counter], subsystem.counts[counter]);
+                subsystem.counts[counter] = 0.0;
+            }
+            subsystem.touched = false;
+        }
+    }
+
+    void DrawArrays(const char* site, GLenum mode, GLint first, GLsizei count) {
+        CountDraw(site, count);
+        glDrawArrays(mode, first, count);
+    }
+
+    void DrawElements(const char* site, GLenum mode, GLsizei count, GLenum type, const void* indices) {
+        CountDraw(site, count);
+        glDrawElements(mode, count, type, indices);
+    }
+
+    void DrawElementsInstancedBaseVertex(const char* site, GLenum mode, GLsizei count, GLenum type,
+                                         const void* indices, GLsizei instances, GLint base_vertex) {
+        CountDraw(site, static_cast<double>(count) * instances);
+        glDrawElementsInstancedBaseVertex(mode, count, type, indices, instances, base_vertex);
+    }
+
+    void DrawElementsInstancedBaseVertexBaseInstance(const char* site, GLenum mode, GLsizei count, GLenum type,
+                                                     const void* indices, GLsizei instances, GLint base_vertex,
+                                                     GLuint base_instance) {
+        CountDraw(site, static_cast<double>(count) * instances);
+        glDrawElementsInstancedBaseVertexBaseInstance(mode, count, type, indices, instances, base_vertex, base_instance);
+    }
+
+    void MultiDrawElementsIndirect(const char* site, GLenum mode, GLenum type, const void* indirect,
+                                   GLsizei draw_count, GLsizei stride, const void* commands) {
+        Count(site, DrawCalls, draw_count);
+        if (commands) {
+            // Each command starts with its index count and instance count; stride 0 is tightly packed
+            size_t step = stride ? static_cast<size_t>(stride) : 5 * sizeof(GLuint);
+            const unsigned char* command = static_cast<const unsigned char*>(commands);
+            double vertices = 0.0;
+            for (GLsizei i = 0; i < draw_count; ++i, command += step) {
+                GLuint counts[2];
+                std::memcpy(counts, command, sizeof(counts));
+                vertices += static_cast<double>(counts[0]) * counts[1];
+            }
+            Count(site, Vertices, vertices);
+        }
+        glMultiDrawElementsIndirect(mode, type, indirect, draw_count, stride);
+    }
+
+    void GenBuffers(const char* site, GLsizei n, GLuint* buffers) {
+        Count(site, BuffersCreated, n);
+        glGenBuffers(n, buffers);
+    }
+
+    void DeleteBuffers(const char* site, GLsizei n, const GLuint* buffers) {
+        Count(site, BuffersDeleted, n);
+        glDeleteBuffers(n, buffers);
+    }
+
+    void GenVertexArrays(const char* site, GLsizei n, GLuint* arrays) {
+        Count(site, VertexArraysCreated, n);
+        glGenVertexArrays(n, arrays);
+    }
+
+    void DeleteVertexArrays(const char* site, GLsizei n, const GLuint* arrays) {
+        Count(site, VertexArraysDeleted, n);
+        glDeleteVertexArrays(n, arrays);
+    }
+
+    void BufferData(const char* site, GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+        if (data) {
+            Count(site, BytesUploaded, static_cast<double>(size));
+        }
+        glBufferData(target, size, data, usage);
+    }
+
+    void BufferSubData(const char* site, GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+        Count(site, BytesUploaded, static_cast<double>(size));
+        glBufferSubData(target, offset, size, data);
+    }
+
+    void UseProgram(const char* site, GLuint program) {
+        Count(site, ProgramBinds);
+        glUseProgram(program);
+    }
+
+    void BindTexture(const char* site, GLenum target, GLuint texture) {
+        Count(site, TextureBinds);
+        glBindTexture(target, texture);
+    }
+
+    void BindVertexArray(const char* site, GLuint array) {
+        Count(site, VertexArrayBinds);
+        glBindVertexArray(array);
+    }
+
+    GLint GetUniformLocation(const char* site, GLuint program, const GLchar* name) {
+        Count(site, UniformLookups);
+        return glGetUniformLocation(program, name);
+    }
+
+    void Uniform1i(const char* site, GLint location, GLint v0) {
+        Count(site, UniformUpdates);
+        glUniform1i(location, v0);
+    }
+
+    void Uniform1f(const char* site, GLint location, GLfloat v0) {
+        Count(site, UniformUpdates);
+        glUniform1f(location, v0);
+    }
+
+    void Uniform3f(const char* site, GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+        Count(site, UniformUpdates);
+        glUniform3f(location, v0, v1, v2);
+    }
+
+    void UniformMatrix4fv(const char* site, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+        Count(site, UniformUpdates);
+        glUniformMatrix4fv(location, count, transpose, value);
+    }
+}
@@ -0,0 +1,118 @@
+// Optional GL call interception with per-frame, per-subsystem counters
+#pragma once
+
+#include <glad/glad.h>
+
+// With CORE_GL_TRACE defined, a .cpp that includes this header after its other
+// includes has the GL entry points below rerouted through counting wrappers, which
+// forward to the real call. Each call is charged to the innermost GL_TRACE_SCOPE on
+// the GL thread, or else to the calling file ("render_queue", "font", ...).
+// GL_TRACE_PUBLISH, once per frame on the GL thread, adds the counts to the metrics
+// as gl.<counter> totals and gl.<subsystem>.<counter>, then resets them.
+//
+// Vertices are count * instances per draw. A multi-draw-indirect counts each command
+// as a draw call; its commands live in a GPU buffer, so its vertices are counted only
+// when the call goes through GL_TRACE_MULTI_DRAW_ELEMENTS_INDIRECT with the CPU copy
+// the buffer was filled from. Upload
+// bytes are those of glBufferData with data and glBufferSubData (orphaning calls
+// allocate without uploading). Without CORE_GL_TRACE nothing is rerouted and both
+// macros compile to nothing.
+namespace GLTrace {
+    // RAII subsystem override for the calls made inside a block
+    class Scope {
+    public:
+        explicit Scope(const char* subsystem);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        const char* previous_;
+    };
+
+    void PublishFrame();
+
+    // Wrappers; `site` is the calling file
+    void DrawArrays(const char* site, GLenum mode, GLint first, GLsizei count);
+    void DrawElements(const char* site, GLenum mode, GLsizei count, GLenum type, const void* indices);
+    void DrawElementsInstancedBaseVertex(const char* site, GLenum mode, GLsizei count, GLenum type,
+                                         const void* indices, GLsizei instances, GLint base_vertex);
+    void DrawElementsInstancedBaseVertexBaseInstance(const char* site, GLenum mode, GLsizei count, GLenum type,
+                                                     const void* indices, GLsizei instances, GLint base_vertex,
+                                                     GLuint base_instance);
+    // `commands` is the CPU copy of the indirect commands, or null when there is none
+    void MultiDrawElementsIndirect(const char* site, GLenum mode, GLenum type, const void* indirect,
+                                   GLsizei draw_count, GLsizei stride, const void* commands);
+
+    void GenBuffers(const char* site, GLsizei n, GLuint* buffers);
+    void DeleteBuffers(const char* site, GLsizei n, const GLuint* buffers);
+    void GenVertexArrays(const char* site, GLsizei n, GLuint* arrays);
+    void DeleteVertexArrays(const char* site, GLsizei n, const GLuint* arrays);
+    void BufferData(const char* site, GLenum target, GLsizeiptr size, const void* data, GLenum usage);
+    void BufferSubData(const char* site, GLenum target, GLintptr offset, GLsizeiptr size, const void* data);
+
+    void UseProgram(const char* site, GLuint program);
+    void BindTexture(const char* site, GLenum target, GLuint texture);
+    void BindVertexArray(const char* site, GLuint array);
+
+    GLint GetUniformLocation(const char* site, GLuint program, const GLchar* name);
+    void Uniform1i(const char* site, GLint location, GLint v0);
+    void Uniform1f(const char* site, GLint location, GLfloat v0);
+    void Uniform3f(const char* site, GLint location, GLfloat v0, GLfloat v1, GLfloat v2);
+    void UniformMatrix4fv(const char* site, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+}
+
+#ifdef CORE_GL_TRACE
+#define GL_TRACE_SCOPE_CONCAT(a, b) a##b
+#define GL_TRACE_SCOPE_NAME(line) GL_TRACE_SCOPE_CONCAT(gl_trace_scope_, line)
+#define GL_TRACE_SCOPE(subsystem) GLTrace::Scope GL_TRACE_SCOPE_NAME(__LINE__)(subsystem)
+#define GL_TRACE_PUBLISH() GLTrace::PublishFrame()
+#define GL_TRACE_MULTI_DRAW_ELEMENTS_INDIRECT(commands, mode, type, indirect, draw_count, stride) \
+    GLTrace::MultiDrawElementsIndirect(__FILE__, mode, type, indirect, draw_count, stride, commands)
+
+// gl_trace.cpp calls the real entry points
+#ifndef CORE_GL_TRACE_IMPLEMENTATION
+#undef glDrawArrays
+#undef glDrawElements
+#undef glDrawElementsInstancedBaseVertex
+#undef glDrawElementsInstancedBaseVertexBaseInstance
+#undef glMultiDrawElementsIndirect
+#undef glGenBuffers
+#undef glDeleteBuffers
+#undef glGenVertexArrays
+#undef glDeleteVertexArrays
+#undef glBufferData
+#undef glBufferSubData
+#undef glUseProgram
+#undef glBindTexture
+#undef glBindVertexArray
+#undef glGetUniformLocation
+#undef glUniform1i
+#undef glUniform1f
+#undef glUniform3f
+#undef glUniformMatrix4fv
+#define glDrawArrays(...) GLTrace::DrawArrays(__FILE__, __VA_ARGS__)
+#define glDrawElements(...) GLTrace::DrawElements(__FILE__, __VA_ARGS__)
+#define glDrawElementsInstancedBaseVertex(...) GLTrace::DrawElementsInstancedBaseVertex(__FILE__, __VA_ARGS__)
+#define glDrawElementsInstancedBaseVertexBaseInstance(...) GLTrace::DrawElementsInstancedBaseVertexBaseInstance(__FILE__, __VA_ARGS__)
+#define glMultiDrawElementsIndirect(...) GLTrace::MultiDrawElementsIndirect(__FILE__, __VA_ARGS__, nullptr)
+#define glGenBuffers(...) GLTrace::GenBuffers(__FILE__, __VA_ARGS__)
+#define glDeleteBuffers(...) GLTrace::DeleteBuffers(__FILE__, __VA_ARGS__)
+#define glGenVertexArrays(...) GLTrace::GenVertexArrays(__FILE__, __VA_ARGS__)
+#define glDeleteVertexArrays(...) GLTrace::DeleteVertexArrays(__FILE__, __VA_ARGS__)
+#define glBufferData(...) GLTrace::BufferData(__FILE__, __VA_ARGS__)
+#define glBufferSubData(...) GLTrace::BufferSubData(__FILE__, __VA_ARGS__)
+#define glUseProgram(...) GLTrace::UseProgram(__FILE__, __VA_ARGS__)
+#define glBindTexture(...) GLTrace::BindTexture(__FILE__, __VA_ARGS__)
+#define glBindVertexArray(...) GLTrace::BindVertexArray(__FILE__, __VA_ARGS__)
+#define glGetUniformLocation(...) GLTrace::GetUniformLocation(__FILE__, __VA_ARGS__)
+#define glUniform1i(...) GLTrace::Uniform1i(__FILE__, __VA_ARGS__)
+#define glUniform1f(...) GLTrace::Uniform1f(__FILE__, __VA_ARGS__)
+#define glUniform3f(...) GLTrace::Uniform3f(__FILE__, __VA_ARGS__)
+#define glUniformMatrix4fv(...) GLTrace::UniformMatrix4fv(__FILE__, __VA_ARGS__)
+#endif
+#else
+#define GL_TRACE_SCOPE(subsystem) ((void)0)
+#define GL_TRACE_PUBLISH() ((void)0)
+#define GL_TRACE_MULTI_DRAW_ELEMENTS_INDIRECT(commands, mode, type, indirect, draw_count, stride) \
+    glMultiDrawElementsIndirect(mode, type, indirect, draw_count, stride)
+#endif
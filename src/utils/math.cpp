@@ -3,6 +3,7 @@
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <random>
+#include <utility>
 
 namespace Math {
     glm::vec3 ScreenToWorld(const glm::vec2& screen_pos, 
@@ -43,4 +44,70 @@ namespace Math {
         
         return glm::normalize(point) * radius;
     }
+    
+    bool SolveInterceptTime(const glm::vec3& relative_position,
+                            const glm::vec3& target_velocity,
+                            float projectile_speed,
+                            float& out_time) {
+        // |p + v t| = s t  =>  (v.v - s^2) t^2 + 2 (p.v) t + p.p = 0
+        float a = glm::dot(target_velocity, target_velocity) - projectile_speed * projectile_speed;
+        float b = 2.0f * glm::dot(relative_position, target_velocity);
+        float c = glm::dot(relative_position, relative_position);
+        
+        if (c <= 0.0f) {
+            out_time = 0.0f;
+            return true;
+        }
+        
+        if (glm::abs(a) < 1e-6f) {
+            // Target as fast as the projectile: linear equation
+            if (b >= 0.0f) return false;
+            out_time = -c / b;
+            return true;
+        }
+        
+        float discriminant = b * b - 4.0f * a * c;
+        if (discriminant < 0.0f) return false;
+        
+        float root = glm::sqrt(discriminant);
+        float t1 = (-b - root) / (2.0f * a);
+        float t2 = (-b + root) / (2.0f * a);
+        if (t1 > t2) std::swap(t1, t2);
+        
+        if (t1 >= 0.0f) {
+            out_time = t1;
+            return true;
+        }
+        if (t2 >= 0.0f) {
+            out_time = t2;
+            return true;
+        }
+        return false;
+    }
+    
+    bool SweptSphereContactTime(const glm::vec3& relative_position,
+                                const glm::vec3& relative_velocity,
+                                float radius,
+                                float max_time,
+                                float& out_time) {
+        float c = glm::dot(relative_position, relative_position) - radius * radius;
+        if (c <= 0.0f) {
+            // Already overlapping at the start of the interval
+            out_time = 0.0f;
+            return true;
+        }
+        
+        float a = glm::dot(relative_velocity, relative_velocity);
+        float b = glm::dot(relative_position, relative_velocity);
+        if (a < 1e-12f || b >= 0.0f) return false; // Not approaching
+        
+        float discriminant = b * b - a * c;
+        if (discriminant < 0.0f) return false;
+        
+        float t = (-b - glm::sqrt(discriminant)) / a;
+        if (t > max_time) return false;
+        
+        out_time = t;
+        return true;
+    }
 }
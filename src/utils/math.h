@@ -23,4 +23,19 @@ namespace Math {
     
     // Generate random position on sphere surface
     glm::vec3 RandomPositionOnSphere(float radius);
+    
+    // Earliest time t >= 0 at which a shot fired now with `projectile_speed` meets a target
+    // at `relative_position` (target - shooter) moving with constant `target_velocity`
+    bool SolveInterceptTime(const glm::vec3& relative_position,
+                            const glm::vec3& target_velocity,
+                            float projectile_speed,
+                            float& out_time);
+    
+    // Earliest time t in [0, max_time] at which two spheres whose centers are separated by
+    // `relative_position` + `relative_velocity` * t come within `radius` of each other
+    bool SweptSphereContactTime(const glm::vec3& relative_position,
+                                const glm::vec3& relative_velocity,
+                                float radius,
+                                float max_time,
+                                float& out_time);
 }
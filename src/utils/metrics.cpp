@@ -0,0 +1,87 @@
+// Implementation of performance counters
+#include "metrics.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+namespace Metrics {
+    namespace {
+        std::mutex current_mutex;           // Guards current_frame
+        std::map<std::string, double> current_frame;
+        std::map<std::string, double> last_frame;
+        unsigned long long frame_index = 0;
+
+        std::ofstream csv_file;
+        bool csv_env_checked = false;
+
+        void CheckCsvEnvironment() {
+            if (csv_env_checked) return;
+            csv_env_checked = true;
+
+            const char* path = std::getenv("CORE_METRICS_CSV");
+            if (path && *path && !csv_file.is_open()) {
+                EnableCsv(path);
+            }
+        }
+    }
+
+    void Add(const std::string& name, double value) {
+        std::lock_guard<std::mutex> lock(current_mutex);
+        current_frame[name] += value;
+    }
+
+    void Set(const std::string& name, double value) {
+        std::lock_guard<std::mutex> lock(current_mutex);
+        current_frame[name] = value;
+    }
+
+    void EndFrame() {
+        CheckCsvEnvironment();
+        std::lock_guard<std::mutex> lock(current_mutex);
+
+        if (csv_file.is_open()) {
+            for (const auto& entry : current_frame) {
+                csv_file << frame_index << "," << entry.first << "," << entry.second << "\n";
+            }
+        }
+
+        // Keep the keys so counters that stay at zero still show up
+        last_frame = current_frame;
+        for (auto& entry : current_frame) {
+            entry.second = 0.0;
+        }
+        frame_index++;
+    }
+
+    double Get(const std::string& name) {
+        auto it = last_frame.find(name);
+        return it != last_frame.end() ? it->second : 0.0;
+    }
+
+    const std::map<std::string, double>& GetLastFrame() {
+        return last_frame;
+    }
+
+    unsigned long long GetFrameIndex() {
+        return frame_index;
+    }
+
+    bool EnableCsv(const std::string& path) {
+        csv_env_checked = true;
+        csv_file.close();
+        csv_file.open(path, std::ios::out | std::ios::trunc);
+        if (!csv_file.is_open()) {
+            std::cerr << "Failed to open metrics CSV: " << path << std::endl;
+            return false;
+        }
+
+        csv_file << "frame,name,value\n";
+        std::cout << "Writing metrics to " << path << std::endl;
+        return true;
+    }
+
+    void DisableCsv() {
+        csv_file.close();
+    }
+}
@@ -0,0 +1,28 @@
+// Named per-frame performance counters with optional CSV output
+#pragma once
+
+#include <map>
+#include <string>
+
+// Systems add to named counters during a frame; EndFrame() publishes the totals as the
+// "last frame" snapshot and resets them. Setting the CORE_METRICS_CSV environment
+// variable (or calling EnableCsv) appends every published frame to a CSV file as
+// frame,name,value rows.
+//
+// Add and Set may be called from any thread (the render thread reports its own
+// counters); EndFrame and the readers belong to the main loop's thread.
+namespace Metrics {
+    void Add(const std::string& name, double value = 1.0);
+    void Set(const std::string& name, double value);
+
+    // Publish the current frame and start a new one
+    void EndFrame();
+
+    // Value of a counter in the last published frame (0 if it was not touched)
+    double Get(const std::string& name);
+    const std::map<std::string, double>& GetLastFrame();
+    unsigned long long GetFrameIndex();
+
+    bool EnableCsv(const std::string& path);
+    void DisableCsv();
+}
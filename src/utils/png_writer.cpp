@@ -0,0 +1,109 @@
+// Implementation of PNG output
+#include "png_writer.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace PngWriter {
+    namespace {
+        const uint32_t* CrcTable() {
+            static uint32_t table[256];
+            static bool built = false;
+            if (!built) {
+                for (uint32_t n = 0; n < 256; ++n) {
+                    uint32_t c = n;
+                    for (int k = 0; k < 8; ++k) {
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    }
+                    table[n] = c;
+                }
+                built = true;
+            }
+            return table;
+        }
+
+        uint32_t Crc(const uint8_t* data, size_t size, uint32_t crc = 0xFFFFFFFFu) {
+            const uint32_t* table = CrcTable();
+            for (size_t i = 0; i < size; ++i) {
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return crc;
+        }
+
+        void PutU32(std::vector<uint8_t>& out, uint32_t value) {
+            out.push_back(static_cast<uint8_t>(value >> 24));
+            out.push_back(static_cast<uint8_t>(value >> 16));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        // Length, type, data, CRC of type and data
+        void PutChunk(std::vector<uint8_t>& out, const char* type, const std::vector<uint8_t>& data) {
+            PutU32(out, static_cast<uint32_t>(data.size()));
+            size_t type_start = out.size();
+            out.insert(out.end(), type, type + 4);
+            out.insert(out.end(), data.begin(), data.end());
+            uint32_t crc = Crc(out.data() + type_start, out.size() - type_start) ^ 0xFFFFFFFFu;
+            PutU32(out, crc);
+        }
+    }
+
+    bool Write(const std::string& path, int width, int height, const uint8_t* rgba, bool bottom_up) {
+        if (width <= 0 || height <= 0 || !rgba) return false;
+
+        // Scanlines, each prefixed with filter type 0 (none)
+        size_t row_size = static_cast<size_t>(width) * 4;
+        std::vector<uint8_t> raw;
+        raw.reserve((row_size + 1) * height);
+        for (int y = 0; y < height; ++y) {
+            int source_row = bottom_up ? height - 1 - y : y;
+            const uint8_t* row = rgba + row_size * source_row;
+            raw.push_back(0);
+            raw.insert(raw.end(), row, row + row_size);
+        }
+
+        // zlib stream of stored blocks (at most 65535 bytes each), then Adler-32
+        std::vector<uint8_t> zlib = {0x78, 0x01};
+        const size_t kMaxBlock = 65535;
+        for (size_t offset = 0; ; offset += kMaxBlock) {
+            size_t size = std::min(kMaxBlock, raw.size() - offset);
+            bool last = offset + size >= raw.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<uint8_t>(size));
+            zlib.push_back(static_cast<uint8_t>(size >> 8));
+            zlib.push_back(static_cast<uint8_t>(~size));
+            zlib.push_back(static_cast<uint8_t>(~size >> 8));
+            zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+            if (last) break;
+        }
+        uint32_t a = 1, b = 0;
+        for (uint8_t byte : raw) {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        PutU32(zlib, (b << 16) | a);
+
+        std::vector<uint8_t> header;
+        PutU32(header, static_cast<uint32_t>(width));
+        PutU32(header, static_cast<uint32_t>(height));
+        header.push_back(8);    // Bit depth
+        header.push_back(6);    // Color type: RGBA
+        header.push_back(0);    // Compression, filter and interlace methods
+        header.push_back(0);
+        header.push_back(0);
+
+        std::vector<uint8_t> file = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        PutChunk(file, "IHDR", header);
+        PutChunk(file, "IDAT", zlib);
+        PutChunk(file, "IEND", {});
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Failed to write PNG: " << path << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+        return out.good();
+    }
+}
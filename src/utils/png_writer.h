@@ -0,0 +1,14 @@
+// Minimal PNG output for captured frames (no compression library needed)
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Writes 8-bit RGBA images as PNG with stored (uncompressed) deflate blocks: files
+// are larger than a real encoder's, but byte-identical for identical pixels, which
+// is what visual diffing needs.
+namespace PngWriter {
+    // `rgba` holds width * height pixels, rows top to bottom unless `bottom_up`
+    // (glReadPixels order)
+    bool Write(const std::string& path, int width, int height, const uint8_t* rgba, bool bottom_up = false);
+}